@@ -1,5 +1,9 @@
 // confWeb.cpp - configuration page for WLAN access using AsyncWebServer
 //
+// 2026-10-18 mh
+// - chunk filler of the config page in confWebChunk.cpp
+// - config page is sent as chunked response, rendered one parameter per step instead of one String
+//
 // 2023-02-17 mh
 // - changed "/'>home page" to "/start'>start page"
 //
@@ -359,43 +363,20 @@ void IotWebConf::handleConfig(WebRequestWrapper* webRequestWrapper)
     webRequestWrapper->stop();
 
 #else
-     // use response class
-    String content = htmlFormatProvider->getHead();
-    content.replace("{v}", "Config ESP");
-    content += htmlFormatProvider->getScript();
-    content += htmlFormatProvider->getStyle();
-    content += htmlFormatProvider->getHeadExtension();
-    content += htmlFormatProvider->getHeadEnd();
-    content += htmlFormatProvider->getFormStart();
-
-    // -- Add parameters to the form
-    this->_systemParameters.renderHtml(dataArrived, webRequestWrapper, content);
-    this->_customParameterGroups.renderHtml(dataArrived, webRequestWrapper, content);
-
-    content += htmlFormatProvider->getFormEnd();
-
-    if (this->_updatePath != nullptr)
-    {
-      String pitem = htmlFormatProvider->getUpdate();
-      pitem.replace("{u}", this->_updatePath);
-      content += pitem;
-    }
-
-    // -- Fill config version string;
-    {
-      String pitem = htmlFormatProvider->getConfigVer();
-      pitem.replace("{v}", this->_configVersion);
-      content += pitem;
-    }
-
-    content += htmlFormatProvider->getEnd();
-
-    AsyncWebServerResponse *response = webRequestWrapper->beginResponse(200, "text/html; charset=UTF-8", content);
+    // use chunked response: the page is rendered one parameter per step into the chunk buffer,
+    // so only the largest piece (style, a select parameter) needs contiguous heap.
+    ConfigPageState state;
+    state.dataArrived = dataArrived;
+    AsyncWebServerResponse *response = webRequestWrapper->beginChunkedResponse("text/html; charset=UTF-8",
+      [this, webRequestWrapper, state](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      {
+        return this->fillConfigChunk(webRequestWrapper, state, buffer, maxLen);
+      });
     response->addHeader("Cache-Control", "no-cache, no-store, must-revalidate");
     response->addHeader("Pragma", "no-cache");
     response->addHeader("Expires", "-1");
 
-    webRequestWrapper->send(response);     
+    webRequestWrapper->send(response);
 
 #endif
   }
@@ -455,6 +436,123 @@ void IotWebConf::handleConfig(WebRequestWrapper* webRequestWrapper)
   }
 }
 
+#if IOT_OLD
+#else
+size_t IotWebConf::fillConfigChunk(WebRequestWrapper* webRequestWrapper, ConfigPageState& state,
+  uint8_t* buffer, size_t maxLen)
+{
+  // -- the chunk is filled by confWebChunk.cpp, the pieces are rendered here
+  return fillChunkFromPieces(buffer, maxLen, state.piece, state.sent,
+    [this, webRequestWrapper, &state](String& piece) -> bool
+    {
+      return this->renderConfigStep(webRequestWrapper, state);    // piece is state.piece
+    });
+}
+
+bool IotWebConf::renderConfigStep(WebRequestWrapper* webRequestWrapper, ConfigPageState& state)
+{
+  // -- render the next piece of the config page into state.piece (may stay empty), false at the end
+  switch (state.phase)
+  {
+  case cpHEAD:
+    state.piece = htmlFormatProvider->getHead();
+    state.piece.replace("{v}", "Config ESP");
+    break;
+  case cpSCRIPT:
+    state.piece = htmlFormatProvider->getScript();
+    break;
+  case cpSTYLE:
+    state.piece = htmlFormatProvider->getStyle();
+    break;
+  case cpHEAD_EXTENSION:
+    state.piece = htmlFormatProvider->getHeadExtension();
+    break;
+  case cpHEAD_END:
+    state.piece = htmlFormatProvider->getHeadEnd();
+    break;
+  case cpFORM_START:
+    state.piece = htmlFormatProvider->getFormStart();
+    break;
+  case cpSYSTEM:
+  case cpCUSTOM:
+  {
+    // -- Add parameters to the form: walk the group tree, one item per step
+    if (state.depth == 0)
+    {
+      ParameterGroup* root = (state.phase == cpSYSTEM) ? &this->_systemParameters : &this->_customParameterGroups;
+      state.group[0] = root;
+      state.next[0] = root->_firstItem;
+      state.depth = 1;
+      this->renderGroupTemplate(root, true, state.piece);
+      return true;
+    }
+    ParameterGroup* group = state.group[state.depth - 1];
+    ConfigItem* current = state.next[state.depth - 1];
+    if (current == nullptr)
+    {
+      this->renderGroupTemplate(group, false, state.piece);
+      state.depth--;
+      if (state.depth == 0)
+      {
+        state.phase++;
+      }
+      return true;
+    }
+    state.next[state.depth - 1] = group->getNextItemOf(current);
+    if (!current->visible)
+    {
+      return true;
+    }
+    if (current->isGroup() && (state.depth < IOTWEBCONF_RENDER_DEPTH))
+    {
+      ParameterGroup* inner = static_cast<ParameterGroup*>(current);
+      state.group[state.depth] = inner;
+      state.next[state.depth] = inner->_firstItem;
+      state.depth++;
+      this->renderGroupTemplate(inner, true, state.piece);
+    }
+    else
+    {
+      current->renderHtml(state.dataArrived, webRequestWrapper, state.piece);
+    }
+    return true;
+  }
+  case cpFORM_END:
+    state.piece = htmlFormatProvider->getFormEnd();
+    break;
+  case cpUPDATE:
+    if (this->_updatePath != nullptr)
+    {
+      state.piece = htmlFormatProvider->getUpdate();
+      state.piece.replace("{u}", this->_updatePath);
+    }
+    break;
+  case cpCONFIG_VER:
+    // -- Fill config version string;
+    state.piece = htmlFormatProvider->getConfigVer();
+    state.piece.replace("{v}", this->_configVersion);
+    break;
+  case cpEND:
+    state.piece = htmlFormatProvider->getEnd();
+    break;
+  default:
+    return false;
+  }
+  state.phase++;
+  return true;
+}
+
+void IotWebConf::renderGroupTemplate(ParameterGroup* group, bool start, String& piece)
+{
+  if (group->label != nullptr)
+  {
+    piece = start ? group->getStartTemplate() : group->getEndTemplate();
+    piece.replace("{b}", group->label);
+    piece.replace("{i}", group->getId());
+  }
+}
+#endif // IOT_OLD
+
 bool IotWebConf::validateForm(WebRequestWrapper* webRequestWrapper)
 {
   // -- Clean previous error messages.
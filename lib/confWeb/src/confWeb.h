@@ -1,5 +1,9 @@
 // confWeb.h - configuration page for WLAN access using AsyncWebServer
 //
+// 2026-10-18 mh
+// - fillConfigChunk() copies the pieces by fillChunkFromPieces() (confWebChunk.h)
+// - ConfigPageState, renderConfigStep(), fillConfigChunk(): config page as chunked response
+//
 // 2023-01-21 mh
 // - derived from IotWebConf.h
 // - use ESPAsyncWebServer instead of ESP8266WebServer
@@ -38,6 +42,7 @@
 #include "confWebServerWrapper.h"
 #include "confWebParameter.h"
 #include "confWebSettings.h"
+#include "confWebChunk.h"
 #include <DNSServer.h>
 #endif // IOT_OLD
 
@@ -688,6 +693,30 @@ private:
 
   bool validateForm(WebRequestWrapper* webRequestWrapper);
 
+#if IOT_OLD
+#else
+  // -- config page is sent as chunked response, one piece (parameter, group
+  // start/end, page fragment) per step, see handleConfig().
+  enum ConfigPagePhase : uint8_t
+  {
+    cpHEAD, cpSCRIPT, cpSTYLE, cpHEAD_EXTENSION, cpHEAD_END, cpFORM_START,
+    cpSYSTEM, cpCUSTOM, cpFORM_END, cpUPDATE, cpCONFIG_VER, cpEND, cpDONE
+  };
+  struct ConfigPageState
+  {
+    uint8_t phase = cpHEAD;
+    bool dataArrived = false;
+    uint8_t depth = 0;                                      // number of entered groups
+    ParameterGroup* group[IOTWEBCONF_RENDER_DEPTH] = {};
+    ConfigItem* next[IOTWEBCONF_RENDER_DEPTH] = {};         // next item of group, nullptr: end of group
+    String piece;                                           // current piece
+    size_t sent = 0;                                        // bytes of piece in former chunks
+  };
+  bool renderConfigStep(WebRequestWrapper* webRequestWrapper, ConfigPageState& state);
+  void renderGroupTemplate(ParameterGroup* group, bool start, String& piece);
+  size_t fillConfigChunk(WebRequestWrapper* webRequestWrapper, ConfigPageState& state, uint8_t* buffer, size_t maxLen);
+#endif // IOT_OLD
+
   void changeState(NetworkState newState);
   void stateChanged(NetworkState oldState, NetworkState newState);
   bool mustUseDefaultPassword()
@@ -0,0 +1,56 @@
+// confWebChunk.cpp - copy a page rendered piece by piece into the chunks of a response
+//
+// 2026-10-18 mh
+// - first version, taken out of IotWebConf::fillConfigChunk()
+//
+// Copyright (C) 2026 Manfred Herbert
+
+/* *** Description ***
+The config page is sent as chunked response and rendered one piece (head, style, one parameter, ...) per step, so
+only the largest piece needs contiguous heap. The chunk size is chosen by the web server and has nothing to do with
+the pieces: a chunk may hold several pieces or only a part of one.
+
+** Usage **
+ConfigPageState state;      holds piece and sent between the calls
+[..](uint8_t* buffer, size_t maxLen, size_t index)
+{
+  return fillChunkFromPieces(buffer, maxLen, state.piece, state.sent,
+    [..](String& piece) { return renderNextPiece(state, piece); });
+}
+
+** Implementation **
+The rest of the current piece is copied first; then the piece is cleared (the String keeps its buffer for the next
+one) and the renderer is called, until the chunk is full or the renderer returns false. Empty pieces are skipped.
+Nothing here depends on the web server, so it runs in the native unit tests; the walk through the parameter groups
+(IotWebConf::renderConfigStep()) renders through the parameters and the web request and stays in confWeb.cpp.
+  *** end description *** */
+
+#include "confWebChunk.h"
+
+size_t fillChunkFromPieces(uint8_t* buffer, size_t maxLen, String& piece, size_t& sent, PieceRenderer renderer)
+{
+  // -- copy pieces into the chunk until it is full; 0 ends the response
+  size_t len = 0;
+  while (len < maxLen)
+  {
+    if (sent >= piece.length())
+    {
+      piece = "";       // keeps the buffer for the next piece
+      sent = 0;
+      if (!renderer(piece))
+      {
+        break;
+      }
+      continue;
+    }
+    size_t n = piece.length() - sent;
+    if (n > (maxLen - len))
+    {
+      n = maxLen - len;
+    }
+    memcpy(buffer + len, piece.c_str() + sent, n);
+    len += n;
+    sent += n;
+  }
+  return len;
+}
@@ -0,0 +1,29 @@
+// confWebChunk.h - copy a page rendered piece by piece into the chunks of a response
+//
+// 2026-10-18 mh
+// - first version, taken out of IotWebConf::fillConfigChunk()
+//
+// Copyright (C) 2026 Manfred Herbert
+
+#ifndef CONF_WEB_CHUNK_h
+#define CONF_WEB_CHUNK_h
+
+#include <Arduino.h>
+#include <functional>
+
+/**
+ * Renders the next piece of a page into piece (it is empty on the call and
+ *   may stay empty). Returns false at the end of the page.
+ */
+typedef std::function<bool(String& piece)> PieceRenderer;
+
+/**
+ * Copy up to maxLen bytes of the page into buffer (the filler of a chunked
+ *   response). piece and sent keep the current piece and its bytes copied
+ *   by former calls; start with an empty piece and sent = 0. The next piece
+ *   is rendered only when the current one is copied completely.
+ *   Returns the number of bytes copied, 0 at the end of the page.
+ */
+size_t fillChunkFromPieces(uint8_t* buffer, size_t maxLen, String& piece, size_t& sent, PieceRenderer renderer);
+
+#endif
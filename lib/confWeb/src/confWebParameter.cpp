@@ -1,5 +1,9 @@
 // confWebParameter.cpp - configuration page for WLAN access access using AsyncWebServer
 //
+// 2026-10-18 mh
+// - form items are rendered by HtmlTemplate into the content instead of String::replace()
+// - value, placeholder and option names are HTML escaped
+//
 // 2023-01-21 mh
 // - derived from IotWebConfParameter.cpp
 // - use ESPAsyncWebServer instead of ESP8266WebServer
@@ -37,6 +41,11 @@ namespace iotwebconf
 {
 #endif
 
+// -- templates of the form items, split once on first use
+static HtmlTemplate _formParamTemplate(IOTWEBCONF_HTML_FORM_PARAM);
+static HtmlTemplate _selectParamTemplate(IOTWEBCONF_HTML_FORM_SELECT_PARAM);
+static HtmlTemplate _optionTemplate(IOTWEBCONF_HTML_FORM_OPTION);
+
 ParameterGroup::ParameterGroup(
   const char* id, const char* label) :
   ConfigItem(id)
@@ -412,10 +421,12 @@ TextParameter::TextParameter(
 
 void TextParameter::renderHtml(bool dataArrived, WebRequestWrapper* webRequestWrapper)
 {
-  String content = this->renderHtml(
+  String content;
+  this->renderHtml(
     dataArrived,
     webRequestWrapper->hasArg(this->getId()),
-    webRequestWrapper->arg(this->getId()));
+    webRequestWrapper->arg(this->getId()),
+    content);
   webRequestWrapper->sendContent(content);
 }
 #if IOT_OLD
@@ -423,10 +434,11 @@ void TextParameter::renderHtml(bool dataArrived, WebRequestWrapper* webRequestWr
 // new for AsyncWebServer - that is the important one. The content is delivered by the called method.
 void TextParameter::renderHtml(bool dataArrived, WebRequestWrapper* webRequestWrapper, String& content)
 {
-   content += this->renderHtml(
+  this->renderHtml(
     dataArrived,
     webRequestWrapper->hasArg(this->getId()),       // check if a post message with this Id has beeen received
-    webRequestWrapper->arg(this->getId()));         // deliver the posted value
+    webRequestWrapper->arg(this->getId()),          // deliver the posted value
+    content);
 }
 // not used
 void TextParameter::renderHtml(bool dataArrived, String& content)
@@ -434,44 +446,34 @@ void TextParameter::renderHtml(bool dataArrived, String& content)
 
 }
 #endif // IOT_OLD
-String TextParameter::renderHtml(bool dataArrived, bool hasValueFromPost, String valueFromPost)
+void TextParameter::renderHtml(bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content)
 {
-  return this->renderHtml("text", hasValueFromPost, valueFromPost);
+  this->renderHtml("text", hasValueFromPost, valueFromPost, content);
 }
-// this method is called by the other parameter type methods. It does the work of composing the content string.
-String TextParameter::renderHtml(const char* type, bool hasValueFromPost, String valueFromPost)
+HtmlTemplate* TextParameter::getHtmlTemplate()
+{
+  return &_formParamTemplate;
+}
+// this method is called by the other parameter type methods. It does the work of composing the content.
+void TextParameter::renderHtml(const char* type, bool hasValueFromPost, const String& valueFromPost, String& content)
 {
   TextParameter* current = this;
   char parLength[12];
 
-  String pitem = getHtmlTemplate();
-
-  pitem.replace("{b}", current->label);
-  pitem.replace("{t}", type);
-  pitem.replace("{i}", current->getId());
-  pitem.replace("{p}", current->placeholder == nullptr ? "" : current->placeholder);
   snprintf(parLength, 12, "%d", current->getLength()-1);
-  pitem.replace("{l}", parLength);
-  if (hasValueFromPost)
-  {
-    // -- Value from previous submit
-    pitem.replace("{v}", valueFromPost);
-  }
-  else
-  {
-    // -- Value from config
-    pitem.replace("{v}", current->valueBuffer);
-  }
-  pitem.replace(
-      "{c}", current->customHtml == nullptr ? "" : current->customHtml);
-  pitem.replace(
-      "{s}",
-      current->errorMessage == nullptr ? "" : "de"); // Div style class.
-  pitem.replace(
-      "{e}",
-      current->errorMessage == nullptr ? "" : current->errorMessage);
-
-  return pitem;
+  HtmlTemplateArg args[] = {
+    {'b', current->label, false},
+    {'t', type, false},
+    {'i', current->getId(), false},
+    {'p', current->placeholder == nullptr ? "" : current->placeholder, true},
+    {'l', parLength, false},
+    // -- value from previous submit or from config
+    {'v', hasValueFromPost ? valueFromPost.c_str() : current->valueBuffer, true},
+    {'c', current->customHtml == nullptr ? "" : current->customHtml, false},
+    {'s', current->errorMessage == nullptr ? "" : "de", false},     // Div style class.
+    {'e', current->errorMessage == nullptr ? "" : current->errorMessage, false}
+  };
+  this->getHtmlTemplate()->render(content, args, sizeof(args) / sizeof(args[0]));
 }
 
 void TextParameter::update(String newValue)
@@ -506,9 +508,9 @@ NumberParameter::NumberParameter(
 {
 }
 
-String NumberParameter::renderHtml(bool dataArrived, bool hasValueFromPost, String valueFromPost)
+void NumberParameter::renderHtml(bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content)
 {
-  return TextParameter::renderHtml("number", hasValueFromPost, valueFromPost);
+  TextParameter::renderHtml("number", hasValueFromPost, valueFromPost, content);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -523,12 +525,12 @@ PasswordParameter::PasswordParameter(
 {
 }
 
-String PasswordParameter::renderHtml(bool dataArrived, bool hasValueFromPost, String valueFromPost)
+void PasswordParameter::renderHtml(bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content)
 {
 #if IOT_OLD
-  return TextParameter::renderHtml("password", true, String(" "));
+  TextParameter::renderHtml("password", true, String(" "), content);
 #else
-  return TextParameter::renderHtml("password", true, String(""));    // mh: empty string to avoid fill of value field in browser
+  TextParameter::renderHtml("password", true, String(""), content);    // mh: empty string to avoid fill of value field in browser
 #endif
 }
 
@@ -584,7 +586,7 @@ CheckboxParameter::CheckboxParameter(
 {
 }
 
-String CheckboxParameter::renderHtml(bool dataArrived, bool hasValueFromPost, String valueFromPost)
+void CheckboxParameter::renderHtml(bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content)
 {
   bool checkSelected = false;
   if (dataArrived)
@@ -612,7 +614,7 @@ String CheckboxParameter::renderHtml(bool dataArrived, bool hasValueFromPost, St
   }
   
   
-  return TextParameter::renderHtml("checkbox", true, "selected");
+  TextParameter::renderHtml("checkbox", true, String("selected"), content);
 }
 
 void CheckboxParameter::update(WebRequestWrapper* webRequestWrapper)
@@ -655,56 +657,37 @@ SelectParameter::SelectParameter(
 {
 }
 
-String SelectParameter::renderHtml(bool dataArrived, bool hasValueFromPost, String valueFromPost)
+void SelectParameter::renderHtml(bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content)
 {
   TextParameter* current = this;
 
-  String options = "";
+  HtmlTemplateArg args[] = {
+    {'b', current->label, false},
+    {'i', current->getId(), false},
+    {'c', current->customHtml == nullptr ? "" : current->customHtml, false},
+    {'s', current->errorMessage == nullptr ? "" : "de", false},     // Div style class.
+    {'e', current->errorMessage == nullptr ? "" : current->errorMessage, false},
+    {'o', nullptr, false}                                             // options are appended below
+  };
+  size_t argCount = sizeof(args) / sizeof(args[0]);
+  size_t next = _selectParamTemplate.render(content, args, argCount);
 
   for (size_t i=0; i<this->_optionCount; i++)
   {
     const char *optionValue = (this->_optionValues + (i*this->getLength()) );
     const char *optionName = (this->_optionNames + (i*this->_nameLength) );
-    String oitem = FPSTR(IOTWEBCONF_HTML_FORM_OPTION);
-    oitem.replace("{v}", optionValue);
-//    if (sizeof(this->_optionNames) > i)
-    {
-      oitem.replace("{n}", optionName);
-    }
-//    else
-//    {
-//      oitem.replace("{n}", "?");
-//    }
-    if ((hasValueFromPost && (valueFromPost == optionValue)) ||
-      (strncmp(current->valueBuffer, optionValue, this->getLength()) == 0))
-    {
-      // -- Value from previous submit
-      oitem.replace("{s}", " selected");
-    }
-    else
-    {
-      // -- Value from config
-      oitem.replace("{s}", "");
-    }
-
-    options += oitem;
+    // -- selected: value from previous submit or from config
+    bool selected = (hasValueFromPost && (valueFromPost == optionValue)) ||
+      (strncmp(current->valueBuffer, optionValue, this->getLength()) == 0);
+    HtmlTemplateArg optionArgs[] = {
+      {'v', optionValue, true},
+      {'n', optionName, true},
+      {'s', selected ? " selected" : "", false}
+    };
+    _optionTemplate.render(content, optionArgs, sizeof(optionArgs) / sizeof(optionArgs[0]));
   }
 
-  String pitem = FPSTR(IOTWEBCONF_HTML_FORM_SELECT_PARAM);
-
-  pitem.replace("{b}", current->label);
-  pitem.replace("{i}", current->getId());
-  pitem.replace(
-      "{c}", current->customHtml == nullptr ? "" : current->customHtml);
-  pitem.replace(
-      "{s}",
-      current->errorMessage == nullptr ? "" : "de"); // Div style class.
-  pitem.replace(
-      "{e}",
-      current->errorMessage == nullptr ? "" : current->errorMessage);
-  pitem.replace("{o}", options);
-
-  return pitem;
+  _selectParamTemplate.render(content, args, argCount, next);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,6 +16,7 @@
 #include <functional>
 #include "confWebSettings.h"
 #include "confWebServerWrapper.h"
+#include "confWebTemplate.h"
 
 #ifdef IOTWEBCONF_ENABLE_JSON
 # include <ArduinoJson.h>
@@ -116,6 +117,12 @@ public:
    */
   virtual void debugTo(Stream* out) = 0;
 
+  /**
+   * True for a ParameterGroup. The chunked config page walks into groups
+   *   itself instead of calling renderHtml() of the group.
+   */
+  virtual bool isGroup() { return false; }
+
 #ifdef IOTWEBCONF_ENABLE_JSON
   /**
    * 
@@ -140,6 +147,7 @@ public:
   void addItem(ConfigItem* configItem);
   const char *label;
   void applyDefaultValue() override;
+  bool isGroup() override { return true; }
 #ifdef IOTWEBCONF_ENABLE_JSON
   virtual void loadFromJson(JsonObject jsonObject) override;
 #endif
@@ -258,7 +266,10 @@ public:
   const char* customHtml;
 
 protected:
-  virtual String renderHtml(bool dataArrived, bool hasValueFromPost, String valueFromPost);
+  /**
+   * Appends the HTML form item to content.
+   */
+  virtual void renderHtml(bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content);
   // Overrides
   virtual void renderHtml(bool dataArrived, WebRequestWrapper* webRequestWrapper) override;
   virtual void renderHtml(bool dataArrived, WebRequestWrapper* webRequestWrapper, String& content) override;
@@ -269,13 +280,13 @@ protected:
    * One can override this method in case a specific HTML template is required
    * for a parameter.
    */
-  virtual String getHtmlTemplate() { return FPSTR(IOTWEBCONF_HTML_FORM_PARAM); };
+  virtual HtmlTemplate* getHtmlTemplate();
 
   /**
-   * Renders a standard HTML form INPUT.
+   * Renders a standard HTML form INPUT and appends it to content.
    * @type - The type attribute of the html input field.
    */
-  virtual String renderHtml(const char* type, bool hasValueFromPost, String valueFromPost);
+  virtual void renderHtml(const char* type, bool hasValueFromPost, const String& valueFromPost, String& content);
 
 private:
   friend class IotWebConf;
@@ -306,8 +317,8 @@ public:
 
 protected:
   // Overrides
-  virtual String renderHtml(
-    bool dataArrived, bool hasValueFromPost, String valueFromPost) override;
+  virtual void renderHtml(
+    bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content) override;
   virtual void update(String newValue) override;
   virtual void debugTo(Stream* out) override;
 
@@ -337,8 +348,8 @@ public:
 
 protected:
   // Overrides
-  virtual String renderHtml(
-    bool dataArrived, bool hasValueFromPost, String valueFromPost) override;
+  virtual void renderHtml(
+    bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content) override;
 
 private:
   friend class IotWebConf;
@@ -366,8 +377,8 @@ public:
 
 protected:
   // Overrides
-  virtual String renderHtml(
-    bool dataArrived, bool hasValueFromPost, String valueFromPost) override;
+  virtual void renderHtml(
+    bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content) override;
   virtual void update(WebRequestWrapper* webRequestWrapper) override;
 
 private:
@@ -431,8 +442,8 @@ public:
 
 protected:
   // Overrides
-  virtual String renderHtml(
-    bool dataArrived, bool hasValueFromPost, String valueFromPost) override;
+  virtual void renderHtml(
+    bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content) override;
 
 private:
   friend class IotWebConf;
@@ -4,6 +4,9 @@
 
 // confWebSettings.h - configuration page for WLAN access using AsyncWebServer
 //
+// 2026-10-18 mh
+// - IOTWEBCONF_RENDER_DEPTH for the chunked config page
+//
 // 2023-01-21 mh
 // - derived from IotWebConfSettings.h
 // - use ESPAsyncWebServer instead of ESP8266WebServer
@@ -44,6 +47,12 @@
 # define IOTWEBCONF_PASSWORD_LEN 33
 #endif
 
+// -- Max. nesting of parameter groups on the config page, that is rendered
+// one parameter per step (e.g. system > wifi > parameter).
+#ifndef IOTWEBCONF_RENDER_DEPTH
+# define IOTWEBCONF_RENDER_DEPTH 4
+#endif
+
 // -- IotWebConf tries to connect to the local network for an amount of time
 // before falling back to AP mode.
 #ifndef IOTWEBCONF_DEFAULT_WIFI_CONNECTION_TIMEOUT_MS
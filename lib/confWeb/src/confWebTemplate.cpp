@@ -0,0 +1,355 @@
+// confWebTemplate.cpp - pre-split HTML templates for the config page
+//
+// 2026-10-18 mh
+// - getLength() takes a value nullptr as empty, like fill()
+// - fill() copies the output of a template into a send buffer, getLength()
+// - first version, replaces String::replace() of the parameter templates
+//
+// Copyright (C) 2026 Manfred Herbert
+
+/* *** Description ***
+The form templates of the parameters (IOTWEBCONF_HTML_FORM_PARAM etc.) used to be copied from PROGMEM into a String
+and filled by one String::replace() per placeholder, each of them scanning and reallocating the whole item.
+A HtmlTemplate does the scan once and renders each item with one pass and one reservation of the output.
+
+** Usage **
+static HtmlTemplate paramTemplate(IOTWEBCONF_HTML_FORM_PARAM);
+HtmlTemplateArg args[] = {{'b', label, false}, {'v', valueBuffer, true}};
+paramTemplate.render(content, args, 2);       appends to content
+
+Content between two parts of a template (e.g. options of a select) is appended by the caller:
+HtmlTemplateArg args[] = {{'b', label, false}, {'o', nullptr, false}};
+size_t next = selectTemplate.render(content, args, 2);     stops at {o}
+... append options ...
+selectTemplate.render(content, args, 2, next);
+
+A whole page is sent without building it in RAM by a response filler:
+request->beginResponse("text/html", pageTemplate.getLength(args, n),
+  [..](uint8_t* buffer, size_t maxLen, size_t index) { return pageTemplate.fill(buffer, maxLen, args, n, index); });
+
+** Implementation **
+split() counts the placeholders (a lower case letter in braces), allocates the segment table once with the exact
+size and keeps offset and length of each literal and the letter of the placeholder after it. The templates are
+static objects, so the table lives as long as the firmware runs. Literals are copied from PROGMEM in small blocks.
+Values of user input (value, placeholder, option names) are HTML escaped, so e.g. a ' in a value does not end the
+attribute; labels, custom HTML and error messages are HTML of the firmware and inserted as they are.
+fill() keeps no state: it walks the literals and values from the start, skips index bytes and copies the next ones
+directly from PROGMEM resp. the values into the buffer, escaping on the fly. The values must not change while a
+response is sent. fill() and getLength() take a value nullptr as empty, so Content-Length always matches the bytes
+sent; only render() stops there.
+  *** end description *** */
+
+#include "confWebTemplate.h"
+
+#define HTML_TEMPLATE_COPY_SIZE 32      // bytes copied from PROGMEM per block
+
+size_t HtmlTemplate::render(String& out, const HtmlTemplateArg* args, size_t argCount, size_t first)
+{
+  if (this->_segments == nullptr)
+  {
+    this->split();
+  }
+
+  // -- size of output, so it is reserved only once
+  out.reserve(out.length() + this->measure(args, argCount, first, true));
+
+  size_t i;
+  for (i = first; i < this->_segmentCount; i++)
+  {
+    const Segment& segment = this->_segments[i];
+    this->appendLiteral(out, segment);
+    if (segment.slot == 0)
+    {
+      continue;
+    }
+    const HtmlTemplateArg* arg = this->findArg(segment.slot, args, argCount);
+    if (arg == nullptr)
+    {
+      const char placeholder[3] = {'{', segment.slot, '}'};
+      out.concat(placeholder, 3);
+    }
+    else if (arg->value == nullptr)
+    {
+      return i + 1;
+    }
+    else if (arg->escape)
+    {
+      appendEscaped(out, arg->value);
+    }
+    else
+    {
+      out.concat(arg->value, strlen(arg->value));
+    }
+  }
+  return this->_segmentCount;
+}
+
+size_t HtmlTemplate::fill(uint8_t* buffer, size_t maxLen, const HtmlTemplateArg* args, size_t argCount, size_t index)
+{
+  if (this->_segments == nullptr)
+  {
+    this->split();
+  }
+
+  size_t done = 0;
+  size_t skip = index;      // bytes of the output before the current part
+  size_t i;
+  for (i = 0; (i < this->_segmentCount) && (done < maxLen); i++)
+  {
+    // -- literal
+    const Segment& segment = this->_segments[i];
+    if (skip >= segment.length)
+    {
+      skip -= segment.length;
+    }
+    else
+    {
+      size_t n = segment.length - skip;
+      if (n > (maxLen - done))
+      {
+        n = maxLen - done;
+      }
+      memcpy_P(buffer + done, this->_text + segment.offset + skip, n);
+      done += n;
+      skip = 0;
+    }
+    if ((segment.slot == 0) || (done >= maxLen))
+    {
+      continue;
+    }
+
+    // -- value
+    const HtmlTemplateArg* arg = this->findArg(segment.slot, args, argCount);
+    const char placeholder[4] = {'{', segment.slot, '}', '\0'};
+    const char* value = (arg == nullptr) ? placeholder : arg->value;
+    if (value == nullptr)
+    {
+      continue;
+    }
+    if ((arg != nullptr) && arg->escape)
+    {
+      size_t length = getEscapedLength(value);
+      if (skip >= length)
+      {
+        skip -= length;
+        continue;
+      }
+      done += copyEscaped(buffer + done, maxLen - done, value, skip);
+    }
+    else
+    {
+      size_t length = strlen(value);
+      if (skip >= length)
+      {
+        skip -= length;
+        continue;
+      }
+      size_t n = length - skip;
+      if (n > (maxLen - done))
+      {
+        n = maxLen - done;
+      }
+      memcpy(buffer + done, value + skip, n);
+      done += n;
+    }
+    skip = 0;
+  }
+  return done;
+}
+
+size_t HtmlTemplate::getLength(const HtmlTemplateArg* args, size_t argCount)
+{
+  if (this->_segments == nullptr)
+  {
+    this->split();
+  }
+  return this->measure(args, argCount, 0, false);
+}
+
+size_t HtmlTemplate::measure(const HtmlTemplateArg* args, size_t argCount, size_t first, bool stopAtNull)
+{
+  // -- length of output from segment first up to the end,
+  //    stopAtNull: up to a placeholder with value nullptr (render()), else the value is empty (fill())
+  size_t length = 0;
+  size_t i;
+  for (i = first; i < this->_segmentCount; i++)
+  {
+    const Segment& segment = this->_segments[i];
+    length += segment.length;
+    if (segment.slot == 0)
+    {
+      continue;
+    }
+    const HtmlTemplateArg* arg = this->findArg(segment.slot, args, argCount);
+    if (arg == nullptr)
+    {
+      length += 3;
+    }
+    else if (arg->value == nullptr)
+    {
+      if (stopAtNull)
+      {
+        break;
+      }
+    }
+    else
+    {
+      length += arg->escape ? getEscapedLength(arg->value) : strlen(arg->value);
+    }
+  }
+  return length;
+}
+
+size_t HtmlTemplate::getSegmentCount()
+{
+  if (this->_segments == nullptr)
+  {
+    this->split();
+  }
+  return this->_segmentCount;
+}
+
+void HtmlTemplate::split()
+{
+  size_t length = strlen_P(this->_text);
+  size_t count = 1;
+  size_t i;
+  for (i = 0; i < length; i++)
+  {
+    if (this->isPlaceholder(i, length))
+    {
+      count++;
+      i += 2;
+    }
+  }
+
+  this->_segments = new Segment[count];
+  size_t n = 0;
+  size_t start = 0;
+  for (i = 0; i < length; i++)
+  {
+    if (this->isPlaceholder(i, length))
+    {
+      this->_segments[n].offset = start;
+      this->_segments[n].length = i - start;
+      this->_segments[n].slot = pgm_read_byte(this->_text + i + 1);
+      n++;
+      i += 2;
+      start = i + 1;
+    }
+  }
+  this->_segments[n].offset = start;
+  this->_segments[n].length = length - start;
+  this->_segments[n].slot = 0;
+  this->_segmentCount = count;
+}
+
+bool HtmlTemplate::isPlaceholder(size_t i, size_t length)
+{
+  if ((i + 2) >= length)
+  {
+    return false;
+  }
+  char slot = pgm_read_byte(this->_text + i + 1);
+  return (pgm_read_byte(this->_text + i) == '{') && (slot >= 'a') && (slot <= 'z') &&
+    (pgm_read_byte(this->_text + i + 2) == '}');
+}
+
+void HtmlTemplate::appendLiteral(String& out, const Segment& segment)
+{
+  char buffer[HTML_TEMPLATE_COPY_SIZE];
+  size_t done = 0;
+  while (done < segment.length)
+  {
+    size_t n = segment.length - done;
+    if (n > sizeof(buffer))
+    {
+      n = sizeof(buffer);
+    }
+    memcpy_P(buffer, this->_text + segment.offset + done, n);
+    out.concat(buffer, n);
+    done += n;
+  }
+}
+
+const HtmlTemplateArg* HtmlTemplate::findArg(char slot, const HtmlTemplateArg* args, size_t argCount)
+{
+  size_t i;
+  for (i = 0; i < argCount; i++)
+  {
+    if (args[i].slot == slot)
+    {
+      return &args[i];
+    }
+  }
+  return nullptr;
+}
+
+static const char* entityOf(char c)
+{
+  switch (c)
+  {
+  case '&':   return "&amp;";
+  case '<':   return "&lt;";
+  case '>':   return "&gt;";
+  case '\'':  return "&#39;";
+  case '"':   return "&quot;";
+  default:    return nullptr;
+  }
+}
+
+void HtmlTemplate::appendEscaped(String& out, const char* text)
+{
+  // -- runs without special characters are appended as one block
+  const char* run = text;
+  while (*text != '\0')
+  {
+    const char* entity = entityOf(*text);
+    if (entity != nullptr)
+    {
+      out.concat(run, text - run);
+      out.concat(entity, strlen(entity));
+      run = text + 1;
+    }
+    text++;
+  }
+  out.concat(run, text - run);
+}
+
+size_t HtmlTemplate::copyEscaped(uint8_t* buffer, size_t maxLen, const char* text, size_t skip)
+{
+  // -- escaped output of text without the first skip bytes, at most maxLen bytes
+  size_t done = 0;
+  while ((*text != '\0') && (done < maxLen))
+  {
+    const char* entity = entityOf(*text);
+    const char single[2] = {*text, '\0'};
+    const char* part = (entity != nullptr) ? entity : single;
+    while ((*part != '\0') && (done < maxLen))
+    {
+      if (skip > 0)
+      {
+        skip--;
+      }
+      else
+      {
+        buffer[done++] = *part;
+      }
+      part++;
+    }
+    text++;
+  }
+  return done;
+}
+
+size_t HtmlTemplate::getEscapedLength(const char* text)
+{
+  size_t length = 0;
+  while (*text != '\0')
+  {
+    const char* entity = entityOf(*text);
+    length += (entity != nullptr) ? strlen(entity) : 1;
+    text++;
+  }
+  return length;
+}
@@ -0,0 +1,87 @@
+// confWebTemplate.h - pre-split HTML templates for the config page
+//
+// 2026-10-18 mh
+// - getLength() takes a value nullptr as empty, like fill()
+// - fill() copies the output of a template into a send buffer, getLength()
+// - first version, replaces String::replace() of the parameter templates
+//
+// Copyright (C) 2026 Manfred Herbert
+
+#ifndef CONF_WEB_TEMPLATE_h
+#define CONF_WEB_TEMPLATE_h
+
+#include <Arduino.h>
+
+/**
+ * Value of a placeholder {x} of a HtmlTemplate.
+ * @slot - letter of the placeholder, e.g. 'v' for {v}
+ * @value - text inserted for the placeholder. nullptr stops render() at
+ *   this placeholder, see HtmlTemplate::render(); fill() and getLength()
+ *   take it as empty.
+ * @escape - true: value is text and is HTML escaped (&, <, >, ', "),
+ *   false: value is inserted as HTML.
+ */
+struct HtmlTemplateArg
+{
+  char slot;
+  const char* value;
+  bool escape;
+};
+
+/**
+ * A PROGMEM template with placeholders {a} .. {z}. On the first use it is
+ * split once into literal segments, each followed by a placeholder slot.
+ * Rendering appends segments and values to the output in one pass, the output
+ * is reserved once before.
+ */
+class HtmlTemplate
+{
+public:
+  HtmlTemplate(PGM_P text) { this->_text = text; }
+
+  /**
+   * Append the template to out, starting with segment first.
+   *   A placeholder without arg is kept as it is.
+   *   Returns the segment to continue with after a placeholder with value
+   *   nullptr (the caller appends its content), getSegmentCount() at the end.
+   */
+  size_t render(String& out, const HtmlTemplateArg* args, size_t argCount, size_t first = 0);
+  size_t getSegmentCount();
+
+  /**
+   * Copy up to maxLen bytes of the output, starting at byte index, into
+   *   buffer (e.g. the filler of a web server response), so the page is never
+   *   held in RAM as a whole. A value nullptr is taken as empty.
+   *   Returns the number of bytes copied, 0 at the end.
+   */
+  size_t fill(uint8_t* buffer, size_t maxLen, const HtmlTemplateArg* args, size_t argCount, size_t index);
+  /**
+   * Length of the whole output, e.g. for Content-Length. A value nullptr is
+   *   taken as empty, so it is the number of bytes fill() delivers.
+   */
+  size_t getLength(const HtmlTemplateArg* args, size_t argCount);
+
+  static void appendEscaped(String& out, const char* text);
+  static size_t getEscapedLength(const char* text);
+
+private:
+  struct Segment
+  {
+    uint16_t offset;      // literal in _text
+    uint16_t length;
+    char slot;            // placeholder after the literal, 0: none (last segment)
+  };
+
+  PGM_P _text;
+  Segment* _segments = nullptr;
+  size_t _segmentCount = 0;
+
+  void split();
+  bool isPlaceholder(size_t i, size_t length);
+  void appendLiteral(String& out, const Segment& segment);
+  size_t measure(const HtmlTemplateArg* args, size_t argCount, size_t first, bool stopAtNull);
+  static size_t copyEscaped(uint8_t* buffer, size_t maxLen, const char* text, size_t skip);
+  const HtmlTemplateArg* findArg(char slot, const HtmlTemplateArg* args, size_t argCount);
+};
+
+#endif
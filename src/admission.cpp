@@ -0,0 +1,153 @@
+// admission.cpp
+//
+// admission control of the web server: max requests in progress, heap watermark, rate limit per client
+//
+// 2026-10-18 mh
+// - first version
+// - token bucket moved to rateLimiter.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+ESPAsyncTCP and the handlers allocate heap for each request. A browser tab left open or a scraper polling
+/api/all.json every 100 ms must not starve the heap needed by modbus, http transfer and the queue. So each request
+is checked before it reaches a handler:
+- free heap below ADMISSION_HEAP_MIN:                 503 Service Unavailable
+- ADMISSION_MAX_ACTIVE requests in progress:          503 Service Unavailable
+- token bucket of the client (IP) empty:              429 Too Many Requests
+each with Retry-After: ADMISSION_RETRY_AFTER. The answer is a short text, composed before anything else is allocated.
+
+** Usage **
+admission.begin(server);              in setup(), before the handlers to be protected are added
+admission.setStreamUrl(SSE_URL);      long-lived requests are not counted as in progress
+admission.getActive() ...             counters for /metrics
+
+** Implementation **
+AdmissionControl is an AsyncWebHandler; AsyncWebServer asks the handlers in the order they were added, so it has to
+be added first. canHandle() returns false for an admitted request, which goes on to the next handler, and true for
+a rejected one, which is then answered by handleRequest(). The verdict is passed in _tempObject of the request, which
+is freed by AsyncWebServer with the request.
+An admitted request is counted as active until its connection is closed (onDisconnect of the request; no other
+handler of this firmware uses it). Requests of server-sent events stay open and have their own limit
+(SSE_MAX_CLIENTS), so they are not counted.
+The token bucket per client is in RateLimiter (rateLimiter.cpp).
+Dash board page and WebSocket are added by ESPDash in its constructor, before setup(), so they are not checked.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "admission.h"
+
+void AdmissionControl::begin(AsyncWebServer& server)
+{
+  server.addHandler(this);
+}
+
+void AdmissionControl::setStreamUrl(const char* url)
+{
+  _streamUrl = url;
+}
+
+bool AdmissionControl::canHandle(AsyncWebServerRequest* request)
+//
+// false: admitted, next handler; true: rejected, answered by handleRequest()
+{
+  Verdict verdict = check(request);
+  if(verdict == admADMIT)
+  {
+    _admitCount++;
+    if((_streamUrl == nullptr) || (request->url() != _streamUrl))
+    {
+      _active++;
+      if(_active > _maxActive)
+      {
+        _maxActive = _active;
+      }
+      request->onDisconnect([this]()
+      {
+        if(_active > 0)
+        {
+          _active--;
+        }
+      });
+    }
+    return false;
+  }
+  uint8_t* tempVerdict = (uint8_t*)malloc(sizeof(uint8_t));    // freed by AsyncWebServer with the request
+  if(tempVerdict != nullptr)
+  {
+    *tempVerdict = verdict;
+  }
+  request->_tempObject = tempVerdict;
+  return true;
+}
+
+void AdmissionControl::handleRequest(AsyncWebServerRequest* request)
+{
+  uint8_t verdict = (request->_tempObject != nullptr) ? *(uint8_t*)request->_tempObject : admHEAP;
+  AsyncWebServerResponse* response;
+  if(verdict == admRATE)
+  {
+    response = request->beginResponse(429, "text/plain", "too many requests");
+  }
+  else
+  {
+    response = request->beginResponse(503, "text/plain", "busy");
+  }
+  response->addHeader("Retry-After", ADMISSION_RETRY_AFTER);
+  request->send(response);
+}
+
+AdmissionControl::Verdict AdmissionControl::check(AsyncWebServerRequest* request)
+{
+  if(ESP.getFreeHeap() < ADMISSION_HEAP_MIN)
+  {
+    _heapCount++;
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"admission: low heap, %s rejected", request->url().c_str());
+    return admHEAP;
+  }
+  if(_active >= ADMISSION_MAX_ACTIVE)
+  {
+    _busyCount++;
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"admission: %u requests active, %s rejected", _active, request->url().c_str());
+    return admBUSY;
+  }
+  if(!_limiter.take((uint32_t)request->client()->remoteIP(), millis()))
+  {
+    _rateCount++;
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"admission: rate limit, %s rejected", request->url().c_str());
+    return admRATE;
+  }
+  return admADMIT;
+}
+
+uint8_t AdmissionControl::getActive()
+{
+  return _active;
+}
+
+uint8_t AdmissionControl::getMaxActive()
+{
+  return _maxActive;
+}
+
+uint32_t AdmissionControl::getAdmitCount()
+{
+  return _admitCount;
+}
+
+uint32_t AdmissionControl::getBusyCount()
+{
+  return _busyCount;
+}
+
+uint32_t AdmissionControl::getHeapCount()
+{
+  return _heapCount;
+}
+
+uint32_t AdmissionControl::getRateCount()
+{
+  return _rateCount;
+}
@@ -0,0 +1,53 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+//
+// 2026-10-18 mh
+// - first version
+// - token bucket moved to rateLimiter.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "config.h"
+#include "rateLimiter.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+// admission control: max requests in progress, free heap and token bucket per client, checked before all
+// handlers added later to the web server
+class AdmissionControl : public AsyncWebHandler
+{
+public:
+    void begin(AsyncWebServer& server);
+    void setStreamUrl(const char* url);
+
+    uint8_t getActive();
+    uint8_t getMaxActive();
+    uint32_t getAdmitCount();
+    uint32_t getBusyCount();
+    uint32_t getHeapCount();
+    uint32_t getRateCount();
+
+    // AsyncWebHandler
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+    bool isRequestHandlerTrivial() override { return true; }
+
+private:
+    enum Verdict : uint8_t {admADMIT, admBUSY, admHEAP, admRATE};
+
+    RateLimiter _limiter;
+    const char* _streamUrl = nullptr;   // long-lived requests (server-sent events), not counted as active
+    volatile uint8_t _active = 0;
+    uint8_t _maxActive = 0;             // peak of _active
+    uint32_t _admitCount = 0;
+    uint32_t _busyCount = 0;            // 503, max active requests
+    uint32_t _heapCount = 0;            // 503, low heap
+    uint32_t _rateCount = 0;            // 429, token bucket of client empty
+
+    Verdict check(AsyncWebServerRequest* request);
+};
+#endif // ADMISSION_H
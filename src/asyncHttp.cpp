@@ -0,0 +1,508 @@
+// asyncHttp.cpp
+//
+// non-blocking http POST client based on ESPAsyncTCP
+//
+// 2026-10-18 mh
+// - first version, replaces HTTPClient in vzHttp
+// - connect by IP from DnsCache, host name is sent in the Host header
+// - no heap allocation per request: header built once by setServer(), body sent from buffer of the user
+// - optional Content-Encoding header per request, e.g. gzip
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Sends one http/1.1 POST request at a time to a server without blocking loop().
+
+** Usage **
+asyncHttp.setServer("volks-raspi", "/middleware.php/data.json", "application/json");
+asyncHttp.post(body, len);                   returns false if a request is still in progress,
+                                             body must stay unchanged until the result is taken
+asyncHttp.post(gzBody, gzLen, "gzip");       compressed body, sent with Content-Encoding: gzip
+asyncHttp.doLoop();                          call in loop(), handles timeouts
+if(asyncHttp.hasResult())
+  httpResponseCode = asyncHttp.takeResult(); http status code or negative ASYNC_HTTP_ERROR_XXX
+
+** Implementation **
+The request is written from the tcp callbacks of AsyncClient (connect, ack); the response is parsed in the data
+callback: status line, Content-Length, chunked transfer encoding and Connection header. The body is discarded.
+The connection is kept open after the response (keep-alive) and used for the next request, unless the server closes
+it or it was idle for VZ_HTTP_IDLE_TIMEOUT. If a reused connection fails before any response data arrived, the
+request is repeated once on a new connection.
+A request not completed within VZ_HTTP_TIMEOUT is aborted by doLoop().
+The connection is opened to the IP of the server kept by DnsCache, so there is no DNS lookup per request; the Host
+header carries the server name. A failed connect invalidates the cached IP, see dnsCache.cpp.
+Callbacks only update the state; the result is taken by the user in loop() context.
+The request line and fixed header lines are composed once by setServer() into a char buffer; post() only formats
+the Content-Length and, if given, the Content-Encoding. Header, length and body are passed to tcp piece by piece (txSegment()), so no String is built.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "config.h"
+#include "asyncHttp.h"
+
+AsyncHttp::AsyncHttp()
+{
+  _client.onConnect([this](void* arg, AsyncClient* client)
+  {
+    _connected = true;
+    if(_state == CONNECTING)
+    {
+      _state = SENDING;
+      sendData();
+    }
+  });
+  _client.onAck([this](void* arg, AsyncClient* client, size_t len, uint32_t time)
+  {
+    sendData();
+  });
+  _client.onData([this](void* arg, AsyncClient* client, void* data, size_t len)
+  {
+    onData((const char*)data, len);
+  });
+  _client.onTimeout([this](void* arg, AsyncClient* client, uint32_t time)
+  {
+    client->close();
+  });
+  _client.onDisconnect([this](void* arg, AsyncClient* client)
+  {
+    _connected = false;
+    if(_state == CONNECTING)
+    {
+      _dns.invalidate();          // server may have a new IP
+    }
+    if((_state == CONNECTING) || (_state == SENDING) || (_state == RECEIVING))
+    {
+      if((_rxState == RX_BODY) && (_rxLeft < 0))
+      {
+        finish(_result);          // body without length ends with close
+      }
+      else if(_reused && !_rxAny)
+      {
+        _retryPending = true;     // stale keep-alive connection, repeat by doLoop()
+      }
+      else
+      {
+        finish((_state == CONNECTING) ? ASYNC_HTTP_ERROR_CONNECTION_FAILED : ASYNC_HTTP_ERROR_CONNECTION_LOST);
+      }
+    }
+  });
+}
+
+void AsyncHttp::setServer(const String& server, const String& path, const char* contentType, const char* extraHeader)
+//
+// server: host name or IP, optionally with :port
+// extraHeader: additional header line without CRLF or nullptr
+{
+  int colon = server.indexOf(':');
+  if(colon >= 0)
+  {
+    _host = server.substring(0, colon);
+    _port = server.substring(colon + 1).toInt();
+  }
+  else
+  {
+    _host = server;
+    _port = 80;
+  }
+  _path = path;
+  _dns.setHost(_host);
+  bool extra = (extraHeader != nullptr) && (extraHeader[0] != '\0');
+  int len = snprintf(_header, sizeof(_header),
+                     "POST %s HTTP/1.1\r\nHost: %s\r\nConnection: keep-alive\r\n%s%sContent-Type: %s\r\nContent-Length: ",
+                     _path.c_str(), _host.c_str(), extra ? extraHeader : "", extra ? "\r\n" : "", contentType);
+  _headerLen = ((len > 0) && ((size_t)len < sizeof(_header))) ? len : 0;
+  if(_headerLen == 0)
+  {
+    DEBUG_TRACE(true,"asyncHttp: server name or path too long");
+  }
+  close();
+}
+
+bool AsyncHttp::post(const char* body, size_t len, const char* contentEncoding)
+//
+// start a POST request, return false if the previous request is not finished yet
+// contentEncoding: value of header Content-Encoding or nullptr
+{
+  if((_state != IDLE) || (_headerLen == 0))
+  {
+    return false;
+  }
+
+  if(contentEncoding != nullptr)
+  {
+    _lengthLineLen = snprintf(_lengthLine, sizeof(_lengthLine), "%u\r\nContent-Encoding: %s\r\n\r\n", (unsigned)len, contentEncoding);
+  }
+  else
+  {
+    _lengthLineLen = snprintf(_lengthLine, sizeof(_lengthLine), "%u\r\n\r\n", (unsigned)len);
+  }
+  _body = body;
+  _bodyLen = len;
+  _txPos = 0;
+  _rxState = RX_STATUS;
+  _lineLen = 0;
+  _rxLeft = -1;
+  _rxAny = false;
+  _chunked = false;
+  _keepAlive = true;
+  _result = 0;
+  _startTime = millis();
+  _requestCount++;
+
+  if(_connected && ((_startTime - _lastActivity) <= VZ_HTTP_IDLE_TIMEOUT))
+  {
+    _reused = true;
+    _state = SENDING;
+    sendData();
+  }
+  else
+  {
+    if(_connected)
+    {
+      _client.close(true);        // idle too long, server may have dropped it
+    }
+    _reused = false;
+    connect();
+  }
+  return true;
+}
+
+bool AsyncHttp::isBusy()
+{
+  return _state != IDLE;
+}
+
+bool AsyncHttp::hasResult()
+{
+  return _state == DONE;
+}
+
+int AsyncHttp::takeResult()
+//
+// return result of finished request and free resources
+{
+  if(_state != DONE)
+  {
+    return 0;
+  }
+  _body = nullptr;
+  _state = IDLE;
+  return _result;
+}
+
+void AsyncHttp::doLoop()
+{
+  uint32_t now = millis();
+
+  _dns.doLoop();
+  if(_state == RESOLVING)
+  {
+    if(_dns.hasIP())
+    {
+      connect();
+    }
+    else if(!_dns.isBusy())
+    {
+      finish(ASYNC_HTTP_ERROR_CONNECTION_FAILED);   // host not found
+    }
+  }
+  if(_retryPending)
+  {
+    _retryPending = false;
+    _reconnectCount++;
+    _reused = false;
+    _txPos = 0;
+    _rxState = RX_STATUS;
+    _lineLen = 0;
+    _rxLeft = -1;
+    _chunked = false;
+    connect();
+  }
+  if(((_state == RESOLVING) || (_state == CONNECTING) || (_state == SENDING) || (_state == RECEIVING)) && ((now - _startTime) > VZ_HTTP_TIMEOUT))
+  {
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"asyncHttp: timeout, state %d",_state);
+    finish(ASYNC_HTTP_ERROR_READ_TIMEOUT);
+    _client.close(true);
+  }
+  if((_state == IDLE) && _connected && ((now - _lastActivity) > VZ_HTTP_IDLE_TIMEOUT))
+  {
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"asyncHttp: closing idle connection to %s",_host.c_str());
+    _client.close();
+  }
+}
+
+void AsyncHttp::close()
+{
+  if(_connected)
+  {
+    _client.close(true);
+  }
+}
+
+uint32_t AsyncHttp::getRequestCount()
+{
+  return _requestCount;
+}
+
+uint32_t AsyncHttp::getConnectCount()
+{
+  return _connectCount;
+}
+
+uint32_t AsyncHttp::getReconnectCount()
+{
+  return _reconnectCount;
+}
+
+uint32_t AsyncHttp::getLastLatency()
+{
+  return _lastLatency;
+}
+
+uint32_t AsyncHttp::getAvgLatency()
+{
+  if(_latencyCount == 0)
+  {
+    return 0;
+  }
+  return _latencySum / _latencyCount;
+}
+
+uint32_t AsyncHttp::getBytesSent()
+{
+  return _bytesSent;
+}
+
+DnsCache& AsyncHttp::getDns()
+{
+  return _dns;
+}
+
+void AsyncHttp::connect()
+//
+// open connection to the cached IP, wait in RESOLVING for the first lookup
+{
+  IPAddress ip;
+  if(!_dns.getIP(ip))
+  {
+    if(_dns.isBusy())
+    {
+      _state = RESOLVING;
+    }
+    else
+    {
+      finish(ASYNC_HTTP_ERROR_CONNECTION_FAILED);   // never resolved and DNS down
+    }
+    return;
+  }
+  _state = CONNECTING;
+  _connectCount++;
+  if(!_client.connect(ip, _port))
+  {
+    _dns.invalidate();
+    finish(ASYNC_HTTP_ERROR_CONNECTION_FAILED);
+  }
+}
+
+void AsyncHttp::sendData()
+//
+// pass as much of the request to tcp as fits, called again on ack
+{
+  if(_state != SENDING)
+  {
+    return;
+  }
+  size_t len = _headerLen + _lengthLineLen + _bodyLen;
+  while (_txPos < len)
+  {
+    size_t n = _client.space();
+    if(n == 0)
+    {
+      break;
+    }
+    const char* data;
+    size_t left = txSegment(_txPos, data);
+    if(n > left)
+    {
+      n = left;
+    }
+    size_t added = _client.add(data, n);
+    if(added == 0)
+    {
+      break;
+    }
+    _txPos += added;
+    _bytesSent += added;
+  }
+  _client.send();
+  if(_txPos >= len)
+  {
+    _state = RECEIVING;
+  }
+}
+
+size_t AsyncHttp::txSegment(size_t pos, const char*& data)
+//
+// data of the request at pos, return bytes left in this segment (header, length line or body)
+{
+  if(pos < _headerLen)
+  {
+    data = &_header[pos];
+    return _headerLen - pos;
+  }
+  pos -= _headerLen;
+  if(pos < _lengthLineLen)
+  {
+    data = &_lengthLine[pos];
+    return _lengthLineLen - pos;
+  }
+  pos -= _lengthLineLen;
+  data = &_body[pos];
+  return _bodyLen - pos;
+}
+
+void AsyncHttp::onData(const char* data, size_t len)
+{
+  if((_state != RECEIVING) && (_state != SENDING))
+  {
+    return;
+  }
+  _rxAny = true;
+  size_t i = 0;
+  while ((i < len) && (_rxState != RX_DONE))
+  {
+    if((_rxState == RX_BODY) || (_rxState == RX_CHUNK_DATA))
+    {
+      // skip body data
+      size_t n = len - i;
+      if((_rxLeft >= 0) && (n > (size_t)_rxLeft))
+      {
+        n = _rxLeft;
+      }
+      i += n;
+      if(_rxLeft >= 0)
+      {
+        _rxLeft -= n;
+        if(_rxLeft == 0)
+        {
+          _rxState = (_rxState == RX_BODY) ? RX_DONE : RX_CHUNK_END;
+        }
+      }
+    }
+    else
+    {
+      if(rxLine(data[i]))
+      {
+        parseLine();
+      }
+      i++;
+    }
+  }
+  if(_rxState == RX_DONE)
+  {
+    finish(_result);
+    if(!_keepAlive)
+    {
+      _client.close();
+    }
+  }
+}
+
+bool AsyncHttp::rxLine(char c)
+//
+// collect a line, return true at end of line
+{
+  if(c == '\n')
+  {
+    if((_lineLen > 0) && (_line[_lineLen - 1] == '\r'))
+    {
+      _lineLen--;
+    }
+    _line[_lineLen] = '\0';
+    return true;
+  }
+  if(_lineLen < (sizeof(_line) - 1))
+  {
+    _line[_lineLen++] = c;
+  }
+  return false;
+}
+
+void AsyncHttp::parseLine()
+{
+  uint8_t i;
+  switch (_rxState)
+  {
+  case RX_STATUS:     // HTTP/1.1 200 OK
+    if(!strncmp(_line, "HTTP/1.", 7) && (_lineLen > 11))
+    {
+      _result = atoi(&_line[9]);
+      _keepAlive = (_line[7] == '1');
+      _rxState = RX_HEADER;
+    }
+    break;
+
+  case RX_HEADER:
+    if(_lineLen == 0)       // end of header
+    {
+      if((_result < 200) || (_result == 204) || (_result == 304) || ((_rxLeft == 0) && !_chunked))
+      {
+        _rxState = RX_DONE;
+      }
+      else
+      {
+        _rxState = _chunked ? RX_CHUNK_SIZE : RX_BODY;
+      }
+      break;
+    }
+    for (i=0;i<_lineLen;i++)
+    {
+      _line[i] = tolower(_line[i]);
+    }
+    if(!strncmp(_line, "content-length:", 15))
+    {
+      _rxLeft = atol(&_line[15]);
+    }
+    else if(!strncmp(_line, "transfer-encoding:", 18) && strstr(_line, "chunked"))
+    {
+      _chunked = true;
+    }
+    else if(!strncmp(_line, "connection:", 11))
+    {
+      _keepAlive = (strstr(_line, "close") == nullptr);
+    }
+    break;
+
+  case RX_CHUNK_SIZE:
+    _rxLeft = strtol(_line, nullptr, 16);
+    _rxState = (_rxLeft == 0) ? RX_TRAILER : RX_CHUNK_DATA;
+    break;
+
+  case RX_CHUNK_END:      // empty line after chunk data
+    _rxState = RX_CHUNK_SIZE;
+    break;
+
+  case RX_TRAILER:
+    if(_lineLen == 0)
+    {
+      _rxState = RX_DONE;
+    }
+    break;
+
+  default:
+    break;
+  }
+  _lineLen = 0;
+}
+
+void AsyncHttp::finish(int result)
+{
+  _result = result;
+  _state = DONE;
+  _lastActivity = millis();
+  _lastLatency = _lastActivity - _startTime;
+  _latencySum += _lastLatency;
+  _latencyCount++;
+}
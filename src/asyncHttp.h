@@ -0,0 +1,97 @@
+#ifndef ASYNC_HTTP_H
+#define ASYNC_HTTP_H
+//
+// 2026-10-18 mh
+// - first version
+// - connect by cached IP (DnsCache)
+// - optional extra header line, e.g. Authorization
+// - request header precomputed in fixed buffer, body passed by pointer
+// - optional Content-Encoding per request
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPAsyncTCP.h>
+#include "config.h"
+#include "dnsCache.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+// error codes, negative values like in HTTPClient
+#define ASYNC_HTTP_ERROR_CONNECTION_FAILED  (-1)
+#define ASYNC_HTTP_ERROR_SEND_HEADER_FAILED (-2)     // post() refused: no valid request header
+#define ASYNC_HTTP_ERROR_CONNECTION_LOST    (-5)
+#define ASYNC_HTTP_ERROR_READ_TIMEOUT       (-11)
+
+class AsyncHttp
+{
+public:
+    AsyncHttp();
+    void setServer(const String& server, const String& path, const char* contentType, const char* extraHeader = nullptr);
+    bool post(const char* body, size_t len, const char* contentEncoding = nullptr);
+    bool isBusy();
+    bool hasResult();
+    int takeResult();
+    void doLoop();
+    void close();
+
+    uint32_t getRequestCount();
+    uint32_t getConnectCount();
+    uint32_t getReconnectCount();
+    uint32_t getLastLatency();
+    uint32_t getAvgLatency();
+    uint32_t getBytesSent();
+    DnsCache& getDns();
+
+private:
+    enum State {IDLE, RESOLVING, CONNECTING, SENDING, RECEIVING, DONE};
+    enum RxState {RX_STATUS, RX_HEADER, RX_BODY, RX_CHUNK_SIZE, RX_CHUNK_DATA, RX_CHUNK_END, RX_TRAILER, RX_DONE};
+
+    AsyncClient _client;
+    DnsCache _dns;
+    String _host = "";
+    uint16_t _port = 80;
+    String _path = "/";
+
+    volatile State _state = IDLE;
+    bool _connected = false;        // tcp connection is open (may be idle keep-alive)
+    bool _reused = false;           // current request uses a kept connection
+    bool _retryPending = false;     // request failed on a reused connection, repeat on a new one
+    char _header[VZ_HTTP_HEADER_SIZE];  // request header up to "Content-Length: "
+    size_t _headerLen = 0;
+    char _lengthLine[48];           // content length, optional content encoding and end of header
+    size_t _lengthLineLen = 0;
+    const char* _body = nullptr;    // owned by the user, valid until result is taken
+    size_t _bodyLen = 0;
+    size_t _txPos = 0;              // bytes of request passed to tcp
+    int _result = 0;
+
+    RxState _rxState = RX_STATUS;
+    char _line[48];                 // current status/header/chunk line, truncated
+    uint8_t _lineLen = 0;
+    int32_t _rxLeft = -1;           // bytes of body or chunk left, -1 until close
+    bool _rxAny = false;            // response data received
+    bool _chunked = false;          // transfer encoding chunked
+    bool _keepAlive = true;         // server keeps connection open
+
+    uint32_t _startTime = 0;        // ms, start of request
+    uint32_t _lastActivity = 0;     // ms, end of last request
+    uint32_t _requestCount = 0;
+    uint32_t _connectCount = 0;
+    uint32_t _reconnectCount = 0;
+    uint32_t _lastLatency = 0;
+    uint32_t _latencySum = 0;
+    uint32_t _latencyCount = 0;
+    uint32_t _bytesSent = 0;
+
+    void connect();
+    void sendData();
+    size_t txSegment(size_t pos, const char*& data);
+    void onData(const char* data, size_t len);
+    bool rxLine(char c);
+    void parseLine();
+    void finish(int result);
+};
+#endif // ASYNC_HTTP_H
@@ -0,0 +1,101 @@
+// batchControl.cpp
+//
+// adaptive batching of the Volkszaehler transfer: batch size and flush interval follow the back-pressure of the server
+//
+// 2026-10-18 mh
+// - first version, adaptive batching taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+A slow or failing server gets fewer, larger requests: VzHttp holds the tuples back until the batch target or the
+flush interval is reached. When the server is fast again, every batch is sent at once.
+
+** Usage **
+control.setLimits(32, 600000);        bounds from the config page: max tuples per request, max hold time in ms
+control.update(latency, failed);      after each request
+control.getBatchTarget() ...          used by VzHttp::flushBatch()
+
+** Implementation **
+After each request the moving averages (weight 1/8) of latency and error rate are updated, the first request sets
+them. If the server is slow (VZ_SLOW_LATENCY, VZ_SLOW_ERROR_RATE), batch target and flush interval are doubled up to
+the bounds; the flush interval starts with INVERTER_READ_INTERVAL_FREQUENT. When latency and error rate are below
+VZ_FAST_LATENCY and VZ_FAST_ERROR_RATE, both are halved step by step down to VZ_BATCH_MIN (or the max batch, if
+smaller) and 0. Between the thresholds nothing changes, so the values do not toggle.
+The time is passed by the caller, so the class runs in the native unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "batchControl.h"
+
+void BatchControl::setLimits(uint16_t maxBatch, uint32_t maxFlushInterval)
+//
+// bounds of adaptive batching: max tuples per request, max time (ms) a batch is held back
+{
+  _maxBatch = constrain(maxBatch, 1, VZ_BATCH_SIZE);
+  _maxFlushInterval = maxFlushInterval;
+  _batchTarget = min(_batchTarget, _maxBatch);
+  _flushInterval = min(_flushInterval, _maxFlushInterval);
+}
+
+void BatchControl::update(uint32_t latency, bool failed)
+//
+// update moving averages of latency and error rate (weight 1/8),
+// widen batch target and flush interval by factor 2 if the server is slow, shrink them by 2 if it is fast again
+{
+  uint16_t error = failed ? 1000 : 0;
+  if(!_started)
+  {
+    _latencyAvg = latency;
+    _errorRate = error;
+    _started = true;
+  }
+  else
+  {
+    _latencyAvg = (_latencyAvg * 7 + latency) / 8;
+    _errorRate = (_errorRate * 7 + error) / 8;
+  }
+
+  if((_latencyAvg > VZ_SLOW_LATENCY) || (_errorRate > VZ_SLOW_ERROR_RATE))
+  {
+    _batchTarget = min((uint16_t)(_batchTarget * 2), _maxBatch);
+    _flushInterval = (_flushInterval == 0) ? INVERTER_READ_INTERVAL_FREQUENT * 1000UL : _flushInterval * 2;
+    _flushInterval = min(_flushInterval, _maxFlushInterval);
+  }
+  else if((_latencyAvg < VZ_FAST_LATENCY) && (_errorRate < VZ_FAST_ERROR_RATE))
+  {
+    _batchTarget = max((uint16_t)(_batchTarget / 2), min((uint16_t)VZ_BATCH_MIN, _maxBatch));
+    _flushInterval /= 2;
+    if(_flushInterval < INVERTER_READ_INTERVAL_FREQUENT * 1000UL)
+    {
+      _flushInterval = 0;
+    }
+  }
+}
+
+uint16_t BatchControl::getMaxBatch()
+{
+  return _maxBatch;
+}
+
+uint16_t BatchControl::getBatchTarget()
+{
+  return _batchTarget;
+}
+
+uint32_t BatchControl::getFlushInterval()
+{
+  return _flushInterval;
+}
+
+uint32_t BatchControl::getLatencyAvg()
+{
+  return _latencyAvg;
+}
+
+uint16_t BatchControl::getErrorRate()
+{
+  return _errorRate;
+}
@@ -0,0 +1,34 @@
+#ifndef BATCH_CONTROL_H
+#define BATCH_CONTROL_H
+//
+// 2026-10-18 mh
+// - first version, adaptive batching taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+
+// batch target and flush interval of VzHttp, following latency and error rate of the server within bounds
+class BatchControl
+{
+public:
+    void setLimits(uint16_t maxBatch, uint32_t maxFlushInterval);
+    void update(uint32_t latency, bool failed);
+    uint16_t getMaxBatch();
+    uint16_t getBatchTarget();
+    uint32_t getFlushInterval();
+    uint32_t getLatencyAvg();
+    uint16_t getErrorRate();
+
+private:
+    uint16_t _maxBatch = VZ_BATCH_SIZE;     // bounds
+    uint32_t _maxFlushInterval = 0;         // ms
+    uint16_t _batchTarget = VZ_BATCH_MIN;   // a held batch is passed to transfer when it has this many tuples
+    uint32_t _flushInterval = 0;    // ms, a batch is held back up to this time, 0: not held back
+    uint32_t _latencyAvg = 0;       // ms, moving average of request latency
+    uint16_t _errorRate = 0;        // per mille, moving average of failed requests
+    bool _started = false;          // moving averages are initialized
+};
+#endif // BATCH_CONTROL_H
@@ -0,0 +1,108 @@
+// channelStats.cpp
+//
+// outcome of the Volkszaehler requests per channel: attempts, 2xx, 4xx, 5xx, transport errors, latency, last success
+//
+// 2026-10-18 mh
+// - first version, counters per channel taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Counts the result of each request of VzHttp for the channels of the registry, so a failing channel (e.g. a wrong UUID
+answered with 4xx) can be told from a failing server.
+
+** Usage **
+ChannelStats stats;
+stats.count(tuples, n, httpResponseCode, latency, time(nullptr));   after each request with the tuples in its body
+stats.get(channel)                    counters of a channel, see VzChannelStats
+stats.getFailingMask(sendMask)        channels to be sent, whose last request was not answered with 2xx
+stats.reset(channel)                  channel changed on the config page
+
+** Implementation **
+count() first builds the mask of the channels in the request, so a batch with several tuples of a channel counts once
+for it. A negative code is a transport error (no response). The class has no dependency on the http client, the
+time is passed by the caller, so it runs in the native unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "channelStats.h"
+
+ChannelStats::ChannelStats()
+{
+  memset(_stats, 0, sizeof(_stats));
+}
+
+void ChannelStats::reset(uint8_t channel)
+{
+  if(channel < VZ_MAX_CHANNELS)
+  {
+    memset(&_stats[channel], 0, sizeof(_stats[channel]));
+  }
+}
+
+void ChannelStats::count(const VzTuple* tuples, uint16_t n, int httpResponseCode, uint32_t latency, uint32_t now)
+//
+// count the result of a request once for each channel with tuples in it
+{
+  uint16_t mask = 0;
+  uint16_t i;
+  for (i=0;i<n;i++)
+  {
+    if(tuples[i].channel < VZ_MAX_CHANNELS)
+    {
+      mask |= (1 << tuples[i].channel);
+    }
+  }
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
+  {
+    if(!(mask & (1 << i)))
+    {
+      continue;
+    }
+    VzChannelStats& stats = _stats[i];
+    stats.attempts++;
+    stats.lastCode = httpResponseCode;
+    stats.lastLatency = min(latency, (uint32_t)UINT16_MAX);
+    if(httpResponseCode < 0)
+    {
+      stats.transportError++;
+    }
+    else if((httpResponseCode >= 200) && (httpResponseCode < 300))
+    {
+      stats.ok++;
+      stats.lastSuccess = now;
+    }
+    else if((httpResponseCode >= 400) && (httpResponseCode < 500))
+    {
+      stats.clientError++;
+    }
+    else if(httpResponseCode >= 500)
+    {
+      stats.serverError++;
+    }
+  }
+}
+
+const VzChannelStats& ChannelStats::get(uint8_t channel)
+{
+  return _stats[(channel < VZ_MAX_CHANNELS) ? channel : 0];
+}
+
+uint16_t ChannelStats::getFailingMask(uint16_t sendMask)
+//
+// channels of sendMask, whose last request was not answered with 2xx
+{
+  uint16_t mask = 0;
+  uint8_t i;
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
+  {
+    int16_t code = _stats[i].lastCode;
+    if((sendMask & (1 << i)) && (code != 0) && ((code < 200) || (code >= 300)))
+    {
+      mask |= (1 << i);
+    }
+  }
+  return mask;
+}
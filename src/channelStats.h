@@ -0,0 +1,39 @@
+#ifndef CHANNEL_STATS_H
+#define CHANNEL_STATS_H
+//
+// 2026-10-18 mh
+// - first version, counters per channel taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+#include "vzQueue.h"
+
+struct VzChannelStats     // outcome of the requests that carried tuples of a channel
+{
+  uint32_t attempts;
+  uint32_t ok;              // 2xx
+  uint32_t clientError;     // 4xx
+  uint32_t serverError;     // 5xx
+  uint32_t transportError;  // no response: connect failed, timeout, ...
+  uint32_t lastSuccess;     // UNIX epoch time in s of last 2xx, 0: never
+  uint16_t lastLatency;     // ms
+  int16_t  lastCode;        // http status of last request, negative: transport error, 0: none yet
+};
+
+// outcome of the requests per channel of the registry
+class ChannelStats
+{
+public:
+    ChannelStats();
+    void reset(uint8_t channel);
+    void count(const VzTuple* tuples, uint16_t n, int httpResponseCode, uint32_t latency, uint32_t now);
+    const VzChannelStats& get(uint8_t channel);
+    uint16_t getFailingMask(uint16_t sendMask);
+
+private:
+    VzChannelStats _stats[VZ_MAX_CHANNELS];
+};
+#endif // CHANNEL_STATS_H
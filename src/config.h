@@ -17,7 +17,7 @@
 // Identify configuration info in EEPROM, Modifying cause a loss of the existing configuration in EEPROM
 // note: EEPROM configuration remains unchanged after firmware update; update version count if you are using a new application/configuration
 // otherwise the previous configuration is considered valid.
-#define WIFI_AP_CONFIG_VERSION "3.2.1"   // 4 bytes are significant for check with EEPROM (IOTWEBCONF_CONFIG_VERSION_LENGTH in confWebSettings.h)
+#define WIFI_AP_CONFIG_VERSION "3.9.0"   // 4 bytes are significant for check with EEPROM (IOTWEBCONF_CONFIG_VERSION_LENGTH in confWebSettings.h)
 
 #define WIFI_AP_SSID "YourSolisLogger"
 #define WIFI_AP_IP "192.168.4.1"            // default address, set by the framework.
@@ -54,13 +54,93 @@
 #define VERBOSE_LEVEL_TIME 0
 
 #define DATE_UPDATE_INTERVAL 60000 // in ms; for Dash Board
+#define LOOP_STAT_INTERVAL   60000 // in ms; window for max loop time in /metrics
+#define DASH_UPDATE_INTERVAL 1000  // in ms; min time between two updates of the Dash Board (max frequency)
 
 // Volkszaehler
 #define VZ_SERVER             "yourVolkszaehlerServer_name_or_IP"
 #define VZ_MIDDLEWARE         "middleware.php"
 #define VZ_DATA_JSON          "data.json"
 #define VZ_UUID_NO_SEND       "null"        // use this uuid if you do not want to transmit data for a channel
-
+#define VZ_BATCH_SIZE         32            // max number of tuples sent with one http request, upper bound of VZ_MAX_BATCH
+#define VZ_HTTP_IDLE_TIMEOUT  65000         // ms; an unused keep-alive connection to the server is closed after this time
+#define VZ_HTTP_TIMEOUT       5000          // ms; max duration of a request
+#define VZ_REQUEST_QUEUE_SIZE 4             // number of batches waiting for asynchronous transfer
+#define VZ_TUPLE_POOL_SIZE    48            // tuples of all batches waiting for transfer, at least VZ_BATCH_SIZE; more: queued
+#define VZ_HTTP_HEADER_SIZE   320           // bytes; buffer for http request header (path, server name, extra header)
+#define VZ_BODY_SIZE          1728          // bytes; JSON body of a full batch: VZ_MAX_CHANNELS x 60 + VZ_BATCH_SIZE x 31 + 3, checked in vzHttp.cpp
+#define VZ_PUBLISH_WINDOW     "30"          // s; transfers are spread over this window after the start of an interval, 0: send at once
+#define VZ_PACE_INTERVAL      1000          // ms; min time between two requests to the server
+#define VZ_GZIP_REPLAY        "1"           // replay of queued tuples with Content-Encoding gzip, falls back to plain if rejected
+#define VZ_GZIP_SIZE          1024          // bytes; buffer for the compressed body, sent plain if it does not fit
+#define VZ_GZIP_RETRY         86400000      // ms; gzip is tried again after this time, if the server rejected it
+#define VZ_MAX_BATCH          "32"          // tuples; adaptive batching: upper bound of the batch size
+#define VZ_MAX_FLUSH_INTERVAL "600"         // s; adaptive batching: upper bound of the time a batch is held back
+#define VZ_BATCH_MIN          8             // tuples; adaptive batching: batch size of a fast server
+#define VZ_SLOW_LATENCY       2000          // ms; average latency above: server is slow, batches are widened
+#define VZ_FAST_LATENCY       500           // ms; average latency below: server is fast, batches are shrunk
+#define VZ_SLOW_ERROR_RATE    250           // per mille; average error rate above: batches are widened
+#define VZ_FAST_ERROR_RATE    50            // per mille; average error rate below: batches may be shrunk
+#define VZ_DNS_TTL            300000        // ms; the cached IP of the server is refreshed after this time
+#define VZ_DNS_RETRY          10000         // ms; min time between two lookups after a failed lookup
+#define VZ_DNS_TIMEOUT        10000         // ms; a lookup without answer is given up after this time
+
+// Volkszaehler store-and-forward queue on LittleFS for tuples that could not be sent
+#define VZ_QUEUE_DIR              "/vzq"
+#define VZ_QUEUE_SEGMENT_RECORDS  256       // tuples per segment file (12 bytes each)
+#define VZ_QUEUE_MAX_SEGMENTS     16        // max number of segment files, oldest is dropped if exceeded
+#define VZ_QUEUE_DRAIN_INTERVAL   2000      // ms between two requests sending queued tuples
+
+// MQTT publisher
+#define MQTT_SERVER               ""        // host[:port] of the broker, empty: MQTT not used
+#define MQTT_PORT                 1883
+#define MQTT_TOPIC                "solis"   // snapshots are published to <topic>/snapshot, connection state to <topic>/status
+#define MQTT_QOS                  "0"       // 0 or 1
+#define MQTT_KEEPALIVE            60        // s
+#define MQTT_RECONNECT_INTERVAL   10000     // ms between connection attempts
+#define MQTT_PACKET_SIZE          384       // bytes; buffer for one PUBLISH packet
+
+// InfluxDB publisher, line protocol
+#define INFLUX_SERVER             ""        // host[:port] of InfluxDB, empty: InfluxDB not used
+#define INFLUX_WRITE_PATH         "/write?db=solar&precision=s"   // v2: /api/v2/write?org=..&bucket=..&precision=s
+#define INFLUX_MEASUREMENT        "solis"
+#define INFLUX_FLUSH_INTERVAL     "300"     // s; polls are collected and written together after this time
+#define INFLUX_BODY_SIZE          1536      // bytes; buffer for the lines of one write, flushed earlier if full
+#define INFLUX_LINE_SIZE          192       // bytes; max length of one line
+
+// server-sent events of snapshots
+#define SSE_URL                   "/events"
+#define SSE_MAX_CLIENTS           4         // further subscribers are closed
+#define SSE_MAX_PENDING           4         // events are skipped, if the subscribers have more messages waiting on average
+#define SSE_PAYLOAD_SIZE          192       // bytes; JSON data of one event
+
+// history of the last 24 h in RAM, see history.cpp
+#define HISTORY_BLOCKS                32        // number of blocks in the ring
+#define HISTORY_BLOCK_SIZE            256       // bytes per block, about 40 samples
+#define HISTORY_CHECKPOINT_INTERVAL   3600      // s; history is written to LittleFS, 0: RAM only
+#define HISTORY_FILE                  "/history.bin"
+
+// charts on the Dash Board, see downsampler.cpp
+#define DOWNSAMPLE_MAX_BUCKETS        48        // max buckets of a downsampler
+#define CHART_TODAY_BUCKETS           48        // power of today: 30 min per bucket
+#define CHART_DAYS                    30        // energy of the last days
+
+// JSON API /api/..., see sendApiJson() in main.cpp
+#define API_JSON_SIZE                 512       // bytes; buffer of the response, allocated once
+
+// admission control of the web server, see admission.cpp
+#define ADMISSION_MAX_ACTIVE          4         // requests in progress; further requests get 503
+#define ADMISSION_HEAP_MIN            8000      // bytes; requests get 503 below this free heap
+#define ADMISSION_CLIENTS             8         // clients (IPs) with an own token bucket, the oldest one is replaced
+#define ADMISSION_RATE                4         // requests per s and client in the long run; further requests get 429
+#define ADMISSION_BURST               12        // requests of a client at once, e.g. on page load
+#define ADMISSION_RETRY_AFTER         "2"       // s; Retry-After of 503 and 429
+
+// channel registry, see vzChannel.cpp; source, UUID, interval and deadband of each channel on the config page
+#define VZ_MAX_CHANNELS               12        // number of channels (max 16)
+#define VZ_CHANNEL_REFRESH            900       // s; a channel with deadband is sent at least after this time
+#define VZ_INTERVAL_ENERGY_TODAY      "1200"    // s; default interval of channel energy today
+// default UUIDs of channel 1..10: 32 hex digits 8-4-4-4-12 or VZ_UUID_NO_SEND; a malformed default is not sent
 #define VZ_UUID_TEMP_CH6              "abcdefgh-1234-5678-90ab-cdfghijklmno"   // channel UUID for temperature sensor
 #define VZ_UUID_INV_POWER             "abcdefgh-1234-5678-90ab-cdfghijklmnp"   // 7
 #define VZ_UUID_INV_DC_U              "abcdefgh-1234-5678-90ab-cdfghijklmnq"   // 8
@@ -0,0 +1,73 @@
+// dashUpdater.cpp
+//
+// coalesced update of the ESP-DASH dash board
+//
+// 2026-10-18 mh
+// - setMinInterval() removed, the interval is set by DASH_UPDATE_INTERVAL at compile time
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+ESPDash::sendUpdates() serializes the changed cards to JSON and sends them by WebSocket to every client. Called after
+each card update, one poll cycle caused a dozen of these messages. DashUpdater collects the updates and sends them
+with one message per loop at most, and not more often than every DASH_UPDATE_INTERVAL ms.
+
+** Usage **
+DashUpdater dashUpdater(dashboard);
+card_power.update(power);
+dashUpdater.markDirty();        instead of dashboard.sendUpdates()
+dashUpdater.doLoop();           once at the end of loop()
+dashUpdater.flush();            send at once, e.g. before a reset
+
+** Implementation **
+Card::update() of ESP-DASH marks a card as changed if its value differs, sendUpdates() sends only the changed cards.
+So DashUpdater only needs one dirty flag for the whole dash board: markDirty() sets it, doLoop() calls sendUpdates()
+if it is set and the min interval since the last flush has passed. Updates within the interval are sent together
+with the next flush, nothing is lost. getMarkCount() / getFlushCount() show how many messages were saved.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "dashUpdater.h"
+
+DashUpdater::DashUpdater(ESPDash& dashboard, uint32_t minInterval) : _dashboard(dashboard), _minInterval(minInterval)
+{
+}
+
+void DashUpdater::markDirty()
+//
+// a card was updated, send it with the next flush
+{
+  _dirty = true;
+  _markCount++;
+}
+
+void DashUpdater::doLoop()
+//
+// flush if a card was updated and the min interval has passed
+{
+  if(_dirty && ((millis() - _lastFlushTime) >= _minInterval))
+  {
+    flush();
+  }
+}
+
+void DashUpdater::flush()
+{
+  _dirty = false;
+  _lastFlushTime = millis();
+  _flushCount++;
+  _dashboard.sendUpdates();
+}
+
+uint32_t DashUpdater::getMarkCount()
+{
+  return _markCount;
+}
+
+uint32_t DashUpdater::getFlushCount()
+{
+  return _flushCount;
+}
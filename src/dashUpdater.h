@@ -0,0 +1,34 @@
+#ifndef DASH_UPDATER_H
+#define DASH_UPDATER_H
+//
+// 2026-10-18 mh
+// - setMinInterval() removed, the interval is set by DASH_UPDATE_INTERVAL at compile time
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPDash.h>
+#include "config.h"
+
+// coalesces the updates of the dash board cards into one flush per loop, rate limited
+class DashUpdater
+{
+public:
+    DashUpdater(ESPDash& dashboard, uint32_t minInterval = DASH_UPDATE_INTERVAL);
+    void markDirty();
+    void doLoop();
+    void flush();
+    uint32_t getMarkCount();
+    uint32_t getFlushCount();
+
+private:
+    ESPDash& _dashboard;
+    uint32_t _minInterval;          // ms, min time between two flushes
+    bool _dirty = false;            // a card was updated since the last flush
+    uint32_t _lastFlushTime = 0;    // ms
+    uint32_t _markCount = 0;        // calls of markDirty()
+    uint32_t _flushCount = 0;       // calls of ESPDash::sendUpdates()
+};
+#endif // DASH_UPDATER_H
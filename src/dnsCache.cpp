@@ -0,0 +1,200 @@
+// dnsCache.cpp
+//
+// cached, TTL-refreshed host name resolution for the Volkszaehler server
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Resolves the host name of a server once and keeps the IP address, so a connection does not need a DNS lookup.
+
+** Usage **
+dnsCache.setHost("volks-raspi");
+if(dnsCache.getIP(ip))         returns the cached IP, starts a refresh in the background if it is expired
+  client.connect(ip, port);    the original host name is still sent in the Host header
+dnsCache.invalidate();         connect to the cached IP failed, refresh
+dnsCache.doLoop();             call in loop(), starts pending lookups
+
+** Implementation **
+The lookup is done with dns_gethostbyname() of lwIP, which answers from its own cache or calls dnsFound() later
+from the tcp/ip stack, so loop() is never blocked.
+An IP is used for VZ_DNS_TTL ms; then it is refreshed asynchronously while the old (stale) IP is still returned.
+If the lookup fails (DNS server down), the stale IP is kept and the lookup is repeated after VZ_DNS_RETRY ms.
+If the host is given as IP address, no lookup is done at all.
+The number of lookups, failed lookups and the duration of the last lookup are available for diagnostics.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "config.h"
+#include "dnsCache.h"
+
+DnsCache::DnsCache()
+{
+}
+
+void DnsCache::setHost(const String& host)
+{
+  if(host == _host)
+  {
+    return;
+  }
+  _host = host;
+  _literal = _ip.fromString(host.c_str());
+  _valid = _literal;
+  _expired = !_literal;
+  _lastFailed = false;
+}
+
+bool DnsCache::getIP(IPAddress& ip)
+//
+// return the cached IP, even if it is stale; false if the host was never resolved
+{
+  if(!_literal && !_busy && (millis() - _resolvedAt) > VZ_DNS_TTL)
+  {
+    _expired = true;
+  }
+  if(_expired && !_busy)
+  {
+    startLookup();
+  }
+  if(_valid)
+  {
+    ip = _ip;
+  }
+  return _valid;
+}
+
+bool DnsCache::hasIP()
+{
+  return _valid;
+}
+
+bool DnsCache::isBusy()
+{
+  return _busy;
+}
+
+void DnsCache::refresh()
+//
+// start a lookup now, unless one is running
+{
+  if(!_literal && !_busy)
+  {
+    _expired = true;
+    startLookup();
+  }
+}
+
+void DnsCache::invalidate()
+//
+// connect to the cached IP failed: the IP may have changed, refresh with the next doLoop()
+{
+  if(!_literal)
+  {
+    _expired = true;
+  }
+}
+
+void DnsCache::doLoop()
+{
+  uint32_t now = millis();
+  if(_busy && ((now - _lookupStart) > VZ_DNS_TIMEOUT))
+  {
+    found(false, 0);        // no answer, a late answer is still accepted
+  }
+  if(_expired && !_busy && _valid)
+  {
+    startLookup();
+  }
+}
+
+String DnsCache::getIPString()
+{
+  if(!_valid)
+  {
+    return String("unknown");
+  }
+  return _ip.toString();
+}
+
+uint32_t DnsCache::getLookupCount()
+{
+  return _lookupCount;
+}
+
+uint32_t DnsCache::getFailCount()
+{
+  return _failCount;
+}
+
+uint32_t DnsCache::getLastLookupTime()
+{
+  return _lastLookupTime;
+}
+
+void DnsCache::startLookup()
+{
+  uint32_t now = millis();
+  if((_host.length() == 0) || (_lastFailed && ((now - _lookupStart) < VZ_DNS_RETRY)))
+  {
+    return;
+  }
+  _busy = true;
+  _lookupStart = now;
+  _lookupCount++;
+
+  ip_addr_t addr;
+  err_t err = dns_gethostbyname(_host.c_str(), &addr, &DnsCache::dnsFound, this);
+  if(err == ERR_OK)
+  {
+    found(true, ip_addr_get_ip4_u32(&addr));    // answered from lwIP cache
+  }
+  else if(err != ERR_INPROGRESS)
+  {
+    found(false, 0);
+  }
+}
+
+void DnsCache::dnsFound(const char* name, const ip_addr_t* ipaddr, void* arg)
+//
+// called by lwIP when the lookup is finished, ipaddr is NULL if the host was not found
+{
+  DnsCache* self = (DnsCache*)arg;
+  if(ipaddr != nullptr)
+  {
+    self->found(true, ip_addr_get_ip4_u32(ipaddr));
+  }
+  else
+  {
+    self->found(false, 0);
+  }
+}
+
+void DnsCache::found(bool ok, uint32_t ip)
+{
+  uint32_t now = millis();
+  if(_busy)
+  {
+    _lastLookupTime = now - _lookupStart;
+  }
+  _busy = false;
+  if(ok)
+  {
+    _ip = IPAddress(ip);
+    _valid = true;
+    _expired = false;
+    _lastFailed = false;
+    _resolvedAt = now;
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"dnsCache: %s = %s in %u ms",_host.c_str(),_ip.toString().c_str(),_lastLookupTime);
+  }
+  else
+  {
+    _failCount++;
+    _lastFailed = true;     // keep stale IP, retry after VZ_DNS_RETRY
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"dnsCache: lookup of %s failed, %s",_host.c_str(),_valid ? "using stale IP" : "no IP");
+  }
+}
@@ -0,0 +1,54 @@
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <lwip/dns.h>
+#include "config.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+class DnsCache
+{
+public:
+    DnsCache();
+    void setHost(const String& host);
+    bool getIP(IPAddress& ip);
+    bool hasIP();
+    bool isBusy();
+    void refresh();
+    void invalidate();
+    void doLoop();
+
+    String getIPString();
+    uint32_t getLookupCount();
+    uint32_t getFailCount();
+    uint32_t getLastLookupTime();
+
+private:
+    String _host = "";
+    IPAddress _ip;
+    bool _valid = false;            // _ip was resolved at least once (may be stale)
+    bool _literal = false;          // host is an IP address, no lookup needed
+    bool _expired = true;           // _ip has to be refreshed
+    volatile bool _busy = false;    // lookup in progress
+    uint32_t _resolvedAt = 0;       // ms, time of last successful lookup
+    uint32_t _lookupStart = 0;      // ms, start of current or last lookup
+    bool _lastFailed = false;
+
+    uint32_t _lookupCount = 0;
+    uint32_t _failCount = 0;
+    uint32_t _lastLookupTime = 0;   // ms, duration of last lookup
+
+    void startLookup();
+    void found(bool ok, uint32_t ip);
+    static void dnsFound(const char* name, const ip_addr_t* ipaddr, void* arg);
+};
+#endif // DNS_CACHE_H
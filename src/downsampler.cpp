@@ -0,0 +1,130 @@
+// downsampler.cpp
+//
+// min/max/avg of samples per time bucket for charts of a fixed size
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Reduces a series of samples to a fixed number of buckets, so a chart has always the same number of points,
+whatever the number of samples or the time span is.
+
+** Usage **
+Downsampler today(48, 1800);          48 buckets of 30 min
+today.reset(startOfDay);              first bucket starts at this time (rounded down to the bucket width)
+int16_t i = today.add(timeStamp, power);    index of the updated bucket, -1 if timeStamp is before the window
+today.getAvgValues(values);           average of each bucket, 0 for an empty bucket
+
+** Implementation **
+Each bucket keeps min, max, sum and count, so avg, min and max are available without storing the samples.
+A sample after the last bucket moves the window: the buckets are shifted to the front by the number of widths the
+sample is beyond the window and the new buckets are cleared, so the newest sample is in the last bucket
+(rolling window, e.g. last 30 days). For a window per calendar day call reset() at the start of a new day.
+At most DOWNSAMPLE_MAX_BUCKETS buckets; memory is fixed, no heap.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "downsampler.h"
+
+Downsampler::Downsampler(uint16_t buckets, uint32_t width)
+{
+  _n = constrain(buckets, 1, DOWNSAMPLE_MAX_BUCKETS);
+  _width = (width > 0) ? width : 1;
+  reset(0);
+}
+
+void Downsampler::reset(uint32_t start)
+//
+// clear all buckets, bucket 0 starts at start rounded down to the bucket width
+{
+  memset(_bucket, 0, sizeof(_bucket));
+  _start = start - (start % _width);
+}
+
+int16_t Downsampler::add(uint32_t timeStamp, float value)
+//
+// add sample to its bucket, shift the window if needed; return index of the bucket, -1 if too old
+{
+  if(timeStamp < _start)
+  {
+    return -1;
+  }
+  uint32_t index = (timeStamp - _start) / _width;
+  if(index >= _n)
+  {
+    uint32_t shift = index - _n + 1;
+    if(shift >= _n)
+    {
+      memset(_bucket, 0, sizeof(_bucket));
+    }
+    else
+    {
+      memmove(&_bucket[0], &_bucket[shift], (_n - shift) * sizeof(DownsampleBucket));
+      memset(&_bucket[_n - shift], 0, shift * sizeof(DownsampleBucket));
+    }
+    _start += shift * _width;
+    index = _n - 1;
+  }
+  DownsampleBucket& b = _bucket[index];
+  if(b.count == 0)
+  {
+    b.min = value;
+    b.max = value;
+    b.sum = 0;
+  }
+  b.min = min(b.min, value);
+  b.max = max(b.max, value);
+  b.sum += value;
+  b.count++;
+  return index;
+}
+
+uint16_t Downsampler::getBuckets()
+{
+  return _n;
+}
+
+uint32_t Downsampler::getStart()
+{
+  return _start;
+}
+
+uint32_t Downsampler::getBucketStart(uint16_t i)
+{
+  return _start + i * _width;
+}
+
+const DownsampleBucket& Downsampler::getBucket(uint16_t i)
+{
+  return _bucket[(i < _n) ? i : 0];
+}
+
+float Downsampler::getAvg(uint16_t i)
+{
+  const DownsampleBucket& b = getBucket(i);
+  return (b.count > 0) ? b.sum / b.count : 0;
+}
+
+void Downsampler::getAvgValues(float* values)
+//
+// average of all buckets into values[getBuckets()]
+{
+  uint16_t i;
+  for (i=0;i<_n;i++)
+  {
+    values[i] = getAvg(i);
+  }
+}
+
+void Downsampler::getMaxValues(float* values)
+{
+  uint16_t i;
+  for (i=0;i<_n;i++)
+  {
+    values[i] = (_bucket[i].count > 0) ? _bucket[i].max : 0;
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef DOWNSAMPLER_H
+#define DOWNSAMPLER_H
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+
+struct DownsampleBucket   // aggregate of the samples within the time of a bucket
+{
+  float    min;
+  float    max;
+  float    sum;
+  uint16_t count;                 // 0: bucket is empty
+};
+
+// fixed number of buckets of equal width, e.g. 48 x 30 min for a day or 30 x 1 day for a month
+class Downsampler
+{
+public:
+    Downsampler(uint16_t buckets, uint32_t width);
+    void reset(uint32_t start);
+    int16_t add(uint32_t timeStamp, float value);
+    uint16_t getBuckets();
+    uint32_t getStart();
+    uint32_t getBucketStart(uint16_t i);
+    const DownsampleBucket& getBucket(uint16_t i);
+    float getAvg(uint16_t i);
+    void getAvgValues(float* values);
+    void getMaxValues(float* values);
+
+private:
+    DownsampleBucket _bucket[DOWNSAMPLE_MAX_BUCKETS];
+    uint16_t _n;                    // buckets used
+    uint32_t _width;                // s per bucket
+    uint32_t _start;                // time of bucket 0, multiple of width
+};
+#endif // DOWNSAMPLER_H
@@ -0,0 +1,95 @@
+// etag.cpp
+//
+// ETag of a page from the values shown on it, comparison with If-None-Match
+//
+// 2026-10-18 mh
+// - first version, ETag functions taken out of httpCache.cpp
+// - etagMatch() compares each entry of the list instead of searching a substring
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+The ETag of a page is a hash of the values shown and the firmware build, see httpCache.cpp.
+
+** Usage **
+char etag[ETAG_SIZE];
+uint32_t hash = etagSeed();
+hash = etagHash(hash, currentIP.c_str());     for each value shown on the page
+etagFormat(hash, etag);                       "0123abcd"
+if(etagMatch(ifNoneMatch, etag)) ...          browser has this version of the page
+
+** Implementation **
+FNV-1a 32 bit; the seed is the hash of the build time, so a new firmware changes all ETags.
+If-None-Match is "*" or a comma separated list of ETags, each may have the prefix W/ (weak). The comparison of
+If-None-Match is weak (RFC 9110), so W/"x" matches "x". The functions have no web server dependency and run in
+the native unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "etag.h"
+
+#define FNV_OFFSET 2166136261UL
+#define FNV_PRIME  16777619UL
+
+uint32_t etagHash(uint32_t hash, const char* text)
+{
+  while (*text != '\0')
+  {
+    hash ^= (uint8_t)*text++;
+    hash *= FNV_PRIME;
+  }
+  hash ^= 0xFF;         // separator, so "ab","c" differs from "a","bc"
+  hash *= FNV_PRIME;
+  return hash;
+}
+
+uint32_t etagSeed()
+{
+  return etagHash(FNV_OFFSET, __DATE__ " " __TIME__);
+}
+
+void etagFormat(uint32_t hash, char* etag)
+{
+  snprintf(etag, ETAG_SIZE, "\"%08x\"", (unsigned int)hash);
+}
+
+bool etagMatch(const char* ifNoneMatch, const char* etag)
+//
+// true if the header value If-None-Match is "*" or lists etag
+{
+  size_t length = strlen(etag);
+  const char* entry = ifNoneMatch;
+  while (*entry != '\0')
+  {
+    while ((*entry == ' ') || (*entry == '\t') || (*entry == ','))
+    {
+      entry++;
+    }
+    const char* end = entry;
+    while ((*end != '\0') && (*end != ','))
+    {
+      end++;
+    }
+    const char* last = end;
+    while ((last > entry) && ((last[-1] == ' ') || (last[-1] == '\t')))
+    {
+      last--;
+    }
+    if(((last - entry) == 1) && (*entry == '*'))
+    {
+      return true;
+    }
+    if(((last - entry) > 2) && (strncmp(entry, "W/", 2) == 0))
+    {
+      entry += 2;
+    }
+    if(((size_t)(last - entry) == length) && (strncmp(entry, etag, length) == 0))
+    {
+      return true;
+    }
+    entry = end;
+  }
+  return false;
+}
@@ -0,0 +1,18 @@
+#ifndef ETAG_H
+#define ETAG_H
+//
+// 2026-10-18 mh
+// - first version, ETag functions taken out of httpCache.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+
+#define ETAG_SIZE 11                // "xxxxxxxx" with quotes and terminating 0
+
+uint32_t etagHash(uint32_t hash, const char* text);
+uint32_t etagSeed();
+void etagFormat(uint32_t hash, char* etag);
+bool etagMatch(const char* ifNoneMatch, const char* etag);
+#endif // ETAG_H
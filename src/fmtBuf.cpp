@@ -0,0 +1,184 @@
+// fmtBuf.cpp
+//
+// append text and numbers to a fixed char buffer without heap allocation
+//
+// 2026-10-18 mh
+// - addUuid()
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Replacement of String concatenation for messages which are built frequently (http body of VzHttp).
+A String grows by malloc/realloc with every +=, which fragments the small heap of the ESP8266 over time.
+FmtBuf writes into a buffer given by the user, usually a member or static array, and is always 0-terminated.
+
+** Usage **
+char body[64];
+FmtBuf buf(body, sizeof(body));
+buf.add("[").addUint(timeStamp).add("000,").addFixed(value, 2).add("]");
+if(buf.overflow())              text did not fit and is truncated
+  ...
+
+** Implementation **
+Numbers are converted with integer arithmetic. addFixed() rounds to the given number of decimals and prints like
+String(float, decimals) of Arduino, including "nan", "inf" and "ovf" for values which do not fit into 32 bit.
+addUuid() formats a binary UUID (see vzUuid.cpp) directly into the buffer.
+  *** end description *** */
+
+#include <Arduino.h>
+#include <math.h>
+#include "fmtBuf.h"
+#include "vzUuid.h"
+
+FmtBuf::FmtBuf(char* buf, size_t size)
+{
+  _buf = buf;
+  _size = size;
+  clear();
+}
+
+void FmtBuf::clear()
+{
+  _len = 0;
+  _overflow = false;
+  if(_size > 0)
+  {
+    _buf[0] = '\0';
+  }
+}
+
+FmtBuf& FmtBuf::add(const char* s, size_t len)
+{
+  if((_len + len) >= _size)
+  {
+    _overflow = true;
+    len = (_size > (_len + 1)) ? (_size - _len - 1) : 0;
+  }
+  memcpy(&_buf[_len], s, len);
+  _len += len;
+  if(_size > 0)
+  {
+    _buf[_len] = '\0';
+  }
+  return *this;
+}
+
+FmtBuf& FmtBuf::add(const char* s)
+{
+  return add(s, strlen(s));
+}
+
+FmtBuf& FmtBuf::add(char c)
+{
+  return add(&c, 1);
+}
+
+FmtBuf& FmtBuf::addUint(uint32_t value)
+{
+  char digits[10];
+  uint8_t n = 0;
+  do
+  {
+    digits[n++] = '0' + (value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  char text[10];
+  uint8_t i;
+  for (i=0;i<n;i++)
+  {
+    text[i] = digits[n - 1 - i];
+  }
+  return add(text, n);
+}
+
+FmtBuf& FmtBuf::addInt(int32_t value)
+{
+  if(value < 0)
+  {
+    add('-');
+    return addUint((uint32_t)(-(int64_t)value));
+  }
+  return addUint((uint32_t)value);
+}
+
+FmtBuf& FmtBuf::addFixed(float value, uint8_t decimals)
+{
+  if(isnan(value))
+  {
+    return add("nan");
+  }
+  if(isinf(value))
+  {
+    return add("inf");
+  }
+  if((value > 4294967040.0) || (value < -4294967040.0))
+  {
+    return add("ovf");
+  }
+
+  if(decimals > 6)
+  {
+    decimals = 6;
+  }
+  uint32_t scale = 1;
+  uint8_t i;
+  for (i=0;i<decimals;i++)
+  {
+    scale *= 10;
+  }
+
+  double d = value;
+  if(d < 0)
+  {
+    d = -d;
+  }
+  uint64_t scaled = (uint64_t)(d * scale + 0.5);   // rounded
+  if((value < 0) && (scaled > 0))
+  {
+    add('-');
+  }
+  addUint((uint32_t)(scaled / scale));
+  if(decimals > 0)
+  {
+    char frac[6];
+    uint32_t f = scaled % scale;
+    for (i=decimals;i>0;i--)
+    {
+      frac[i - 1] = '0' + (f % 10);
+      f /= 10;
+    }
+    add('.');
+    add(frac, decimals);
+  }
+  return *this;
+}
+
+FmtBuf& FmtBuf::addUuid(const uint8_t* uuid)
+{
+  if((_len + VZ_UUID_TEXT_LEN) >= _size)
+  {
+    char text[VZ_UUID_TEXT_LEN + 1];
+    return add(text, uuidFormat(uuid, text));   // truncated
+  }
+  _len += uuidFormat(uuid, &_buf[_len]);
+  return *this;
+}
+
+const char* FmtBuf::c_str()
+{
+  return _buf;
+}
+
+size_t FmtBuf::length()
+{
+  return _len;
+}
+
+bool FmtBuf::overflow()
+{
+  return _overflow;
+}
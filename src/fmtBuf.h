@@ -0,0 +1,35 @@
+#ifndef FMT_BUF_H
+#define FMT_BUF_H
+//
+// 2026-10-18 mh
+// - addUuid()
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+
+class FmtBuf
+{
+public:
+    FmtBuf(char* buf, size_t size);
+    void clear();
+    FmtBuf& add(const char* s);
+    FmtBuf& add(const char* s, size_t len);
+    FmtBuf& add(char c);
+    FmtBuf& addUint(uint32_t value);
+    FmtBuf& addInt(int32_t value);
+    FmtBuf& addFixed(float value, uint8_t decimals);
+    FmtBuf& addUuid(const uint8_t* uuid);
+    const char* c_str();
+    size_t length();
+    bool overflow();
+
+private:
+    char* _buf;
+    size_t _size;
+    size_t _len = 0;
+    bool _overflow = false;
+};
+#endif // FMT_BUF_H
@@ -0,0 +1,240 @@
+// gzip.cpp
+//
+// small gzip (deflate) compressor for http request bodies
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Compresses a buffer in RAM into gzip format (RFC 1952 with a deflate stream of RFC 1951), e.g. for a request body
+with Content-Encoding: gzip. Used by VzHttp for the replay of queued tuples.
+
+** Usage **
+size_t n = gzipCompress(body, len, out, sizeof(out));   0: out too small, send body uncompressed
+
+** Implementation **
+One deflate block with the fixed Huffman codes, so no code tables have to be built or sent. Matches (LZ77, length 3
+to 258) are searched within the input by a hash table of GZIP_HASH_SIZE positions of 3-byte prefixes; only the
+last position of a hash is kept (no chains), which is enough for the repetitive JSON of the middleware
+(UUIDs, time stamps with the same leading digits). The window is the input itself, at most 32 kB, so besides the
+hash table (2 * GZIP_HASH_SIZE bytes, static) no memory is needed. CRC32 uses a 16-entry table.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "gzip.h"
+
+#define GZIP_HASH_BITS 9
+#define GZIP_HASH_SIZE (1 << GZIP_HASH_BITS)
+#define GZIP_MIN_MATCH 3
+#define GZIP_MAX_MATCH 258
+#define GZIP_MAX_DIST  32768
+
+static uint16_t _hashHead[GZIP_HASH_SIZE];   // last position + 1 of a 3-byte prefix, 0: none
+
+static const uint16_t _lengthBase[29] = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+static const uint8_t _lengthExtra[29] = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+static const uint16_t _distBase[30] = {1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,
+                                       4097,6145,8193,12289,16385,24577};
+static const uint8_t _distExtra[30] = {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+
+class BitWriter         // deflate bit order: first bit is the LSB of the first byte
+{
+public:
+  BitWriter(uint8_t* out, size_t size) : _out(out), _size(size) {}
+  void bits(uint32_t value, uint8_t n)
+  {
+    _acc |= value << _nAcc;
+    _nAcc += n;
+    while (_nAcc >= 8)
+    {
+      byte((uint8_t)_acc);
+      _acc >>= 8;
+      _nAcc -= 8;
+    }
+  }
+  void code(uint32_t code, uint8_t n)     // Huffman codes are sent MSB first
+  {
+    uint32_t reversed = 0;
+    uint8_t i;
+    for (i=0;i<n;i++)
+    {
+      reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    bits(reversed, n);
+  }
+  void flush()
+  {
+    if(_nAcc > 0)
+    {
+      byte((uint8_t)_acc);
+    }
+    _acc = 0;
+    _nAcc = 0;
+  }
+  void byte(uint8_t b)
+  {
+    if(_len < _size)
+    {
+      _out[_len] = b;
+    }
+    _len++;
+  }
+  size_t length() { return _len; }
+  bool overflow() { return _len > _size; }
+
+private:
+  uint8_t* _out;
+  size_t _size;
+  size_t _len = 0;
+  uint32_t _acc = 0;
+  uint8_t _nAcc = 0;
+};
+
+static void literal(BitWriter& w, uint16_t sym)
+//
+// fixed Huffman code of a literal/length symbol
+{
+  if(sym < 144)
+  {
+    w.code(0x30 + sym, 8);
+  }
+  else if(sym < 256)
+  {
+    w.code(0x190 + sym - 144, 9);
+  }
+  else if(sym < 280)
+  {
+    w.code(sym - 256, 7);
+  }
+  else
+  {
+    w.code(0xC0 + sym - 280, 8);
+  }
+}
+
+static void match(BitWriter& w, uint16_t len, uint16_t dist)
+{
+  uint8_t i = 28;
+  while (_lengthBase[i] > len)
+  {
+    i--;
+  }
+  literal(w, 257 + i);
+  w.bits(len - _lengthBase[i], _lengthExtra[i]);
+  i = 29;
+  while (_distBase[i] > dist)
+  {
+    i--;
+  }
+  w.code(i, 5);
+  w.bits(dist - _distBase[i], _distExtra[i]);
+}
+
+static uint16_t hash3(const uint8_t* p)
+{
+  return ((p[0] << 6) ^ (p[1] << 3) ^ p[2]) & (GZIP_HASH_SIZE - 1);
+}
+
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len)
+//
+// CRC-32 of gzip/zlib; start with crc = 0
+{
+  static const uint32_t table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+  crc = ~crc;
+  while (len--)
+  {
+    crc ^= *data++;
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+size_t gzipCompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outSize)
+//
+// compress in into gzip format, return length in out or 0 if out is too small or in is too long
+{
+  static const uint8_t header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0x03};   // deflate, no name, OS unix
+  if(inLen > GZIP_MAX_DIST)
+  {
+    return 0;
+  }
+  BitWriter w(out, outSize);
+  size_t i;
+  for (i=0;i<sizeof(header);i++)
+  {
+    w.byte(header[i]);
+  }
+
+  memset(_hashHead, 0, sizeof(_hashHead));
+  w.bits(1, 1);         // last block
+  w.bits(1, 2);         // fixed Huffman codes
+  size_t pos = 0;
+  while ((pos < inLen) && !w.overflow())
+  {
+    uint16_t bestLen = 0;
+    uint16_t bestDist = 0;
+    if((pos + GZIP_MIN_MATCH) <= inLen)
+    {
+      uint16_t h = hash3(&in[pos]);
+      size_t cand = _hashHead[h];
+      _hashHead[h] = pos + 1;
+      if(cand > 0)
+      {
+        cand--;
+        size_t maxLen = inLen - pos;
+        if(maxLen > GZIP_MAX_MATCH)
+        {
+          maxLen = GZIP_MAX_MATCH;
+        }
+        size_t n = 0;
+        while ((n < maxLen) && (in[cand + n] == in[pos + n]))
+        {
+          n++;
+        }
+        if(n >= GZIP_MIN_MATCH)
+        {
+          bestLen = n;
+          bestDist = pos - cand;
+        }
+      }
+    }
+    if(bestLen > 0)
+    {
+      match(w, bestLen, bestDist);
+      size_t end = pos + bestLen;
+      for (pos++;pos<end;pos++)       // positions within the match are entered, too
+      {
+        if((pos + GZIP_MIN_MATCH) <= inLen)
+        {
+          _hashHead[hash3(&in[pos])] = pos + 1;
+        }
+      }
+    }
+    else
+    {
+      literal(w, in[pos]);
+      pos++;
+    }
+  }
+  literal(w, 256);      // end of block
+  w.flush();
+
+  uint32_t crc = crc32Update(0, in, inLen);
+  for (i=0;i<4;i++)
+  {
+    w.byte(crc >> (8 * i));
+  }
+  for (i=0;i<4;i++)
+  {
+    w.byte(inLen >> (8 * i));
+  }
+  return w.overflow() ? 0 : w.length();
+}
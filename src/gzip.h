@@ -0,0 +1,14 @@
+#ifndef GZIP_H
+#define GZIP_H
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+
+size_t gzipCompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outSize);
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len);
+#endif // GZIP_H
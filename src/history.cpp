@@ -0,0 +1,373 @@
+// history.cpp
+//
+// history of the inverter values of the last 24 h in RAM, delta encoded
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Keeps power, DC voltage, DC current, inverter temperature and DS18B20 temperature of each poll with a resolution
+of 1 minute, so charts and exports can show more than the current values. About 24 h fit into HISTORY_BLOCKS blocks
+of HISTORY_BLOCK_SIZE bytes (8 kB); the oldest block is overwritten when the ring is full.
+
+** Usage **
+history.begin();                      restore the last checkpoint from LittleFS (call after LittleFS is mounted)
+history.add(snapshot);                once per poll, a second sample within the same minute is ignored
+history.doLoop();                     writes a checkpoint every HISTORY_CHECKPOINT_INTERVAL s
+history.query(from, to, [](const HistorySample& sample) { ... });    samples from <= timeStamp <= to (UNIX time in s)
+
+HistoryCursor cursor;                 read step by step, e.g. for a chunked response
+history.seek(cursor, from);
+while(history.next(cursor, sample) && (sample.timeStamp <= to)) ...
+
+** Implementation **
+Values are stored as integers with fixed scaling (W, 0.1 V, 0.01 A, 0.1 °C). A sample is encoded as
+- the difference to the previous sample in minutes (1 for consecutive polls, more after a night or an outage),
+- the difference of each value to the previous sample, zig-zag encoded (sign in bit 0) as varint (7 bits per byte).
+The first sample of a block is encoded against 0, so each block can be decoded on its own. Slowly changing values
+need 1 byte, the power 1-2 bytes; a sample takes about 6 bytes instead of 24 bytes as floats.
+A sample which does not fit into the newest block starts a new one. Blocks are numbered by seq and stored at
+_blocks[seq % HISTORY_BLOCKS], so a cursor holding a seq detects that its block was overwritten and continues with
+the oldest block. No heap is used; a query decodes block by block and calls the function for each sample.
+If HISTORY_CHECKPOINT_INTERVAL is not 0, the blocks are written to HISTORY_FILE, so the history survives a reboot
+(the gap is kept, as timestamps are absolute). The file is only read back if size and format version match.
+  *** end description *** */
+
+#include <Arduino.h>
+#include <math.h>
+#include <LittleFS.h>
+#include "history.h"
+
+#define HISTORY_MAGIC 0x48495301        // "HIS" and format version 1
+
+static const float _scale[N_HISTORY_SERIES] = {1, 10, 100, 10, 10};
+
+struct HistoryFileHeader
+{
+  uint32_t magic;
+  uint16_t blockSize;
+  uint16_t blocks;
+  uint32_t firstSeq;
+  uint32_t lastSeq;
+  uint32_t lastMinute;
+  int32_t  last[N_HISTORY_SERIES];
+};
+
+static uint8_t putVarint(uint8_t* buf, uint32_t value)
+{
+  uint8_t n = 0;
+  while (value >= 0x80)
+  {
+    buf[n++] = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  buf[n++] = value;
+  return n;
+}
+
+static uint32_t getVarint(const uint8_t* buf, uint16_t& pos)
+{
+  uint32_t value = 0;
+  uint8_t shift = 0;
+  uint8_t b;
+  do
+  {
+    b = buf[pos++];
+    value |= (uint32_t)(b & 0x7F) << shift;
+    shift += 7;
+  } while ((b & 0x80) && (shift < 35));
+  return value;
+}
+
+static uint32_t zigzag(int32_t value)
+{
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value)
+{
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+History::History()
+{
+  memset(_blocks, 0, sizeof(_blocks));
+  memset(_last, 0, sizeof(_last));
+}
+
+void History::begin()
+{
+  if(restore())
+  {
+    DEBUG_TRACE(true,"history: %u samples restored",getSampleCount());
+  }
+  _lastCheckpoint = millis();
+}
+
+HistoryBlock* History::block(uint32_t seq)
+//
+// block with number seq, nullptr if not (or no longer) in the ring
+{
+  if((seq == 0) || (seq < _firstSeq) || (seq > _lastSeq))
+  {
+    return nullptr;
+  }
+  return &_blocks[seq % HISTORY_BLOCKS];
+}
+
+bool History::add(const Snapshot& snapshot)
+//
+// encode the values of snapshot, return false if there is already a sample of this minute
+{
+  uint32_t minute = snapshot.timeStamp / 60;
+  if((_lastSeq != 0) && (minute <= _lastMinute))
+  {
+    return false;
+  }
+  const float value[N_HISTORY_SERIES] = {snapshot.power, snapshot.dcU, snapshot.dcI,
+                                         snapshot.temperatureInverter, snapshot.temperatureRoom};
+  int32_t scaled[N_HISTORY_SERIES];
+  uint8_t i;
+  for (i=0;i<N_HISTORY_SERIES;i++)
+  {
+    scaled[i] = lroundf(value[i] * _scale[i]);
+  }
+
+  HistoryBlock* b = block(_lastSeq);
+  uint8_t enc[5 * (N_HISTORY_SERIES + 1)];
+  uint8_t n = 0;
+  if(b != nullptr)
+  {
+    n += putVarint(&enc[n], minute - _lastMinute);
+    for (i=0;i<N_HISTORY_SERIES;i++)
+    {
+      n += putVarint(&enc[n], zigzag(scaled[i] - _last[i]));
+    }
+  }
+  if((b == nullptr) || ((b->used + n) > sizeof(b->data)))
+  {
+    // new block, first sample against 0
+    _lastSeq++;
+    if(_firstSeq == 0)
+    {
+      _firstSeq = _lastSeq;
+    }
+    else if((_lastSeq - _firstSeq) >= HISTORY_BLOCKS)
+    {
+      _firstSeq++;            // oldest block is overwritten
+    }
+    b = &_blocks[_lastSeq % HISTORY_BLOCKS];
+    b->seq = _lastSeq;
+    b->startMinute = minute;
+    b->count = 0;
+    b->used = 0;
+    n = putVarint(enc, 0);
+    for (i=0;i<N_HISTORY_SERIES;i++)
+    {
+      n += putVarint(&enc[n], zigzag(scaled[i]));
+    }
+  }
+  memcpy(&b->data[b->used], enc, n);
+  b->used += n;
+  b->count++;
+  _lastMinute = minute;
+  memcpy(_last, scaled, sizeof(_last));
+  return true;
+}
+
+void History::seek(HistoryCursor& cursor, uint32_t from)
+//
+// position cursor at the block containing time from (UNIX time in s); next() may return older samples of this block
+{
+  uint32_t minute = from / 60;
+  uint32_t seq = _firstSeq;
+  while ((seq != 0) && (seq < _lastSeq) && (block(seq + 1)->startMinute <= minute))
+  {
+    seq++;
+  }
+  cursor.seq = seq;
+  cursor.pos = 0;
+  cursor.index = 0;
+}
+
+bool History::next(HistoryCursor& cursor, HistorySample& sample)
+//
+// decode the next sample, false if there is none (yet)
+{
+  HistoryBlock* b = block(cursor.seq);
+  if(b == nullptr)
+  {
+    if((cursor.seq == 0) || (cursor.seq > _lastSeq) || (_firstSeq == 0))
+    {
+      return false;
+    }
+    cursor.seq = _firstSeq;   // block was overwritten, continue with the oldest one
+    cursor.pos = 0;
+    cursor.index = 0;
+    b = block(cursor.seq);
+  }
+  while (cursor.index >= b->count)
+  {
+    if(cursor.seq >= _lastSeq)
+    {
+      return false;           // newest sample reached, the cursor can continue after the next add()
+    }
+    cursor.seq++;
+    cursor.pos = 0;
+    cursor.index = 0;
+    b = block(cursor.seq);
+  }
+
+  uint8_t i;
+  if(cursor.index == 0)
+  {
+    cursor.minute = b->startMinute + getVarint(b->data, cursor.pos);
+    for (i=0;i<N_HISTORY_SERIES;i++)
+    {
+      cursor.value[i] = unzigzag(getVarint(b->data, cursor.pos));
+    }
+  }
+  else
+  {
+    cursor.minute += getVarint(b->data, cursor.pos);
+    for (i=0;i<N_HISTORY_SERIES;i++)
+    {
+      cursor.value[i] += unzigzag(getVarint(b->data, cursor.pos));
+    }
+  }
+  cursor.index++;
+  sample.timeStamp = cursor.minute * 60;
+  for (i=0;i<N_HISTORY_SERIES;i++)
+  {
+    sample.value[i] = cursor.value[i] / _scale[i];
+  }
+  return true;
+}
+
+uint16_t History::query(uint32_t from, uint32_t to, std::function<void(const HistorySample& sample)> func)
+//
+// call func for each sample from <= timeStamp <= to, return number of samples
+{
+  uint32_t start = micros();
+  HistoryCursor cursor;
+  HistorySample sample;
+  uint16_t n = 0;
+  seek(cursor, from);
+  while (next(cursor, sample) && (sample.timeStamp <= to))
+  {
+    if(sample.timeStamp >= from)
+    {
+      func(sample);
+      n++;
+    }
+  }
+  _lastQueryTime = micros() - start;
+  return n;
+}
+
+void History::doLoop()
+{
+  if((HISTORY_CHECKPOINT_INTERVAL > 0) && ((millis() - _lastCheckpoint) >= HISTORY_CHECKPOINT_INTERVAL * 1000UL))
+  {
+    _lastCheckpoint = millis();
+    checkpoint();
+  }
+}
+
+bool History::checkpoint()
+//
+// write all blocks to HISTORY_FILE
+{
+  if(_firstSeq == 0)
+  {
+    return false;
+  }
+  File file = LittleFS.open(HISTORY_FILE, "w");
+  if(!file)
+  {
+    DEBUG_TRACE(true,"history: %s not written",HISTORY_FILE);
+    return false;
+  }
+  HistoryFileHeader header;
+  header.magic = HISTORY_MAGIC;
+  header.blockSize = sizeof(HistoryBlock);
+  header.blocks = HISTORY_BLOCKS;
+  header.firstSeq = _firstSeq;
+  header.lastSeq = _lastSeq;
+  header.lastMinute = _lastMinute;
+  memcpy(header.last, _last, sizeof(header.last));
+  bool ok = (file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header))
+            && (file.write((const uint8_t*)_blocks, sizeof(_blocks)) == sizeof(_blocks));
+  file.close();
+  return ok;
+}
+
+bool History::restore()
+//
+// read blocks of the last checkpoint, if the format matches
+{
+  File file = LittleFS.open(HISTORY_FILE, "r");
+  if(!file)
+  {
+    return false;
+  }
+  HistoryFileHeader header;
+  bool ok = (file.read((uint8_t*)&header, sizeof(header)) == sizeof(header))
+            && (header.magic == HISTORY_MAGIC) && (header.blockSize == sizeof(HistoryBlock))
+            && (header.blocks == HISTORY_BLOCKS)
+            && (file.read((uint8_t*)_blocks, sizeof(_blocks)) == sizeof(_blocks));
+  file.close();
+  if(!ok)
+  {
+    memset(_blocks, 0, sizeof(_blocks));
+    return false;
+  }
+  _firstSeq = header.firstSeq;
+  _lastSeq = header.lastSeq;
+  _lastMinute = header.lastMinute;
+  memcpy(_last, header.last, sizeof(_last));
+  return true;
+}
+
+uint32_t History::getSampleCount()
+{
+  uint32_t n = 0;
+  uint32_t seq;
+  for (seq=_firstSeq;(seq != 0) && (seq <= _lastSeq);seq++)
+  {
+    n += block(seq)->count;
+  }
+  return n;
+}
+
+uint32_t History::getBytesUsed()
+//
+// bytes of encoded samples, getBytesUsed() / getSampleCount() is the size of a sample
+{
+  uint32_t n = 0;
+  uint32_t seq;
+  for (seq=_firstSeq;(seq != 0) && (seq <= _lastSeq);seq++)
+  {
+    n += block(seq)->used;
+  }
+  return n;
+}
+
+uint32_t History::getOldestTime()
+{
+  return (_firstSeq != 0) ? block(_firstSeq)->startMinute * 60 : 0;
+}
+
+uint32_t History::getNewestTime()
+{
+  return (_lastSeq != 0) ? _lastMinute * 60 : 0;
+}
+
+uint32_t History::getLastQueryTime()
+{
+  return _lastQueryTime;
+}
@@ -0,0 +1,80 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <functional>
+#include "config.h"
+#include "publisher.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+enum HistorySeries : uint8_t
+{
+    histPOWER,                  // W
+    histDC_U,                   // V
+    histDC_I,                   // A
+    histTEMP_INVERTER,          // °C
+    histTEMP_ROOM,              // °C, DS18B20
+    N_HISTORY_SERIES
+};
+
+struct HistorySample      // one decoded sample
+{
+  uint32_t timeStamp;             // UNIX epoch time in s, full minute
+  float value[N_HISTORY_SERIES];
+};
+
+struct HistoryBlock       // fixed-size block of delta encoded samples
+{
+  uint32_t seq;                   // number of the block, 0: unused; stored at _blocks[seq % HISTORY_BLOCKS]
+  uint32_t startMinute;           // UNIX epoch time in min of the first sample
+  uint16_t count;                 // samples in data
+  uint16_t used;                  // bytes in data
+  uint8_t  data[HISTORY_BLOCK_SIZE - 12];
+};
+
+struct HistoryCursor      // read position, stays valid while samples are added
+{
+  uint32_t seq = 0;               // block, 0: not positioned
+  uint16_t pos = 0;               // byte in data of block
+  uint16_t index = 0;             // sample in block
+  uint32_t minute = 0;            // time of last decoded sample
+  int32_t  value[N_HISTORY_SERIES];
+};
+
+class History
+{
+public:
+    History();
+    void begin();
+    bool add(const Snapshot& snapshot);
+    void doLoop();
+    bool checkpoint();
+    void seek(HistoryCursor& cursor, uint32_t from);
+    bool next(HistoryCursor& cursor, HistorySample& sample);
+    uint16_t query(uint32_t from, uint32_t to, std::function<void(const HistorySample& sample)> func);
+    uint32_t getSampleCount();
+    uint32_t getBytesUsed();
+    uint32_t getOldestTime();
+    uint32_t getNewestTime();
+    uint32_t getLastQueryTime();
+
+private:
+    HistoryBlock _blocks[HISTORY_BLOCKS];
+    uint32_t _firstSeq = 0;         // oldest block, 0: history empty
+    uint32_t _lastSeq = 0;          // block samples are added to
+    uint32_t _lastMinute = 0;       // time of newest sample
+    int32_t  _last[N_HISTORY_SERIES];   // values of newest sample, scaled
+    uint32_t _lastCheckpoint = 0;   // ms
+    uint32_t _lastQueryTime = 0;    // us, duration of the last query()
+    HistoryBlock* block(uint32_t seq);
+    bool restore();
+};
+#endif // HISTORY_H
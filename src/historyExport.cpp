@@ -0,0 +1,97 @@
+// historyExport.cpp
+//
+// export of the history as CSV or JSON, streamed in chunks
+//
+// 2026-10-18 mh
+// - chunk filler moved to historyStream.cpp
+// - rows continued across chunks, no filler bytes
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Allows to fill gaps in a data base after an outage from the history kept by the logger (see history.cpp):
+http://<localIP>/api/history.csv?from=1700000000&to=1700086400&step=300
+time,power,dc_u,dc_i,t_inv,t_room
+1700000040,1234,301.2,4.10,35.2,21.3
+...
+http://<localIP>/api/history.json?from=...     same rows as arrays:
+{"columns":["time","power","dc_u","dc_i","t_inv","t_room"],"samples":[[1700000040,1234,301.2,4.10,35.2,21.3],...]}
+
+from, to: UNIX time in s (default: all samples), step: min distance of two rows in s (default 60, i.e. every sample);
+with a larger step the first sample of each step is exported (no averaging).
+
+** Usage **
+addHistoryHandlers(server, history);  in setup()
+
+** Implementation **
+As for /metrics (see metrics.cpp), the response is sent with chunked transfer encoding. The fill function of the
+response captures a HistoryStream (see historyStream.cpp), which decodes the samples from a history cursor and
+formats them row by row into each chunk. A row that does not fit is continued in the next chunk, so every chunk is
+filled and no filler bytes are sent. So the memory needed is the same for an hour or a day, and loop() is only
+interrupted for the time of one chunk.
+getHistoryExportHeapMin() shows the lowest free heap during the last export, getHistoryExportRows() its rows.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "historyExport.h"
+#include "historyStream.h"
+
+static uint32_t exportRows = 0;     // rows of last export
+static uint32_t heapMin = 0;        // bytes, last export
+
+static uint32_t argValue(AsyncWebServerRequest* request, const char* name, uint32_t defaultValue)
+{
+  if(!request->hasArg(name))
+  {
+    return defaultValue;
+  }
+  return strtoul(request->arg(name).c_str(), nullptr, 10);
+}
+
+static void addHandler(AsyncWebServer& server, const char* uri, History& history, bool json)
+{
+  History* h = &history;
+  server.on(uri, HTTP_GET, [h, json](AsyncWebServerRequest *request)
+  {
+    HistoryStream stream(*h, argValue(request, "from", 0), argValue(request, "to", UINT32_MAX),
+                         max(argValue(request, "step", 60), (uint32_t)60), json);
+    uint32_t heap = ESP.getFreeHeap();
+    AsyncWebServerResponse* response = request->beginChunkedResponse(json ? "application/json" : "text/csv",
+      [stream, heap](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      {
+        size_t done = stream.fill(buffer, maxLen);
+        uint32_t freeHeap = ESP.getFreeHeap();
+        if(freeHeap < heap)
+        {
+          heap = freeHeap;
+        }
+        if(done == 0)             // end of response
+        {
+          exportRows = stream.getRows();
+          heapMin = heap;
+        }
+        return done;
+      });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+  });
+}
+
+void addHistoryHandlers(AsyncWebServer& server, History& history)
+{
+  addHandler(server, "/api/history.csv", history, false);
+  addHandler(server, "/api/history.json", history, true);
+}
+
+uint32_t getHistoryExportRows()
+{
+  return exportRows;
+}
+
+uint32_t getHistoryExportHeapMin()
+{
+  return heapMin;
+}
@@ -0,0 +1,17 @@
+#ifndef HISTORY_EXPORT_H
+#define HISTORY_EXPORT_H
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "history.h"
+
+void addHistoryHandlers(AsyncWebServer& server, History& history);
+uint32_t getHistoryExportRows();
+uint32_t getHistoryExportHeapMin();
+#endif // HISTORY_EXPORT_H
@@ -0,0 +1,127 @@
+// historyStream.cpp
+//
+// text of a history export (CSV or JSON), continued across the chunks of a response
+//
+// 2026-10-18 mh
+// - first version, chunk filler taken out of historyExport.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Formats the samples of the history between from and to as CSV or JSON (see historyExport.cpp for the format) into
+buffers of any size, e.g. the chunks of a chunked response.
+
+** Usage **
+HistoryStream stream(history, from, to, step, json);
+while ((n = stream.fill(buffer, maxLen)) > 0) ...     n bytes of the export in buffer, 0 at the end
+
+** Implementation **
+The state is a HistoryCursor and the text of the current header, row or footer. fill() decodes the samples from the
+cursor one by one, formats each row by FmtBuf and copies it into the buffer until it is full. A row that does not fit
+completely is continued at the start of the next buffer, so every buffer is filled and no filler bytes are needed.
+The memory is the same for an hour or a day. The class does not depend on the web server, so it runs in the native
+unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "fmtBuf.h"
+#include "historyStream.h"
+
+static const uint8_t _decimals[N_HISTORY_SERIES] = {0, 1, 2, 1, 1};
+
+HistoryStream::HistoryStream(History& history, uint32_t from, uint32_t to, uint32_t step, bool json)
+{
+  _history = &history;
+  _to = to;
+  _step = step;
+  _next = from;
+  _json = json;
+  _history->seek(_cursor, from);
+}
+
+size_t HistoryStream::fill(uint8_t* buffer, size_t maxLen)
+//
+// copy the next maxLen bytes of the export into buffer, return the number of bytes, 0 at the end
+{
+  size_t done = 0;
+  while (done < maxLen)
+  {
+    if(_sent < _length)
+    {
+      size_t n = min(maxLen - done, (size_t)(_length - _sent));
+      memcpy(buffer + done, _text + _sent, n);
+      done += n;
+      _sent += n;
+    }
+    else if(!nextText())
+    {
+      break;
+    }
+  }
+  return done;
+}
+
+uint32_t HistoryStream::getRows()
+{
+  return _rows;
+}
+
+bool HistoryStream::nextText()
+//
+// format the next part of the export into _text, return false at the end
+{
+  FmtBuf text(_text, sizeof(_text));
+  HistorySample sample;
+  switch (_phase)
+  {
+  case hsHEADER:
+    text.add(_json ? "{\"columns\":[\"time\",\"power\",\"dc_u\",\"dc_i\",\"t_inv\",\"t_room\"],\"samples\":["
+                   : "time,power,dc_u,dc_i,t_inv,t_room\n");
+    _phase = hsROWS;
+    break;
+
+  case hsROWS:
+    while (true)
+    {
+      if(!_history->next(_cursor, sample) || (sample.timeStamp > _to))
+      {
+        _phase = hsFOOTER;
+        break;
+      }
+      if(sample.timeStamp >= _next)
+      {
+        if(_json)
+        {
+          text.add((_rows == 0) ? "[" : ",[");
+        }
+        text.addUint(sample.timeStamp);
+        uint8_t i;
+        for (i=0;i<N_HISTORY_SERIES;i++)
+        {
+          text.add(',').addFixed(sample.value[i], _decimals[i]);
+        }
+        text.add(_json ? "]" : "\n");
+        _next = sample.timeStamp + _step;
+        _rows++;
+        break;
+      }
+    }
+    break;
+
+  case hsFOOTER:
+    if(_json)
+    {
+      text.add("]}");
+    }
+    _phase = hsDONE;
+    break;
+
+  default:
+    return false;
+  }
+  _length = text.length();
+  _sent = 0;
+  return true;
+}
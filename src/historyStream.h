@@ -0,0 +1,40 @@
+#ifndef HISTORY_STREAM_H
+#define HISTORY_STREAM_H
+//
+// 2026-10-18 mh
+// - first version, chunk filler taken out of historyExport.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "history.h"
+
+#define HISTORY_STREAM_ROW_SIZE 80  // bytes; max length of one row
+
+// text of a history export (CSV or JSON), written in pieces of any size
+class HistoryStream
+{
+public:
+    HistoryStream(History& history, uint32_t from, uint32_t to, uint32_t step, bool json);
+    size_t fill(uint8_t* buffer, size_t maxLen);
+    uint32_t getRows();
+
+private:
+    enum Phase : uint8_t {hsHEADER, hsROWS, hsFOOTER, hsDONE};
+
+    History* _history;
+    HistoryCursor _cursor;
+    uint32_t _to;
+    uint32_t _step;
+    uint32_t _next;                 // min time of next row
+    uint32_t _rows = 0;
+    bool _json;
+    Phase _phase = hsHEADER;
+    char _text[HISTORY_STREAM_ROW_SIZE];    // header, row or footer being sent
+    uint8_t _length = 0;            // bytes in _text
+    uint8_t _sent = 0;              // bytes of _text already sent
+
+    bool nextText();
+};
+#endif // HISTORY_STREAM_H
@@ -0,0 +1,75 @@
+// httpCache.cpp
+//
+// ETag validation of pages, so a repeated request is answered by 304 Not Modified
+//
+// 2026-10-18 mh
+// - ETag functions in etag.cpp, If-None-Match compared by etagMatch()
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+The start page is small, but it is requested by each visit and composed of the current WiFi, IP and server data.
+The ETag of a page is a hash of these data and the firmware build. The browser sends it back with If-None-Match
+and gets 304 Not Modified without a body as long as nothing changed; then the page is not even composed.
+
+** Usage **
+char etag[ETAG_SIZE];
+uint32_t hash = etagSeed();
+hash = etagHash(hash, currentIP.c_str());     for each value shown on the page
+etagFormat(hash, etag);
+if(sendNotModified(request, etag))            304 sent
+  return;
+response = ... compose page ...
+addRevalidateHeaders(response, etag);         ETag, Cache-Control: no-cache
+request->send(response);
+
+** Implementation **
+The ETag is built and compared by the functions of etag.cpp.
+Cache-Control: no-cache lets the browser keep the page, but it has to revalidate it with each request, as the
+values may change any time. If-None-Match may contain a list of ETags or "*".
+getHttpCacheHits() counts the 304 responses, getHttpCacheMisses() the pages sent with a new ETag.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "httpCache.h"
+
+static uint32_t _hits = 0;
+static uint32_t _misses = 0;
+
+bool sendNotModified(AsyncWebServerRequest* request, const char* etag)
+//
+// answer by 304 if the browser has the page with this ETag, false: page has to be sent
+{
+  if(request->hasHeader("If-None-Match"))
+  {
+    if(etagMatch(request->getHeader("If-None-Match")->value().c_str(), etag))
+    {
+      AsyncWebServerResponse* response = request->beginResponse(304);
+      addRevalidateHeaders(response, etag);
+      request->send(response);
+      _hits++;
+      return true;
+    }
+  }
+  _misses++;
+  return false;
+}
+
+void addRevalidateHeaders(AsyncWebServerResponse* response, const char* etag)
+{
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+}
+
+uint32_t getHttpCacheHits()
+{
+  return _hits;
+}
+
+uint32_t getHttpCacheMisses()
+{
+  return _misses;
+}
@@ -0,0 +1,19 @@
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+//
+// 2026-10-18 mh
+// - ETag functions in etag.h
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "etag.h"
+
+bool sendNotModified(AsyncWebServerRequest* request, const char* etag);
+void addRevalidateHeaders(AsyncWebServerResponse* response, const char* etag);
+uint32_t getHttpCacheHits();
+uint32_t getHttpCacheMisses();
+#endif // HTTP_CACHE_H
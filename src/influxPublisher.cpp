@@ -0,0 +1,205 @@
+// influxPublisher.cpp
+//
+// InfluxDB line protocol batch writer for inverter snapshots
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Writes the values of several inverter polls with one http request to InfluxDB, one line per poll:
+solis,device=SolisLogger power_w=1235i,dc_u_mv=230100i,dc_i_ma=5360i,dc_p_w=1233i,e_today_wh=4200i,t_inv_mc=35000i,t_room_mc=21500i 1666801000
+
+** Usage **
+influx.init(influxConfig, device);    config from confWeb parameters, InfluxDB is off if the server is empty
+influx.publish(snapshot);             once per poll, the line is collected
+influx.doLoop();                      call in loop(), writes the collected lines every flush interval
+
+** Implementation **
+All fields are integers (suffix i) in milli units or W/Wh, so there is no float formatting and no rounding on the
+server. The timestamp is UNIX epoch time in s, the write path has to contain precision=s.
+The lines are formatted by FmtBuf straight into one of two fixed body buffers: while one buffer is sent by
+AsyncHttp, the next polls are collected in the other one. The collecting buffer is written if its oldest line is older
+than the flush interval or if the next line may not fit anymore. For InfluxDB 2 an API token is sent as
+"Authorization: Token <token>".
+A failed write (no answer, 4xx, 5xx) is counted and the lines are dropped; InfluxDB answers 204 on success.
+  *** end description *** */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "config.h"
+#include "fmtBuf.h"
+#include "influxPublisher.h"
+
+static int32_t milli(float value)
+{
+  return (int32_t)((value >= 0) ? (value * 1000.0 + 0.5) : (value * 1000.0 - 0.5));
+}
+
+static int32_t whole(float value)
+{
+  return (int32_t)((value >= 0) ? (value + 0.5) : (value - 0.5));
+}
+
+InfluxPublisher::InfluxPublisher()
+{
+  _device[0] = '\0';
+  _authorization[0] = '\0';
+}
+
+void InfluxPublisher::init(InfluxConfig& config, const char* device)
+{
+  _enabled = (config.server[0] != '\0');
+  if(!_enabled)
+  {
+    return;
+  }
+
+  // tag value: escape comma, equal sign and space
+  size_t i, n = 0;
+  for (i=0;(device[i] != '\0') && (n < (sizeof(_device) - 2));i++)
+  {
+    if((device[i] == ',') || (device[i] == '=') || (device[i] == ' '))
+    {
+      _device[n++] = '\\';
+    }
+    _device[n++] = device[i];
+  }
+  _device[n] = '\0';
+
+  if(config.token[0] != '\0')
+  {
+    snprintf(_authorization, sizeof(_authorization), "Authorization: Token %s", config.token);
+  }
+  uint32_t interval = atol(config.flushInterval);
+  _flushInterval = ((interval > 0) ? interval : 1) * 1000UL;
+  _http.setServer(String(config.server), String(config.path), "text/plain; charset=utf-8", _authorization);
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"influx: server %s, path %s, flush interval %u s",config.server,config.path,_flushInterval/1000);
+}
+
+bool InfluxPublisher::publish(const Snapshot& snapshot)
+//
+// append line of snapshot to the collecting buffer
+{
+  if(!_enabled)
+  {
+    return false;
+  }
+  if((_collectLen + INFLUX_LINE_SIZE) > INFLUX_BODY_SIZE)
+  {
+    _dropCount++;           // previous write still in progress and buffer full
+    return false;
+  }
+
+  FmtBuf line(&_body[_collect][_collectLen], INFLUX_BODY_SIZE - _collectLen);
+  line.add(INFLUX_MEASUREMENT);
+  if(_device[0] != '\0')
+  {
+    line.add(",device=").add(_device);
+  }
+  line.add(" power_w=").addInt(whole(snapshot.power)).add('i');
+  line.add(",dc_u_mv=").addInt(milli(snapshot.dcU)).add('i');
+  line.add(",dc_i_ma=").addInt(milli(snapshot.dcI)).add('i');
+  line.add(",dc_p_w=").addInt(whole(snapshot.dcPower)).add('i');
+  line.add(",e_today_wh=").addInt(milli(snapshot.energyToday)).add('i');
+  line.add(",t_inv_mc=").addInt(milli(snapshot.temperatureInverter)).add('i');
+  line.add(",t_room_mc=").addInt(milli(snapshot.temperatureRoom)).add('i');
+  line.add(' ').addUint(snapshot.timeStamp).add('\n');
+  if(line.overflow())
+  {
+    _body[_collect][_collectLen] = '\0';
+    _dropCount++;
+    return false;
+  }
+
+  if(_collectLines == 0)
+  {
+    _firstLineTime = millis();
+  }
+  _collectLen += line.length();
+  _collectLines++;
+  return true;
+}
+
+void InfluxPublisher::doLoop()
+{
+  if(!_enabled)
+  {
+    return;
+  }
+  _http.doLoop();
+  if(_http.hasResult())
+  {
+    _lastResult = _http.takeResult();
+    if((_lastResult < 200) || (_lastResult >= 300))
+    {
+      _errorCount++;
+      _dropCount += _sendingLines;
+      DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"influx: write of %u lines failed, code %d",_sendingLines,_lastResult);
+    }
+    _sendingLines = 0;
+  }
+
+  if((_collectLines > 0) && !_http.isBusy() && (WiFi.status() == WL_CONNECTED))
+  {
+    if(((millis() - _firstLineTime) >= _flushInterval) || ((_collectLen + INFLUX_LINE_SIZE) > INFLUX_BODY_SIZE))
+    {
+      flush();
+    }
+  }
+}
+
+const char* InfluxPublisher::getName()
+{
+  return "InfluxDB";
+}
+
+uint32_t InfluxPublisher::getBytesSent()
+{
+  return _http.getBytesSent();
+}
+
+uint32_t InfluxPublisher::getRoundTrips()
+{
+  return _http.getRequestCount();
+}
+
+uint32_t InfluxPublisher::getWriteCount()
+{
+  return _writeCount;
+}
+
+uint32_t InfluxPublisher::getErrorCount()
+{
+  return _errorCount;
+}
+
+uint32_t InfluxPublisher::getDropCount()
+{
+  return _dropCount;
+}
+
+int InfluxPublisher::getLastResult()
+{
+  return _lastResult;
+}
+
+void InfluxPublisher::flush()
+//
+// send collecting buffer, continue collecting in the other one
+{
+  uint8_t sending = _collect;
+  if(!_http.post(_body[sending], _collectLen))
+  {
+    return;
+  }
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"influx: write %u lines, %u bytes",_collectLines,_collectLen);
+  _writeCount++;
+  _sendingLines = _collectLines;
+  _collect = 1 - sending;
+  _collectLen = 0;
+  _collectLines = 0;
+}
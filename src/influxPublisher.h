@@ -0,0 +1,64 @@
+#ifndef INFLUX_PUBLISHER_H
+#define INFLUX_PUBLISHER_H
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+#include "publisher.h"
+#include "asyncHttp.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+struct InfluxConfig
+{
+  char server[64] = INFLUX_SERVER;      // host[:port], empty: not used
+  char path[96] = INFLUX_WRITE_PATH;    // write endpoint with database/bucket and precision=s
+  char token[96] = "";                  // InfluxDB 2: API token, empty: no authorization
+  char flushInterval[6] = INFLUX_FLUSH_INTERVAL;
+};
+
+class InfluxPublisher : public Publisher
+{
+public:
+    InfluxPublisher();
+    void init(InfluxConfig& config, const char* device);
+    uint32_t getWriteCount();
+    uint32_t getErrorCount();
+    uint32_t getDropCount();
+    int getLastResult();
+
+    // Publisher
+    bool publish(const Snapshot& snapshot) override;
+    void doLoop() override;
+    const char* getName() override;
+    uint32_t getBytesSent() override;
+    uint32_t getRoundTrips() override;
+
+private:
+    AsyncHttp _http;
+    bool _enabled = false;
+    char _device[48];               // tag value, escaped
+    char _authorization[112];
+    uint32_t _flushInterval = 300000;   // ms
+
+    char _body[2][INFLUX_BODY_SIZE];    // lines are collected in one buffer while the other one is sent
+    uint8_t _collect = 0;           // index of collecting buffer
+    size_t _collectLen = 0;
+    uint16_t _collectLines = 0;
+    uint32_t _firstLineTime = 0;    // ms, time of oldest line in collecting buffer
+
+    uint32_t _writeCount = 0;
+    uint32_t _errorCount = 0;
+    uint32_t _dropCount = 0;        // lines lost, write failed or buffer full
+    uint16_t _sendingLines = 0;
+    int _lastResult = 0;
+
+    void flush();
+};
+#endif // INFLUX_PUBLISHER_H
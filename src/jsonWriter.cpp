@@ -0,0 +1,191 @@
+// jsonWriter.cpp
+//
+// JSON objects written member by member to a stream, numbers in fixed point
+//
+// 2026-10-18 mh
+// - texts are escaped: " \ and control characters
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Replacement of String concatenation with String(float) for the JSON API (/api/all.json etc.). Each member is formatted by
+FmtBuf into a small buffer on the stack and written to the output, usually an AsyncResponseStream, whose buffer is
+allocated once with the expected size. So there is no intermediate String and no float formatting by printf.
+
+** Usage **
+AsyncResponseStream* response = request->beginResponseStream("application/json", API_JSON_SIZE);
+JsonWriter json(*response);
+json.beginObject().add("seq", snapshot.seq).add("power", power, 1);
+json.beginObject("dc").add("u", dc_u, 1).add("i", dc_i, 2).endObject();
+json.endObject();
+request->send(response);
+
+** Implementation **
+Commas are set by one bit per nesting level, which tells whether the current object has a member already.
+Keys are literals of the firmware and written as they are. Texts may come from the configuration or the network
+(e.g. SSID, server name), so " and \ get a backslash and characters below 0x20 are written as \n, \r, \t or \u00xx;
+runs without such characters are written as one block.
+Numbers are written by FmtBuf::addFixed() with the given decimals; nan and inf are written as null, as JSON has no
+representation for them, and so are values beyond the range of addFixed() (|v| >= 4.29e9), which would be "ovf".
+  *** end description *** */
+
+#include <Arduino.h>
+#include <math.h>
+#include "fmtBuf.h"
+#include "jsonWriter.h"
+
+#define JSON_NUMBER_SIZE 24         // bytes; one formatted number
+#define JSON_FIXED_MAX   4.29e9f    // FmtBuf::addFixed() writes "ovf" from 2^32 on
+
+JsonWriter::JsonWriter(Print& out) : _out(out)
+{
+}
+
+JsonWriter& JsonWriter::beginObject(const char* key)
+{
+  if(key != nullptr)
+  {
+    this->key(key);
+  }
+  else if(_depth > 0)
+  {
+    this->key(nullptr);
+  }
+  write("{", 1);
+  if(_depth < JSON_MAX_DEPTH)
+  {
+    _depth++;
+    _notFirst &= ~(1 << _depth);
+  }
+  return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+  write("}", 1);
+  if(_depth > 0)
+  {
+    _depth--;
+  }
+  return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, uint32_t value)
+{
+  char text[JSON_NUMBER_SIZE];
+  FmtBuf buf(text, sizeof(text));
+  buf.addUint(value);
+  this->key(key);
+  write(buf.c_str(), buf.length());
+  return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, float value, uint8_t decimals)
+{
+  char text[JSON_NUMBER_SIZE];
+  FmtBuf buf(text, sizeof(text));
+  if(isnan(value) || isinf(value) || (fabsf(value) >= JSON_FIXED_MAX))
+  {
+    buf.add("null");
+  }
+  else
+  {
+    buf.addFixed(value, decimals);
+  }
+  this->key(key);
+  write(buf.c_str(), buf.length());
+  return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, bool value)
+{
+  this->key(key);
+  if(value)
+  {
+    write("true", 4);
+  }
+  else
+  {
+    write("false", 5);
+  }
+  return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* key, const char* text)
+{
+  this->key(key);
+  write("\"", 1);
+  writeEscaped(text);
+  write("\"", 1);
+  return *this;
+}
+
+size_t JsonWriter::length()
+{
+  return _length;
+}
+
+void JsonWriter::key(const char* key)
+//
+// comma if not the first member of the object, then "key":
+{
+  if(_notFirst & (1 << _depth))
+  {
+    write(",", 1);
+  }
+  _notFirst |= (1 << _depth);
+  if(key != nullptr)
+  {
+    write("\"", 1);
+    write(key, strlen(key));
+    write("\":", 2);
+  }
+}
+
+void JsonWriter::write(const char* text, size_t len)
+{
+  _length += _out.write((const uint8_t*)text, len);
+}
+
+void JsonWriter::writeEscaped(const char* text)
+//
+// text of a JSON string, escaped
+{
+  const char* run = text;
+  while (*text != '\0')
+  {
+    uint8_t c = *text;
+    if((c == '"') || (c == '\\') || (c < 0x20))
+    {
+      write(run, text - run);
+      char escape[7] = {'\\', (char)c, 0};
+      size_t len = 2;
+      switch (c)
+      {
+      case '"':
+      case '\\':
+        break;
+      case '\n':
+        escape[1] = 'n';
+        break;
+      case '\r':
+        escape[1] = 'r';
+        break;
+      case '\t':
+        escape[1] = 't';
+        break;
+      default:
+        snprintf(escape, sizeof(escape), "\\u%04x", c);
+        len = 6;
+        break;
+      }
+      write(escape, len);
+      run = text + 1;
+    }
+    text++;
+  }
+  write(run, text - run);
+}
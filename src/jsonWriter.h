@@ -0,0 +1,38 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+//
+// 2026-10-18 mh
+// - texts are escaped
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+
+#define JSON_MAX_DEPTH 8            // nesting of objects
+
+// writes a JSON object member by member to a Print, e.g. an AsyncResponseStream
+class JsonWriter
+{
+public:
+    JsonWriter(Print& out);
+    JsonWriter& beginObject(const char* key = nullptr);
+    JsonWriter& endObject();
+    JsonWriter& add(const char* key, uint32_t value);
+    JsonWriter& add(const char* key, float value, uint8_t decimals);
+    JsonWriter& add(const char* key, bool value);
+    JsonWriter& add(const char* key, const char* text);
+    size_t length();
+
+private:
+    Print& _out;
+    uint8_t _depth = 0;
+    uint16_t _notFirst = 0;         // bit n: object of depth n has a member already
+    size_t _length = 0;
+
+    void write(const char* text, size_t len);
+    void writeEscaped(const char* text);
+    void key(const char* key);
+};
+#endif // JSON_WRITER_H
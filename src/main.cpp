@@ -52,6 +52,21 @@ Copyright and license notices must be preserved. Contributors provide an express
 #include "modbus.h"
 #include "myTicker.h"
 #include "vzHttp.h"
+#include "vzChannelParameter.h"
+#include "vzQueue.h"
+#include "fmtBuf.h"
+#include "publisher.h"
+#include "mqttPublisher.h"
+#include "influxPublisher.h"
+#include "ssePublisher.h"
+#include "metrics.h"
+#include "dashUpdater.h"
+#include "history.h"
+#include "historyExport.h"
+#include "downsampler.h"
+#include "httpCache.h"
+#include "admission.h"
+#include "jsonWriter.h"
 
 // local function declaration
 //String toStringIp(IPAddress ip);
@@ -63,27 +78,32 @@ enum inverterRead {readAll, readPower, readDayEnergy, readMonthYearEnergy};
 void readInverter();
 void publishInverterFrequentValues();
 void publishInverterSeldomValues();
+void publishFlush();
+void onPublishDone(int httpResponseCode);
+void onPublishDelivery(uint16_t sourceMask, bool saved);
 
 // callback handler and html page functions
 void wifiConnected();
 void configSaved();
+bool formValidator(WebRequestWrapper* webRequestWrapper);
 void notFound(AsyncWebServerRequest *request);
 
-void homePage(String& content);
+void sendHomePage(AsyncWebServerRequest *request);
 void handleRoot(AsyncWebServerRequest *request);
 void startHtml(AsyncWebServerRequest *request);
 void onConfiguration(AsyncWebServerRequest *request);
 
-String buildResponse(byte type);
+void sendApiJson(AsyncWebServerRequest *request, byte type);
 
 void onReset(AsyncWebServerRequest *request);
 boolean needReset = false;
 
+bool writeMetrics(uint8_t group, PromWriter& out);
+
 String currentHtmlPage =" ";     // sub-headline for different modes
 String currentSSID = "unknown";
 String currentIP   = "unknown";
 char c_wifiIP[40];
-String vzServerIP = "unknown";
 
 // setup clock interface, ticker and timer stuff
 myTicker ticker;
@@ -108,6 +128,8 @@ char s_DateTime[NMAX_DATE_TIME] = "1960-01-01 00:00";
 uint32_t lastDateUpdate=0;
 uint8_t lastDay = 100;        // used to store last day
 uint8_t lastMonth = 100;      // used to store last month
+uint8_t pendingDay = 100;     // day of energyLastDay on the way, confirmed by onPublishDelivery()
+uint8_t pendingMonth = 100;   // month of energyLastMonth on the way, confirmed by onPublishDelivery()
 
 // LED stuff
 LED led;
@@ -123,14 +145,30 @@ LED led;
 // volkszaehler stuff
 VzHttpConfig vzHttpConfig;
 VzHttp  vz_http;
+VzQueue vzQueue;          // store-and-forward queue on LittleFS for tuples that could not be sent
 int httpStatus = 0;
 String vzUUID;
+boolean publishCycle = false;   // set by the ticker driven publish functions, batch is sent by publishFlush()
+
+// publisher stuff: each snapshot of the inverter values is handed to all publishers
+MqttConfig mqttConfig;
+MqttPublisher mqtt;
+InfluxConfig influxConfig;
+InfluxPublisher influx;
+Snapshot snapshot;
+History history;          // samples of the last 24 h in RAM, checkpoint on LittleFS
+SsePublisher sse;         // server-sent events at SSE_URL
+Publisher* publishers[] = {&vz_http, &mqtt, &influx, &sse};
+#define N_PUBLISHERS (sizeof(publishers) / sizeof(publishers[0]))
+void publishSnapshot();
+void updateCharts();
 
 // server and WiFi stuff
 // class for WiFi and webserver configuration page, connects to WiFi in AP or STA mode
 // note: constructor does some presets
 DNSServer dnsServer;
 AsyncWebServer server(80);
+AdmissionControl admission;   // max requests in progress, heap watermark, rate limit per client
 
 IotWebConf confWeb(WIFI_AP_SSID, &dnsServer, &server, WIFI_AP_DEFAULT_PASSWORD, WIFI_AP_CONFIG_VERSION);
 boolean b_WiFi_connected = false;
@@ -142,36 +180,52 @@ TextParameter confVZserverParam = TextParameter("VZ Server", "vzServer", vzHttpC
                                                    VZ_SERVER, nullptr, "vzServer");
 TextParameter confVZmiddlewareParam = TextParameter("VZ Middleware", "vzMiddleware", vzHttpConfig.vzMiddleware, sizeof(vzHttpConfig.vzMiddleware),
                                                    VZ_MIDDLEWARE, nullptr, "vzMiddleware");
-TextParameter confVZuuidTemp6Param = TextParameter("UUID Temp6", "UUID-Temp6", &vzHttpConfig.uuidValue[vzTEMP_CH6][0], sizeOfUUID,
-                                                   VZ_UUID_TEMP_CH6, nullptr, "UUID-Temp6");
-TextParameter confVZuuidInvPowParam = TextParameter("UUID InvPower", "UUID-InvPower", &vzHttpConfig.uuidValue[vzINV_POWER][0], sizeOfUUID,
-                                                   VZ_UUID_INV_POWER, nullptr, "UUID-InvPower");
-TextParameter confVZuuidInvEnLastDayParam = TextParameter("UUID InvEnergyLastDay", "UUID-InvEnergyLastDay", &vzHttpConfig.uuidValue[vzINV_ENERGY_LASTDAY][0], sizeOfUUID,
-                                                   VZ_UUID_INV_ENERGY_LASTDAY, nullptr, "UUID-InvEnergyLastDay");
-TextParameter confVZuuidInvEnLastMonthParam = TextParameter("UUID InvEnergyLastMonth", "UUID-InvEnergyLastMonth", &vzHttpConfig.uuidValue[vzINV_ENERGY_LASTMONTH][0], sizeOfUUID,
-                                                   VZ_UUID_INV_ENERGY_LASTMONTH, nullptr, "UUID-InvEnergyLastMonth");
-TextParameter confVZuuidInvDCIParam = TextParameter("UUID InvDCI", "UUID-InvDCI", &vzHttpConfig.uuidValue[vzINV_DC_I][0], sizeOfUUID,
-                                                   VZ_UUID_INV_DC_I, nullptr, "UUID-InvDCI");
-TextParameter confVZuuidInvDCUParam = TextParameter("UUID InvDCU", "UUID-InvDCU", &vzHttpConfig.uuidValue[vzINV_DC_U][0], sizeOfUUID,
-                                                   VZ_UUID_INV_DC_U, nullptr, "UUID-InvDCU");
-TextParameter confVZuuidInvDCPowParam = TextParameter("UUID InvDCPow", "UUID-InvDCPow", &vzHttpConfig.uuidValue[vzINV_DC_POWER][0], sizeOfUUID,
-                                                   VZ_UUID_INV_DC_POWER, nullptr, "UUID-InvDCU");
-TextParameter confVZuuidTestParam = TextParameter("UUID Test", "UUID-Test", &vzHttpConfig.uuidValue[vzTEST][0], sizeOfUUID,
-                                                   VZ_UUID_TEST, nullptr, "UUID-Test");
-TextParameter confVZuuidInvEnThisDayParam = TextParameter("UUID InvEnergyThisDay", "UUID-InvEnergyThisDay", &vzHttpConfig.uuidValue[vzINV_ENERGY_THISDAY][0], sizeOfUUID,
-                                                   VZ_UUID_INV_ENERGY_THISDAY, nullptr, "UUID-InvEnergyThisDay");
-TextParameter confVZuuidInvHeartBeatParam = TextParameter("UUID InvHeartBeat", "UUID-InvHeartBeat", &vzHttpConfig.uuidValue[vzINV_HEART_BEAT][0], sizeOfUUID,
-                                                   VZ_UUID_INV_HEART_BEAT, nullptr, "UUID-InvHeartBeat");
-
+NumberParameter confVZpublishWindowParam = NumberParameter("VZ Publish Window[s]", "vzPublishWindow", vzHttpConfig.publishWindow, sizeof(vzHttpConfig.publishWindow),
+                                                   VZ_PUBLISH_WINDOW, nullptr, "min='0' max='60' step='1'");
+NumberParameter confVZmaxBatchParam = NumberParameter("VZ Max Batch[tuples]", "vzMaxBatch", vzHttpConfig.maxBatch, sizeof(vzHttpConfig.maxBatch),
+                                                   VZ_MAX_BATCH, nullptr, "min='1' max='32' step='1'");
+NumberParameter confVZmaxFlushParam = NumberParameter("VZ Max Flush Interval[s]", "vzMaxFlush", vzHttpConfig.maxFlushInterval, sizeof(vzHttpConfig.maxFlushInterval),
+                                                   VZ_MAX_FLUSH_INTERVAL, nullptr, "min='0' max='3600' step='1'");
+char vzGzipValues[][2] = {"0", "1"};
+char vzGzipNames[][24] = {"off", "gzip, plain if rejected"};
+SelectParameter confVZgzipParam = SelectParameter("VZ Replay Compression", "vzGzip", vzHttpConfig.gzipReplay, sizeof(vzHttpConfig.gzipReplay),
+                                                   (char*)vzGzipValues, (char*)vzGzipNames, sizeof(vzGzipValues) / sizeof(vzGzipValues[0]), sizeof(vzGzipNames[0]),
+                                                   VZ_GZIP_REPLAY);
 NumberParameter confTimezoneParam = NumberParameter("TimezoneOffset[h]", "TimezoneOffset", s_TimezoneOffset, sizeof(s_TimezoneOffset),
                                                    TIMEZONE_DEFAULT, nullptr, "TimezoneOffset");
 ParameterGroup paramGroup = ParameterGroup("VZ Settings", "VZ-Settings");
 
+char mqttQosValues[][2] = {"0", "1"};
+char mqttQosNames[][20] = {"0 (at most once)", "1 (at least once)"};
+TextParameter confMqttServerParam = TextParameter("MQTT Server[:Port]", "mqttServer", mqttConfig.server, sizeof(mqttConfig.server),
+                                                   MQTT_SERVER, "empty: MQTT off", "mqttServer");
+TextParameter confMqttUserParam = TextParameter("MQTT User", "mqttUser", mqttConfig.user, sizeof(mqttConfig.user),
+                                                   "", nullptr, "mqttUser");
+PasswordParameter confMqttPasswordParam = PasswordParameter("MQTT Password", "mqttPassword", mqttConfig.password, sizeof(mqttConfig.password),
+                                                   "");
+TextParameter confMqttTopicParam = TextParameter("MQTT Topic", "mqttTopic", mqttConfig.topic, sizeof(mqttConfig.topic),
+                                                   MQTT_TOPIC, nullptr, "mqttTopic");
+SelectParameter confMqttQosParam = SelectParameter("MQTT QoS", "mqttQos", mqttConfig.qos, sizeof(mqttConfig.qos),
+                                                   (char*)mqttQosValues, (char*)mqttQosNames, sizeof(mqttQosValues) / sizeof(mqttQosValues[0]), sizeof(mqttQosNames[0]),
+                                                   MQTT_QOS);
+ParameterGroup paramGroupMqtt = ParameterGroup("MQTT Settings", "MQTT-Settings");
+
+TextParameter confInfluxServerParam = TextParameter("InfluxDB Server[:Port]", "influxServer", influxConfig.server, sizeof(influxConfig.server),
+                                                   INFLUX_SERVER, "empty: InfluxDB off", "influxServer");
+TextParameter confInfluxPathParam = TextParameter("InfluxDB Write Path", "influxPath", influxConfig.path, sizeof(influxConfig.path),
+                                                   INFLUX_WRITE_PATH, nullptr, "influxPath");
+TextParameter confInfluxTokenParam = TextParameter("InfluxDB Token", "influxToken", influxConfig.token, sizeof(influxConfig.token),
+                                                   "", "InfluxDB 2 only", "influxToken");
+NumberParameter confInfluxFlushParam = NumberParameter("InfluxDB Flush Interval[s]", "influxFlush", influxConfig.flushInterval, sizeof(influxConfig.flushInterval),
+                                                   INFLUX_FLUSH_INTERVAL, nullptr, "min='1' max='3600' step='1'");
+ParameterGroup paramGroupInflux = ParameterGroup("InfluxDB Settings", "InfluxDB-Settings");
+
 Parameter* thingName;                   // name set on configuration page, might override WIFI_AP_SSID
 char wifiAPssid[IOTWEBCONF_WORD_LEN] = WIFI_AP_SSID;
 
 // ESP-Dash
 ESPDash dashboard(&server);
+DashUpdater dashUpdater(dashboard);   // cards are sent once per loop, at most every DASH_UPDATE_INTERVAL
 
 Card card_Title(&dashboard, GENERIC_CARD, "Title");
 Card card_Time(&dashboard, GENERIC_CARD, "Date & Time");
@@ -195,6 +249,16 @@ Card card_temperatureInverter(&dashboard, TEMPERATURE_CARD, "Inverter Temperatur
 
 Card card_status(&dashboard, STATUS_CARD, "Loop Status", "empty");
 Card card_inverterStatus(&dashboard, STATUS_CARD, "Inverter Status", "empty");
+Card card_vzChannels(&dashboard, STATUS_CARD, "VZ Channels", "empty");
+
+// charts with a fixed number of bars, fed by downsamplers (local time)
+Chart chart_powerToday(&dashboard, BAR_CHART, "Power Today (W, avg per 30 min)");
+Chart chart_energyDays(&dashboard, BAR_CHART, "Energy Last 30 Days (kWh)");
+Downsampler powerToday(CHART_TODAY_BUCKETS, 86400 / CHART_TODAY_BUCKETS);
+Downsampler energyDays(CHART_DAYS, 86400);
+String chartTodayX[CHART_TODAY_BUCKETS];    // "hh:mm", set once
+int chartDaysX[CHART_DAYS];                 // day of month
+float chartY[DOWNSAMPLE_MAX_BUCKETS];
 
 
 float dc_u = -1.0;
@@ -235,6 +299,10 @@ void setup()   // --------------------------------------------------------------
   //--- Start AsyncWebServer + Handler --------------------------------------------------------------
   server.onNotFound(notFound);
 
+  // admission control has to be the first handler, it checks the requests of all handlers added later
+  admission.begin(server);
+  admission.setStreamUrl(SSE_URL);
+
   server.on("/", handleRoot);   			// note: will address Dash board, handleRoot is ignored
   server.on("/index.html", startHtml);    	// url for home/start page
   server.on("/start", startHtml);         	// url for home/start page
@@ -244,31 +312,52 @@ void setup()   // --------------------------------------------------------------
 
   // allows to request data in json format by addressing these urls
   server.on("/api/power.json", HTTP_GET, [](AsyncWebServerRequest *request)
-            { request->send(200, "application/json", buildResponse(0)); });
+            { sendApiJson(request, 0); });
   server.on("/api/all.json", HTTP_GET, [](AsyncWebServerRequest *request)
-            { request->send(200, "application/json", buildResponse(1)); });
+            { sendApiJson(request, 1); });
+  server.on("/api/v2/snapshot.json", HTTP_GET, [](AsyncWebServerRequest *request)
+            { sendApiJson(request, 2); });
+  server.on("/api/channels.json", HTTP_GET, [](AsyncWebServerRequest *request)
+            {
+              AsyncResponseStream* response = request->beginResponseStream("application/json");
+              vz_http.printChannelStats(*response);     // outcome statistics per volkszaehler channel
+              request->send(response);
+            });
+  // history as CSV or JSON, /api/history.csv?from=&to=&step=
+  addHistoryHandlers(server, history);
+  // live stream of snapshots as server-sent events
+  sse.begin(server);
+  // Prometheus scrape endpoint
+  addMetricsHandler(server, "/metrics", writeMetrics);
 
 
   // own config parameter group
   // note: system configuration parameter group is built-in
   paramGroup.addItem(&confVZserverParam);
   paramGroup.addItem(&confVZmiddlewareParam);
-  paramGroup.addItem(&confVZuuidTemp6Param);
-  paramGroup.addItem(&confVZuuidInvPowParam);
-  paramGroup.addItem(&confVZuuidInvEnLastDayParam);
-  paramGroup.addItem(&confVZuuidInvEnLastMonthParam);
-  paramGroup.addItem(&confVZuuidInvDCIParam);
-  paramGroup.addItem(&confVZuuidInvDCUParam);
-  paramGroup.addItem(&confVZuuidInvDCPowParam);
-  paramGroup.addItem(&confVZuuidInvEnThisDayParam);
-  paramGroup.addItem(&confVZuuidInvHeartBeatParam);
-  paramGroup.addItem(&confVZuuidTestParam);
+  paramGroup.addItem(&confVZpublishWindowParam);
+  paramGroup.addItem(&confVZmaxBatchParam);
+  paramGroup.addItem(&confVZmaxFlushParam);
+  paramGroup.addItem(&confVZgzipParam);
   paramGroup.addItem(&confTimezoneParam);
   confWeb.addParameterGroup(&paramGroup);
+  addChannelParameters(confWeb, vzHttpConfig.channel);    // one group per channel of the registry
+  paramGroupMqtt.addItem(&confMqttServerParam);
+  paramGroupMqtt.addItem(&confMqttUserParam);
+  paramGroupMqtt.addItem(&confMqttPasswordParam);
+  paramGroupMqtt.addItem(&confMqttTopicParam);
+  paramGroupMqtt.addItem(&confMqttQosParam);
+  confWeb.addParameterGroup(&paramGroupMqtt);
+  paramGroupInflux.addItem(&confInfluxServerParam);
+  paramGroupInflux.addItem(&confInfluxPathParam);
+  paramGroupInflux.addItem(&confInfluxTokenParam);
+  paramGroupInflux.addItem(&confInfluxFlushParam);
+  confWeb.addParameterGroup(&paramGroupInflux);
 
 
   // handler for web configuration
   confWeb.setConfigSavedCallback(&configSaved);
+  confWeb.setFormValidator(&formValidator);
   confWeb.setWifiConnectionCallback(&wifiConnected);
 
   digitalWrite(LED_BUILTIN, LED_BUILTIN_OFF);
@@ -292,11 +381,20 @@ void setup()   // --------------------------------------------------------------
     Timezone = atoi(s_TimezoneOffset);
    
     vz_http.init(vzHttpConfig);   // transfer data from config structure to main class
+    mqtt.init(mqttConfig, wifiAPssid);
+    influx.init(influxConfig, wifiAPssid);
+  }
+  if(vzQueue.begin())
+  {
+    vz_http.setQueue(&vzQueue);
   }
+  history.begin();                  // LittleFS is mounted by vzQueue
+  vz_http.setCompletionCallback(onPublishDone);
+  vz_http.setDeliveryCallback(onPublishDelivery);
 
   card_Title.update(wifiAPssid);
   card_status.update("Starting");
-  dashboard.sendUpdates();
+  dashUpdater.markDirty();
 
 
   // --- set time, callback for TimeLib to get the time, is called in given interval to sync
@@ -318,7 +416,7 @@ void setup()   // --------------------------------------------------------------
     card_status.update("entering loop");
     card_Time.update(s_DateTime);
     card_EpochTime.update(s_epochtime);
-    dashboard.sendUpdates();
+    dashUpdater.markDirty();
     lastDateUpdate = millis();
 
   if(MY_TEST)
@@ -340,27 +438,32 @@ void setup()   // --------------------------------------------------------------
 
   led.yellowOn();
     card_inverterStatus.update("Reading inverter ... ");
-    dashboard.sendUpdates();
+    dashUpdater.markDirty();
 
   if(!MY_TEST)
   {
     readInverter();   // we just read the inverter for the dash board, no http post
       card_inverterStatus.update("Reading inverter ... done");
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
   }
   led.yellowOff();
 
   DEBUG_TRACE(VERBOSE_LEVEL_Setup,"%s: Setup done.----------------------------------------------", s_DateTime);
     card_status.update("Setup done");
-    dashboard.sendUpdates();
+    dashUpdater.markDirty();
   digitalWrite(LED_BUILTIN, LED_BUILTIN_ON);
 
 }
 
 u32_t count=0;
 u32_t count10000;
+uint64_t loopTimeSum = 0;       // us, duration of all loops
+uint32_t loopTimeMax = 0;       // us, longest loop in current LOOP_STAT_INTERVAL
+uint32_t loopTimeMaxLast = 0;   // us, longest loop in last LOOP_STAT_INTERVAL
+uint32_t loopStatTime = 0;      // ms, start of current LOOP_STAT_INTERVAL
 void loop()                // -----------------------------------------------------------
 {
+  uint32_t loopStart = micros();
 	if (needReset)  // Doing a chip reset caused by config changes
 	{
 		DEBUG_TRACE(true,"Rebooting after 1 second.");
@@ -368,13 +471,23 @@ void loop()                // --------------------------------------------------
     led.yellowOn();
     led.blueOn();
        // post to volkszaehler
-    s_epochtime = String(getEpochTime());
-    vz_http.postHttp(String(confVZuuidInvHeartBeatParam.valueBuffer), s_epochtime, HEART_BEAT_RESET);
+    vz_http.publishValue(vzSRC_HEART_BEAT, getEpochTime(), HEART_BEAT_RESET);
+    vz_http.flushBatch(true);       // no delay to publish slot
+    uint32_t resetTime = millis();
+    while(!vz_http.isIdle() && ((millis() - resetTime) < 3000))  // let the transfer finish
+    {
+      vz_http.doLoop();
+      delay(10);
+    }
 		delay(1000);
 		ESP.restart();
 	}
 
   confWeb.doLoop();     // keep the configuration UI and the web server running.
+  for (uint8_t i=0;i<N_PUBLISHERS;i++)   // asynchronous transfer to volkszaehler (incl. queued values), MQTT, InfluxDB
+  {
+    publishers[i]->doLoop();
+  }
 
   // need to wait until WiFi connection is established.
   if(b_WiFi_connected)
@@ -390,7 +503,7 @@ void loop()                // --------------------------------------------------
 
           card_Time.update(s_DateTime);
           card_EpochTime.update(s_epochtime);
-          dashboard.sendUpdates();
+          dashUpdater.markDirty();
 
         uint32_t waitForTime = 0;   // just a loop for waiting, avoiding delay()
         while( (waitForTime < 10000) && (epochtime < 1672531200ULL) )  // 1672531200ULL = 2023-01-01
@@ -399,7 +512,8 @@ void loop()                // --------------------------------------------------
             waitForTime++;
         }
 
-        vz_http.postHttp(String(confVZuuidInvHeartBeatParam.valueBuffer), s_epochtime, HEART_BEAT_WIFI_CONFIG);
+        vz_http.publishValue(vzSRC_HEART_BEAT, epochtime, HEART_BEAT_WIFI_CONFIG);
+        vz_http.flushBatch();
         if(epochtime > 1672531200ULL)     // now we have a valid time
         {
           // here, we should have connection to ntp server and valid time
@@ -407,13 +521,6 @@ void loop()                // --------------------------------------------------
           setSyncProvider(getLocalTime);    // setting again will force TimeLib to sync with system time
           getDateTime(s_DateTime);
 
-          IPAddress result;
-          if (WiFi.hostByName(vzHttpConfig.vzServer, result))
-          {
-            vzServerIP = result.toString();
-            DEBUG_TRACE(true,"vzServerIP = %s",vzServerIP.c_str());
-          }
-
           DEBUG_TRACE(true,"%s: system time set",s_DateTime);
         }
       }
@@ -429,6 +536,7 @@ void loop()                // --------------------------------------------------
         publishInverterFrequentValues();
         publishInverterSeldomValues();      // values for day, month, year
         readDS18B20();
+        publishFlush();                     // one http request for all values of this cycle
       }
     }
   }
@@ -436,7 +544,10 @@ void loop()                // --------------------------------------------------
   
 // --- wait for next trigger ------------------------------------------------------------
 
-  led.blueOff();
+  if(vz_http.getFailingMask() == 0)   // blue led stays on while a volkszaehler channel is failing
+  {
+    led.blueOff();
+  }
   led.yellowOff();
 
     // update dash board
@@ -452,21 +563,21 @@ void loop()                // --------------------------------------------------
     s_epochtime = String(getEpochTime());
       card_Time.update(s_DateTime);
       card_EpochTime.update(s_epochtime);
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
 
     if(MY_TEST)
     {
-      vzTestValue = vz_http.getValue(vzTEST);
+      vzTestValue = vz_http.getTestValue();
       sprintf(myStringBuf,"%.5f",vzTestValue);
       card_energyLastYear.update(myStringBuf);    // show value on dash board
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
     }
     else
     {
-      // heart beat post to volkszaehler
+      // heart beat post to volkszaehler, sent together with the next publish cycle
       if ((count10000 != HEART_BEAT_RESET) && (count10000 != HEART_BEAT_WIFI_CONFIG))
       {
-        vz_http.postHttp(String(confVZuuidInvHeartBeatParam.valueBuffer), s_epochtime, count10000); // count10000 should fit into a float
+        vz_http.publishValue(vzSRC_HEART_BEAT, getEpochTime(), count10000); // count10000 should fit into a float
       }
     }
 
@@ -482,12 +593,162 @@ void loop()                // --------------------------------------------------
     DEBUG_TRACE(VERBOSE_LEVEL_Loop,"loop_count=%d", count/10000);
   }
   count++;
+  history.doLoop();           // checkpoint of the history
+  dashUpdater.doLoop();       // one dash board update for all cards changed in this loop
+
+  uint32_t loopTime = micros() - loopStart;   // loop statistics for /metrics
+  loopTimeSum += loopTime;
+  if(loopTime > loopTimeMax)
+  {
+    loopTimeMax = loopTime;
+  }
+  if((millis() - loopStatTime) > LOOP_STAT_INTERVAL)
+  {
+    loopStatTime = millis();
+    loopTimeMaxLast = loopTimeMax;
+    loopTimeMax = 0;
+  }
 
 //  delay(500);  // wait ms - avoid in loop() !!!
 
 //  digitalWrite(LED_BUILTIN, LED_BUILTIN_OFF);  // Pin2 = D4
 }
 
+// ##########################################################################################
+/* ***
+writeMetrics():
+  write metric group of Prometheus endpoint /metrics, see metrics.cpp.
+                called for group 0, 1, ... until it returns false; a group is written again if it did not fit into the
+                current chunk, so each group must be small (< 1 kB) and must not change any state.
+
+2026-10-18 mh
+- admission control of the web server
+- ETag hits of the start page
+- server-sent events; volkszaehler groups split, each group below METRICS_MAX_GROUP
+- compression of replay requests
+- first version
+
+*** */
+bool writeMetrics(uint8_t group, PromWriter& out)
+{
+  switch (group)
+  {
+  case 0:     // snapshot of last inverter poll
+    out.gauge("solis_snapshot_seq", "sequence number of last inverter poll", snapshot.seq);
+    out.gauge("solis_snapshot_timestamp_seconds", "UNIX time of last inverter poll", snapshot.timeStamp);
+    out.gauge("solis_inverter_reachable", "1 if inverter answered last poll", (uint32_t)Inverter.isInverterReachable());
+    out.gauge("solis_power_watts", "AC power", snapshot.power, 1);
+    out.gauge("solis_dc_voltage_volts", "DC voltage", snapshot.dcU, 1);
+    return true;
+  case 1:
+    out.gauge("solis_dc_current_amperes", "DC current", snapshot.dcI, 1);
+    out.gauge("solis_dc_power_watts", "DC power", snapshot.dcPower, 1);
+    out.gauge("solis_energy_today_kwh", "energy of today", snapshot.energyToday, 1);
+    out.gauge("solis_inverter_temperature_celsius", "inverter temperature", snapshot.temperatureInverter, 1);
+    return true;
+  case 2:     // energy counters of inverter, updated by seldom poll
+    out.gauge("solis_energy_last_day_kwh", "energy of last day", energyLastDay, 1);
+    out.gauge("solis_energy_this_month_kwh", "energy of this month", energyThisMonth, 0);
+    out.gauge("solis_energy_last_month_kwh", "energy of last month", energyLastMonth, 0);
+    out.gauge("solis_energy_this_year_kwh", "energy of this year", energyThisYear, 0);
+    out.gauge("solis_energy_last_year_kwh", "energy of last year", energyLastYear, 0);
+    return true;
+  case 3:     // DS18B20 and modbus
+#if(DS18B20)
+    out.gauge("solis_room_temperature_celsius", "DS18B20 temperature", ds18b20Temperature, 2);
+#endif
+    out.counter("solis_modbus_reads_total", "modbus register read requests", Inverter.getReadCount());
+    out.counter("solis_modbus_errors_total", "failed modbus register read requests", Inverter.getReadErrorCount());
+    return true;
+  case 4:     // volkszaehler transfer
+    out.counter("solis_http_requests_total", "http requests to volkszaehler", vz_http.getRequestCount());
+    out.counter("solis_http_connects_total", "tcp connection setups to volkszaehler", vz_http.getConnectCount());
+    out.counter("solis_http_reconnects_total", "requests repeated on a new connection", vz_http.getReconnectCount());
+    out.gauge("solis_http_latency_milliseconds", "duration of last request", vz_http.getLastLatency());
+    out.gauge("solis_http_latency_avg_milliseconds", "moving average of request duration", vz_http.getLatencyAvg());
+    return true;
+  case 5:     // volkszaehler adaptive batching
+    out.gauge("solis_http_error_rate", "moving average of failed requests", vz_http.getErrorRate() / 1000.0, 3);
+    out.gauge("solis_http_batch_target", "adaptive batch size in tuples", vz_http.getBatchTarget());
+    out.gauge("solis_http_flush_interval_seconds", "adaptive time a batch is held back", vz_http.getFlushInterval() / 1000);
+    out.gauge("solis_http_status", "response code of last request, negative: transport error", (float)httpStatus, 0);
+    return true;
+  case 6:     // volkszaehler queue and DNS
+    out.gauge("solis_queue_pending", "tuples in store-and-forward queue", vzQueue.count());
+    out.counter("solis_queue_dropped_total", "tuples dropped because queue was full", vzQueue.getDropCount());
+    out.counter("solis_dns_lookups_total", "DNS lookups of volkszaehler server", vz_http.getDnsLookupCount());
+    out.counter("solis_dns_failures_total", "failed DNS lookups", vz_http.getDnsFailCount());
+    return true;
+  case 7:     // volkszaehler replay of the queue
+    out.counter("solis_replay_plain_bytes_total", "body bytes of replay requests sent compressed, before compression", vz_http.getGzipInBytes());
+    out.counter("solis_replay_gzip_bytes_total", "body bytes of replay requests sent compressed, after compression", vz_http.getGzipOutBytes());
+    out.gauge("solis_replay_gzip_rejected", "1 if server rejected a compressed body", (uint32_t)vz_http.isGzipRejected());
+    out.gauge("solis_replay_duration_milliseconds", "duration of last complete replay of the queue", vz_http.getLastReplayTime());
+    return true;
+  case 8:     // all publishers
+  {
+    char label[32];
+    uint8_t i;
+    out.header("solis_publisher_bytes_total", "counter", "bytes passed to tcp by publisher");
+    for (i=0;i<N_PUBLISHERS;i++)
+    {
+      snprintf(label, sizeof(label), "publisher=\"%s\"", publishers[i]->getName());
+      out.sample("solis_publisher_bytes_total", publishers[i]->getBytesSent(), label);
+    }
+    out.header("solis_publisher_round_trips_total", "counter", "exchanges with server by publisher");
+    for (i=0;i<N_PUBLISHERS;i++)
+    {
+      snprintf(label, sizeof(label), "publisher=\"%s\"", publishers[i]->getName());
+      out.sample("solis_publisher_round_trips_total", publishers[i]->getRoundTrips(), label);
+    }
+    return true;
+  }
+  case 9:     // server-sent events
+    out.gauge("solis_sse_clients", "subscribers of server-sent events", (uint32_t)sse.getClientCount());
+    out.counter("solis_sse_rejected_total", "subscribers closed because of max clients", sse.getRejectCount());
+    out.counter("solis_sse_skipped_total", "events skipped because of slow subscribers", sse.getSkipCount());
+    out.gauge("solis_sse_render_microseconds", "time to format and queue last event", sse.getRenderTime());
+    return true;
+  case 10:    // system
+    out.gauge("solis_heap_free_bytes", "free heap", ESP.getFreeHeap());
+    out.gauge("solis_heap_max_block_bytes", "largest free heap block", ESP.getMaxFreeBlockSize());
+    out.gauge("solis_heap_fragmentation_percent", "heap fragmentation", (uint32_t)ESP.getHeapFragmentation());
+    out.gauge("solis_uptime_seconds", "time since boot", (uint32_t)(millis() / 1000));
+    return true;
+  case 11:    // dash board
+    out.counter("solis_dash_marks_total", "dash board card updates", dashUpdater.getMarkCount());
+    out.counter("solis_dash_flushes_total", "dash board messages sent", dashUpdater.getFlushCount());
+    return true;
+  case 12:    // history
+    out.gauge("solis_history_samples", "samples in history", history.getSampleCount());
+    out.gauge("solis_history_bytes", "bytes of encoded samples", history.getBytesUsed());
+    out.gauge("solis_history_oldest_timestamp_seconds", "UNIX time of oldest sample", history.getOldestTime());
+    out.gauge("solis_history_query_microseconds", "duration of last query", history.getLastQueryTime());
+    out.gauge("solis_history_export_rows", "rows of last history export", getHistoryExportRows());
+    out.gauge("solis_history_export_heap_min_bytes", "lowest free heap during last history export", getHistoryExportHeapMin());
+    return true;
+  case 13:    // web pages
+    out.counter("solis_page_not_modified_total", "start page requests answered by 304 Not Modified", getHttpCacheHits());
+    out.counter("solis_page_sent_total", "start page requests answered with the page", getHttpCacheMisses());
+    return true;
+  case 14:    // admission control of the web server
+    out.gauge("solis_web_active_requests", "requests in progress", (uint32_t)admission.getActive());
+    out.gauge("solis_web_active_requests_max", "peak of requests in progress", (uint32_t)admission.getMaxActive());
+    out.counter("solis_web_admitted_total", "requests passed to a handler", admission.getAdmitCount());
+    out.counter("solis_web_rejected_busy_total", "requests rejected by 503, max requests in progress", admission.getBusyCount());
+    out.counter("solis_web_rejected_heap_total", "requests rejected by 503, low heap", admission.getHeapCount());
+    out.counter("solis_web_rejected_rate_total", "requests rejected by 429, rate limit of client", admission.getRateCount());
+    return true;
+  default:    // loop timing and last scrape
+    out.counter("solis_loop_iterations_total", "number of loop() calls", count);
+    out.counter("solis_loop_time_milliseconds_total", "time spent in loop()", (uint32_t)(loopTimeSum / 1000));
+    out.gauge("solis_loop_time_max_microseconds", "longest loop() in last minute", loopTimeMaxLast);
+    out.gauge("solis_metrics_render_microseconds", "time to render last scrape", getMetricsRenderTime());
+    out.gauge("solis_metrics_heap_min_bytes", "lowest free heap during last scrape", getMetricsHeapMin());
+    return false;
+  }
+}
+
 // ##########################################################################################
 /* ***
 readInverter()
@@ -568,7 +829,7 @@ void readInverter()
     led.blueOn();
       card_inverterStatus.update(s_inverterStatus, "danger");
   }
-  dashboard.sendUpdates();
+  dashUpdater.markDirty();
 
   DEBUG_TRACE(VERBOSE_LEVEL_InverterData, "Inverter Status: %s", s_inverterStatus);
 
@@ -583,6 +844,9 @@ publishInverterFrequentValues():
   The function calls readInverter() to get all the inverter data from the hardware into global variables.
   The values for frequent updates are published to dash board and to http server then.
 
+2026-10-18 mh
+- values are collected in a snapshot, which is handed to all publishers
+
 2023-02-01 M. Herbert
 - first version, code carved out from loop()
 
@@ -593,17 +857,19 @@ void publishInverterFrequentValues()
   if (ticker.getInverterFrequentFlag() == true)           // ------- frequent read
   {
     ticker.setInverterFrequentFlagToFalse();
+    publishCycle = true;
     led.yellowOn();
 
     getDateTime(s_DateTime);
     epochtime = getEpochTime();
     s_epochtime = String(epochtime);
 
-    s_timeStamp = String(epochtime - (epochtime % INVERTER_READ_INTERVAL_FREQUENT)); // allign to full intervals
+    uint32_t timeStamp = epochtime - (epochtime % INVERTER_READ_INTERVAL_FREQUENT); // allign to full intervals
+    s_timeStamp = String(timeStamp);
       card_inverterStatus.update("Reading inverter","idle");
       card_Time.update(s_DateTime);
       card_EpochTime.update(s_timeStamp);
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
 
     DEBUG_TRACE(VERBOSE_LEVEL_Inverter,"%s",s_DateTime);
 
@@ -611,15 +877,18 @@ void publishInverterFrequentValues()
 
     if(Inverter.isInverterReachable() == true)
     {
-      // post to volkszaehler
-      vz_http.postHttp(String(confVZuuidInvPowParam.valueBuffer), s_timeStamp, power);
-      vz_http.postHttp(String(confVZuuidInvDCUParam.valueBuffer), s_timeStamp, dc_u);
-      vz_http.postHttp(String(confVZuuidInvDCIParam.valueBuffer), s_timeStamp, dc_i);
-      vz_http.postHttp(String(confVZuuidInvDCPowParam.valueBuffer), s_timeStamp, dc_i*dc_u);
-    }
-    if((Inverter.isInverterReachable() == true) && (200 == httpStatus)) 
-    {
-      led.yellowOff();
+      snapshot.seq++;
+      snapshot.timeStamp = timeStamp;
+      snapshot.power = power;
+      snapshot.dcU = dc_u;
+      snapshot.dcI = dc_i;
+      snapshot.dcPower = dc_i*dc_u;
+      snapshot.energyToday = energyToday;
+      snapshot.temperatureInverter = temperature;
+#if(DS18B20)
+      snapshot.temperatureRoom = ds18b20Temperature;
+#endif
+      publishSnapshot();    // volkszaehler values are sent by publishFlush()
     }
     else
     {
@@ -628,6 +897,88 @@ void publishInverterFrequentValues()
   }
 }
 
+// ##########################################################################################
+/* ***
+publishSnapshot():  
+  hand the snapshot of the current poll to the history and all publishers (volkszaehler, MQTT, InfluxDB, SSE).
+
+2026-10-18 mh
+- history
+- first version
+
+*** */
+void publishSnapshot()
+{
+  history.add(snapshot);
+  updateCharts();
+  for (uint8_t i=0;i<N_PUBLISHERS;i++)
+  {
+    publishers[i]->publish(snapshot);
+  }
+  for (uint8_t i=0;i<N_PUBLISHERS;i++)
+  {
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"snapshot %u: %s %u bytes, %u round trips",snapshot.seq,
+                publishers[i]->getName(),publishers[i]->getBytesSent(),publishers[i]->getRoundTrips());
+  }
+}
+
+// ##########################################################################################
+/* ***
+updateCharts():  
+  add the snapshot to the downsamplers of the charts and update the charts on the dash board.
+                power of today: average per bucket; at the start of a day (and after a reboot) the buckets are
+                refilled from the history. energy of the last days: max of energy today per day.
+                the charts always have CHART_TODAY_BUCKETS / CHART_DAYS bars; the labels of the days are only
+                updated when the window moves to a new day.
+
+2026-10-18 mh
+- first version
+
+*** */
+void updateCharts()
+{
+  uint32_t localTime = snapshot.timeStamp + Timezone * 3600;
+  uint32_t dayStart = localTime - (localTime % 86400);
+  if(chartTodayX[0].length() == 0)
+  {
+    for (uint8_t i=0;i<CHART_TODAY_BUCKETS;i++)
+    {
+      uint32_t t = powerToday.getBucketStart(i);
+      snprintf(myStringBuf, sizeof(myStringBuf), "%02u:%02u", (t / 3600) % 24, (t / 60) % 60);
+      chartTodayX[i] = myStringBuf;
+    }
+    chart_powerToday.updateX(chartTodayX, CHART_TODAY_BUCKETS);
+  }
+  if(powerToday.getStart() != dayStart)       // new day or first poll after reboot
+  {
+    powerToday.reset(dayStart);
+    history.query(dayStart - Timezone * 3600, snapshot.timeStamp, [](const HistorySample& sample)
+    {
+      powerToday.add(sample.timeStamp + Timezone * 3600, sample.value[histPOWER]);
+    });
+  }
+  else
+  {
+    powerToday.add(localTime, snapshot.power);
+  }
+  powerToday.getAvgValues(chartY);
+  chart_powerToday.updateY(chartY, CHART_TODAY_BUCKETS);
+
+  uint32_t daysStart = energyDays.getStart();
+  energyDays.add(localTime, snapshot.energyToday);
+  if(energyDays.getStart() != daysStart)      // window moved to a new day
+  {
+    for (uint8_t i=0;i<CHART_DAYS;i++)
+    {
+      chartDaysX[i] = day(energyDays.getBucketStart(i));
+    }
+    chart_energyDays.updateX(chartDaysX, CHART_DAYS);
+  }
+  energyDays.getMaxValues(chartY);
+  chart_energyDays.updateY(chartY, CHART_DAYS);
+  dashUpdater.markDirty();
+}
+
 // ##########################################################################################
 /* ***
 publishInverterSeldomValues():  
@@ -637,6 +988,9 @@ publishInverterSeldomValues():
                 yellow and blue led is switched on if inverter was not reachable.
                 assumption: global variables are up-to-date, i.e. set previously by publishInverterFrequentValues()
 
+2026-10-18 mh
+- values are passed to the channel registry by source; energy today is sent from the snapshot
+
 2023-01-31 M. Herbert
 - first version, code carved out from loop()
 
@@ -646,6 +1000,7 @@ void publishInverterSeldomValues()
   if (ticker.getInverterSeldomFlag() == true)                // ------- seldom read
   {
     ticker.setInverterSeldomFlagToFalse();
+    publishCycle = true;
     
     DEBUG_TRACE(VERBOSE_LEVEL_Inverter,"%s  ******  seldom part  ******",s_DateTime);
 
@@ -655,73 +1010,151 @@ void publishInverterSeldomValues()
     epochtime = getEpochTime();
     s_epochtime = String(epochtime);
     
-    s_timeStamp = String(epochtime - (epochtime % INVERTER_READ_INTERVAL_SELDOM)); // allign to full intervals
+    uint32_t timeStamp = epochtime - (epochtime % INVERTER_READ_INTERVAL_SELDOM); // allign to full intervals
+    s_timeStamp = String(timeStamp);
       card_inverterStatus.update("Reading inverter seldom","idle");
       card_Time.update(s_DateTime);
       card_EpochTime.update(s_timeStamp);
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
 
     if (Inverter.isInverterReachable() == true)
     {
-      httpStatus=vz_http.postHttp(String(confVZuuidInvEnThisDayParam.valueBuffer), s_timeStamp, energyToday);
-    }
-    if((Inverter.isInverterReachable() == true) && (200 == httpStatus)) 
-    {
-      led.yellowOff();  // transfer ok
-    }
-    else
-    {
-      led.blueOn();
-    }  
-  
-    // post lastDay to volkszaehler daily
-    if(lastDay != Day)            // ------- daily is enough
-    {
-      led.yellowOn();
-
-      if (Inverter.isInverterReachable() == true)
+      // energy today is a snapshot source, sent by the channel interval (default VZ_INTERVAL_ENERGY_TODAY)
+      // post lastDay to volkszaehler daily; lastDay is updated by onPublishDelivery() when sent or queued
+      if((lastDay != Day) && (pendingDay != Day))   // ------- daily is enough
       {
-        httpStatus=vz_http.postHttp(String(confVZuuidInvEnLastDayParam.valueBuffer), s_timeStamp, energyLastDay);
-        if (200 == httpStatus)    // transfer ok
+        if(vz_http.publishValue(vzSRC_ENERGY_LASTDAY, timeStamp, energyLastDay))
         {
-          lastDay = Day;
-          led.yellowOff();
+          pendingDay = Day;
         }
         else
         {
-          led.blueOn();
+          lastDay = Day;            // no channel for this source
         }
       }
-      else
-      {
-        led.blueOn();
-      }
-
-    }
-    // post to volkszaehler monthly
-    if(lastMonth != Month)             // ------- monthly, is enough
-    {
-      led.yellowOn();
-
-      if (Inverter.isInverterReachable() == true)
+      // post to volkszaehler monthly
+      if((lastMonth != Month) && (pendingMonth != Month))   // ------- monthly, is enough
       {
-        httpStatus = vz_http.postHttp(String(confVZuuidInvEnLastMonthParam.valueBuffer), s_timeStamp, energyLastMonth);
-        if (200 == httpStatus)   // transfer ok
+        if(vz_http.publishValue(vzSRC_ENERGY_LASTMONTH, timeStamp, energyLastMonth))
         {
-          lastMonth = Month;
-          led.yellowOff();
+          pendingMonth = Month;
         }
         else
         {
-          led.blueOn();
+          lastMonth = Month;
         }
       }
-      else
+    }
+    else
+    {
+      led.blueOn();
+    }
+  }
+}
+
+// ##########################################################################################
+/* ***
+publishFlush():  
+  send the tuples collected by the publish functions of this cycle with one http request.
+                the transfer is done in the background, see onPublishDone().
+                yellow led is switched on until the transfer is finished.
+
+2026-10-18 mh
+- lastDay and lastMonth are confirmed by onPublishDelivery()
+- batch may be held back by adaptive batching, yellow led only if passed to transfer
+- first version, replaces the single posts of the publish functions
+- asynchronous transfer
+
+*** */
+void publishFlush()
+{
+  if(!publishCycle)
+  {
+    return;
+  }
+  publishCycle = false;
+  if(vz_http.getBatchCount() == 0)
+  {
+    return;
+  }
+
+  vz_http.flushBatch();       // accepted for transfer, held back by adaptive batching or stored in queue
+  if(vz_http.getBatchCount() == 0)
+  {
+    led.yellowOn();           // batch passed to transfer
+  }
+}
+
+// ##########################################################################################
+/* ***
+onPublishDelivery():  
+  called by vz_http when the fate of a batch is known.
+                sourceMask: bit (1 << VzSource) for each source with tuples in the batch.
+                saved: true if answered with 2xx or stored in the queue, false if dropped (4xx, no queue).
+                lastDay and lastMonth are confirmed if saved, otherwise the value is published again.
+
+2026-10-18 mh
+- first version
+
+*** */
+void onPublishDelivery(uint16_t sourceMask, bool saved)
+{
+  if(sourceMask & (1 << vzSRC_ENERGY_LASTDAY))
+  {
+    if(saved)
+    {
+      lastDay = pendingDay;
+    }
+    pendingDay = 100;
+  }
+  if(sourceMask & (1 << vzSRC_ENERGY_LASTMONTH))
+  {
+    if(saved)
+    {
+      lastMonth = pendingMonth;
+    }
+    pendingMonth = 100;
+  }
+}
+
+// ##########################################################################################
+/* ***
+onPublishDone():  
+  called by vz_http.doLoop() when the transfer of a batch is finished.
+                httpResponseCode: http status code or negative transport error.
+                led and dash board card show the failing channels from the statistics of vz_http,
+                blue led is on while a channel is failing; failed values are queued by vz_http.
+
+2026-10-18 mh
+- led and card driven by the outcome statistics per channel
+- first version
+
+*** */
+void onPublishDone(int httpResponseCode)
+{
+  httpStatus = httpResponseCode;
+  led.yellowOff();
+  uint16_t failing = vz_http.getFailingMask();
+  if (failing == 0)         // last request of each channel ok
+  {
+    snprintf(myStringBuf, sizeof(myStringBuf), "%u channels ok", __builtin_popcount(vz_http.getSendMask()));
+    card_vzChannels.update(myStringBuf, "success");
+  }
+  else
+  {
+    led.blueOn();
+    FmtBuf text(myStringBuf, sizeof(myStringBuf));
+    text.add("failing:");
+    for (uint8_t i=0;i<VZ_MAX_CHANNELS;i++)
+    {
+      if(failing & (1 << i))
       {
-        led.blueOn();
+        text.add(' ').addUint(i + 1);
       }
     }
+    card_vzChannels.update(text.c_str(), "danger");
   }
+  dashUpdater.markDirty();
 }
 
 // ##########################################################################################
@@ -730,6 +1163,9 @@ readDS18B20():
 - read temperature sensor DS18B20 based on ticker event and send data to Dash Board and http server
 - blue led is switched on during execution.
 
+2026-10-18 mh
+- temperature passed to the channel registry as source vzSRC_TEMP_ROOM
+
 2023-01-31 M. Herbert
 - first version, code carved out from loop()
 
@@ -742,21 +1178,22 @@ void readDS18B20()
   {
     led.blueOn();
     readDS18B20firstTime = false;
+    publishCycle = true;
     epochtime=getEpochTime();
     s_timeStamp = String(epochtime - (epochtime % DS18B20_READ_INTERVAL)); // allign to full intervals
       card_status.update("1st get started");
       card_Time.update(s_DateTime);
       card_EpochTime.update(s_timeStamp);
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
 
     // Read DS18B20 - first time including additional Info on serial monitor
     ds18b20Temperature = ds18b20.getTempSensorType();  
       card_temperatureDS18B20.update(ds18b20Temperature);
       card_status.update("1st get done");
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
 
     // post to volkszaehler
-    vz_http.postHttp(String(confVZuuidTemp6Param.valueBuffer), s_timeStamp, ds18b20Temperature);
+    vz_http.publishValue(vzSRC_TEMP_ROOM, epochtime - (epochtime % DS18B20_READ_INTERVAL), ds18b20Temperature);
 
     led.blueOff();
   }
@@ -767,8 +1204,9 @@ void readDS18B20()
     led.blueOn();
 
     ticker.setDS18B20FlagToFalse();
+    publishCycle = true;
       card_status.update("updating ....","success");
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
     
     // --- read DS18B20 ---------------------------------------------------------------------
      ds18b20Temperature = ds18b20.getTemperature();
@@ -779,10 +1217,10 @@ void readDS18B20()
     DEBUG_TRACE(VERBOSE_LEVEL_Temperature,"%s temperature: %.2f",s_DateTime, ds18b20Temperature);
   
     // post to volkszaehler
-    vz_http.postHttp(String(confVZuuidTemp6Param.valueBuffer), s_timeStamp, ds18b20Temperature);
+    vz_http.publishValue(vzSRC_TEMP_ROOM, epochtime - (epochtime % DS18B20_READ_INTERVAL), ds18b20Temperature);
       card_temperatureDS18B20.update(ds18b20Temperature);
       card_EpochTime.update(s_timeStamp);
-      dashboard.sendUpdates();
+      dashUpdater.markDirty();
     
     led.blueOff();
   }
@@ -804,6 +1242,18 @@ void configSaved()
 }
 // ##########################################################################################
 
+bool formValidator(WebRequestWrapper* webRequestWrapper)
+//
+// formValidator() callback handler for confWeb, checks the posted values before they are saved.
+//
+// 2026-10-18 mh
+// - UUIDs of the channel registry
+// - first version: UUIDs must be 8-4-4-4-12 hex digits or VZ_UUID_NO_SEND
+{
+  return validateChannelParameters(webRequestWrapper);
+}
+// ##########################################################################################
+
 void wifiConnected()
 {
   digitalWrite(LED_BUILTIN, LED_BUILTIN_OFF);
@@ -814,11 +1264,13 @@ void wifiConnected()
   b_WiFi_connected = true;
 }
 // ##########################################################################################
+const char NOT_FOUND_HTML[] PROGMEM =
+  "<div style='padding-top:25px;'><b>NotFoundHandler: Page not found</b></div>"
+  "<div style='padding-top:25px;'><a href='/start'>Return to Start Page '/start'</a></div>";
+
 void notFound(AsyncWebServerRequest *request)
 {
-  String _content = "<div style='padding-top:25px;'><b>NotFoundHandler: Page not found</b></div>";
-  _content += "<div style='padding-top:25px;'><a href='/start'>Return to Start Page '/start'</a></div>";
-  request->send(404, "text/html", _content);
+  request->send_P(404, "text/html", NOT_FOUND_HTML);
 }
 // ##########################################################################################
 // request handler for /reset
@@ -847,8 +1299,6 @@ void startHtml(AsyncWebServerRequest *request)
 // (C) M. Herbert, 2022.
 // Licensed under the GNU General Public License v3.0
 {
-  String	content;
-
   if(b_WiFi_connected)
   {
     currentHtmlPage = "Local Net Start Page";
@@ -858,9 +1308,7 @@ void startHtml(AsyncWebServerRequest *request)
     currentHtmlPage = "Access Point Start Page";    
   }
 
-  homePage(content);
-  request->send(200, "text/html; charset=UTF-8", content);
-
+  sendHomePage(request);
 }
 // ##########################################################################################
 void onConfiguration(AsyncWebServerRequest *request)
@@ -892,8 +1340,6 @@ void handleRoot(AsyncWebServerRequest *request)
 // (C) M. Herbert, 2023.
 // Licensed under the GNU General Public License v3.0
 {
-  String	content;
-
   if(b_WiFi_connected)
   {
     currentHtmlPage = "Local Net Start Page";
@@ -903,12 +1349,17 @@ void handleRoot(AsyncWebServerRequest *request)
     currentHtmlPage = "Access Point Start Page";    
   }
 
-  homePage(content);
-  request->send(200, "text/html; charset=UTF-8", content);
+  sendHomePage(request);
 }
 // ##########################################################################################
 //
-// homePage() compose a html home page
+// sendHomePage() send the html home page
+//
+// 2026-10-18 mh
+// - sent by a response filler (HtmlTemplate::fill()), no String of the whole page
+// - static parts from PROGMEM (HOME_PAGE_HTML), values filled in one pass by HtmlTemplate
+// - ETag of the values shown, 304 Not Modified for a repeated request
+// - IP of VZ server from DNS cache of vz_http
 //
 // 2023-02-01 mh
 // - version for SolisLogger
@@ -923,99 +1374,150 @@ void handleRoot(AsyncWebServerRequest *request)
 // Licensed under the GNU General Public License v3.0
 //
 // global variables used:
-//  currentSSID, currentIP, currentHtmlPage, wifiAPssid, vzServerIP
-void homePage(String& _content)
+//  currentSSID, currentIP, currentHtmlPage, wifiAPssid, vz_http
+const char HOME_PAGE_HTML[] PROGMEM =
+  "<!DOCTYPE html><html lang=\"en\"><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1, user-scalable=no\"/><title>{t}</title>"
+  "</head><body>"
+  "<h1 style='padding-top:25px;'>Welcome to {t} Site</h1></a></div>"
+  "You are connected to  <b>{s}</b> with IP {i}"
+  "<p> VZ-Server <b>{n}</b> with IP {a}</p>"
+  "<h2 style='padding-top:25px;'>{p}</h2></a></div>"
+  "<div style='padding-top:25px;'><a href='/start'>Return to Start Page</a></div>"
+  "<div style='padding-top:25px;'><a href='/config'>Configuration Page</a></div>"
+  "<div style='padding-top:25px;'><a href='/'>Dash Board</a></div>"
+  "<div style='padding-top:25px;'><a href='/reset'>Reset ESP</a></div>\n"
+  "<div style='padding-top:25px;font-size: .6em;'>Version {v} {d}</div>"
+  "</div></body></html>";
+
+void sendHomePage(AsyncWebServerRequest *request)
 {
-  #define MY_HTML_HEAD 		"<!DOCTYPE html><html lang=\"en\"><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1, user-scalable=no\"/><title>{t}</title>"
-  #define MY_HTML_HEAD_END 	"</head><body>"
-  #define MY_HTML_END 		"</div></body></html>"
-  #define MY_HTML_HEADLINE		"<h1 style='padding-top:25px;'>Welcome to {h} Site</h1></a></div>"
-  #define MY_HTML_START		"<div style='padding-top:25px;'><a href='/start'>Return to Start Page</a></div>"
-  #define MY_HTML_CONFIG	"<div style='padding-top:25px;'><a href='/config'>Configuration Page</a></div>"
-  #define MY_HTML_DASH		"<div style='padding-top:25px;'><a href='/'>Dash Board</a></div>"
-  #define MY_RESET_HTML		"<div style='padding-top:25px;'><a href='/reset'>Reset ESP</a></div>\n"
-  #define MY_HTML_CONFIG_VER "<div style='padding-top:25px;font-size: .6em;'>Version {v} {d}</div>"
-
-
-  _content = MY_HTML_HEAD;
-  _content += MY_HTML_HEAD_END;
-  _content.replace("{t}", wifiAPssid);
-  _content += MY_HTML_HEADLINE;
-  _content.replace("{h}", wifiAPssid);
-  _content += "You are connected to  <b>" + currentSSID + "</b> with IP " + currentIP;
-  _content += "<p> VZ-Server <b>" + String(vzHttpConfig.vzServer) + "</b> with IP " + vzServerIP +"</p>";
-  _content += "<h2 style='padding-top:25px;'>" + currentHtmlPage + "</h2></a></div>";
-  _content += MY_HTML_START;
-  _content += MY_HTML_CONFIG;
-  _content += MY_HTML_DASH;
-  _content += MY_RESET_HTML;
-  _content += MY_HTML_CONFIG_VER;
-  _content.replace("{v}", WIFI_AP_CONFIG_VERSION);
-  _content.replace("{d}", MY_VERSION_TYPE);
-  _content += MY_HTML_END;
+  static HtmlTemplate homeTemplate(HOME_PAGE_HTML);
+  struct HomePageValues     // copies, the values must not change while the page is sent
+  {
+    String title, ssid, ip, server, serverIP, page;
+    void getArgs(HtmlTemplateArg* args) const
+    {
+      args[0] = {'t', title.c_str(), true};
+      args[1] = {'s', ssid.c_str(), true};
+      args[2] = {'i', ip.c_str(), false};
+      args[3] = {'n', server.c_str(), true};
+      args[4] = {'a', serverIP.c_str(), false};
+      args[5] = {'p', page.c_str(), false};
+      args[6] = {'v', WIFI_AP_CONFIG_VERSION, false};
+      args[7] = {'d', MY_VERSION_TYPE, false};
+    }
+  };
+  const size_t argCount = 8;
+  HomePageValues values = {wifiAPssid, currentSSID, currentIP, vzHttpConfig.vzServer, vz_http.getServerIP(), currentHtmlPage};
+  HtmlTemplateArg args[argCount];
+  values.getArgs(args);
+
+  char etag[ETAG_SIZE];
+  uint32_t hash = etagSeed();
+  size_t i;
+  for (i=0;i<argCount;i++)
+  {
+    hash = etagHash(hash, args[i].value);
+  }
+  etagFormat(hash, etag);
+  if(sendNotModified(request, etag))
+  {
+    return;
+  }
 
+  // literals are copied from PROGMEM straight into the send buffer, the page is never built in RAM
+  AsyncWebServerResponse *response = request->beginResponse("text/html; charset=UTF-8", homeTemplate.getLength(args, argCount),
+    [values](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+    {
+      HtmlTemplateArg args[argCount];
+      values.getArgs(args);
+      return homeTemplate.fill(buffer, maxLen, args, argCount, index);
+    });
+  addRevalidateHeaders(response, etag);
+  request->send(response);
 }
 // ##########################################################################################
 //
-// buildResponse() compose data for json transfer
+// sendApiJson() send data in json format
 //
-// used to handle requests to /api/all.json and /api/power.json
+// used to handle requests to /api/power.json (type 0), /api/all.json (type 1) and /api/v2/snapshot.json (type 2)
+//
+// 2026-10-18 mh
+// - written by JsonWriter into an AsyncResponseStream instead of String concatenation, numbers in fixed point
+// - sequence number and timestamp of the snapshot
+// - type 2: all decoded values, grouped
 //
 // unchanged from Solis4Gmini-logger 2023-02-01 mh
 //
-String buildResponse(byte type)
+void sendApiJson(AsyncWebServerRequest *request, byte type)
 {
-  String str;
+  AsyncResponseStream* response = request->beginResponseStream("application/json", API_JSON_SIZE);
+  JsonWriter json(*response);
 
   switch (type)
   {
 
   case 0: // Only return power
-    str = "{";
-    str += "\"power\": ";
-    str += String(power);
-    str += ",\"energyToday\": ";
-    str += String(energyToday);
-    str += ",\"isOnline\": ";
-    str += String(Inverter.isInverterReachable());
-    str += "}";
+    json.beginObject();
+    json.add("seq", snapshot.seq).add("ts", snapshot.timeStamp);
+    json.add("power", power, 2);
+    json.add("energyToday", energyToday, 2);
+    json.add("isOnline", (uint32_t)Inverter.isInverterReachable());
+    json.endObject();
     break;
 
   case 1: // Return all data
-    str = "{";
-    str += "\"power\": ";
-    str += String(power);
-    str += ",\"energyToday\": ";
-    str += String(energyToday);
-    str += ",\"isOnline\": ";
-    str += String(Inverter.isInverterReachable());
-
-    str += ",\"dc_u\": ";
-    str += String(dc_u);
-    str += ",\"dc_i\": ";
-    str += String(dc_i);
-
-    str += ",\"ac_u\": ";
-    str += String(ac_u);
-    str += ",\"ac_i\": ";
-    str += String(ac_i);
-    str += ",\"ac_f\": ";
-    str += String(ac_f);
+    json.beginObject();
+    json.add("seq", snapshot.seq).add("ts", snapshot.timeStamp);
+    json.add("power", power, 2);
+    json.add("energyToday", energyToday, 2);
+    json.add("isOnline", (uint32_t)Inverter.isInverterReachable());
+
+    json.add("dc_u", dc_u, 2);
+    json.add("dc_i", dc_i, 2);
+
+    json.add("ac_u", ac_u, 2);
+    json.add("ac_i", ac_i, 2);
+    json.add("ac_f", ac_f, 2);
 
 #if(DS18B20)
-    str += ",\"ds18b20Temperature\": ";
-    str += String(ds18b20Temperature);
+    json.add("ds18b20Temperature", ds18b20Temperature, 2);
 #endif
-    str += "}";
+    json.endObject();
     break;
 
+  case 2: // all decoded values of the inverter
+  {
+    float totalEnergy;
+    Inverter.getTotalEnergy(&totalEnergy);
+    json.beginObject();
+    json.add("seq", snapshot.seq).add("ts", snapshot.timeStamp).add("now", (uint32_t)getEpochTime());
+    json.add("online", Inverter.isInverterReachable()).add("status", s_inverterStatus);
+    json.add("power", power, 1);
+    json.beginObject("dc").add("u", dc_u, 1).add("i", dc_i, 2).add("p", DCpower, 1).endObject();
+    json.beginObject("ac").add("u", ac_u, 1).add("i", ac_i, 2).add("f", ac_f, 2).endObject();
+    json.beginObject("energy");
+    json.add("today", energyToday, 1).add("lastDay", energyLastDay, 1);
+    json.add("thisMonth", energyThisMonth, 0).add("lastMonth", energyLastMonth, 0);
+    json.add("thisYear", energyThisYear, 0).add("lastYear", energyLastYear, 0);
+    json.add("total", totalEnergy, 0);
+    json.endObject();
+    json.beginObject("temperature").add("inverter", temperature, 1);
+#if(DS18B20)
+    json.add("room", ds18b20Temperature, 2);
+#endif
+    json.endObject();
+    json.endObject();
+    break;
+  }
 
   default:
-    str = "Function not supported";
+    response->setCode(404);
+    response->print("Function not supported");
     break;
   }
 
-  return str;
+  request->send(response);
 }
 // ##########################################################################################
 // time helper functions
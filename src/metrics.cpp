@@ -0,0 +1,83 @@
+// metrics.cpp
+//
+// Prometheus pull endpoint, streamed in chunks without building a String
+//
+// 2026-10-18 mh
+// - groups written into the chunks by MetricsStream (promWriter.cpp)
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Provides the values of the logger in Prometheus text format, e.g. at http://<localIP>/metrics.
+
+** Usage **
+addMetricsHandler(server, "/metrics", [](uint8_t group, PromWriter& out)
+{
+  switch (group)
+  {
+  case 0:
+    out.gauge("solis_power_watts", "AC power", power, 1);
+    return true;                      more groups follow
+  default:
+    out.counter("solis_modbus_reads_total", "modbus read requests", readCount);
+    return false;                     last group
+  }
+});
+
+** Implementation **
+The response is sent with chunked transfer encoding. Each time AsyncWebServer asks for the next chunk, a MetricsStream
+(promWriter.cpp) writes the metric groups of the user function straight into the tcp send buffer as long as a whole
+group fits; a group which does not fit anymore is written again into the next chunk. So no String is built and the
+memory needed does not depend on the number of metrics.
+The duration of rendering and the lowest free heap during the last scrape are available by getMetricsRenderTime()
+and getMetricsHeapMin().
+  *** end description *** */
+
+#include <Arduino.h>
+#include "metrics.h"
+
+static uint32_t renderTime = 0;     // us, last scrape
+static uint32_t heapMin = 0;        // bytes, last scrape
+
+void addMetricsHandler(AsyncWebServer& server, const char* uri, MetricsWriter writer)
+{
+  server.on(uri, HTTP_GET, [writer](AsyncWebServerRequest *request)
+  {
+    MetricsStream stream(writer);
+    uint32_t time = 0;
+    uint32_t heap = ESP.getFreeHeap();
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain; version=0.0.4; charset=utf-8",
+      [stream, time, heap](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      {
+        uint32_t start = micros();
+        size_t len = stream.fill(buffer, maxLen);
+        uint32_t freeHeap = ESP.getFreeHeap();
+        if(freeHeap < heap)
+        {
+          heap = freeHeap;
+        }
+        time += micros() - start;
+        if(len == 0)              // end of response
+        {
+          renderTime = time;
+          heapMin = heap;
+        }
+        return len;
+      });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+  });
+}
+
+uint32_t getMetricsRenderTime()
+{
+  return renderTime;
+}
+
+uint32_t getMetricsHeapMin()
+{
+  return heapMin;
+}
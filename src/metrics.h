@@ -0,0 +1,18 @@
+#ifndef METRICS_H
+#define METRICS_H
+//
+// 2026-10-18 mh
+// - PromWriter and chunk filler in promWriter.h
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "promWriter.h"
+
+void addMetricsHandler(AsyncWebServer& server, const char* uri, MetricsWriter writer);
+uint32_t getMetricsRenderTime();
+uint32_t getMetricsHeapMin();
+#endif // METRICS_H
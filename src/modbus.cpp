@@ -1,5 +1,8 @@
 // modbus.cpp for Solis Inverter Status Register Readout
 //
+// 2026-10-18 mh
+// - counters of register reads and failed reads
+//
 // 2023-01-30 mh
 // - clean up of include structure
 //
@@ -94,6 +97,23 @@ bool _softRun = true;
 bool reachable = false;
 bool reachable_flag__lst = true;
 
+uint32_t _readCount = 0;        // register read requests
+uint32_t _readErrorCount = 0;   // failed register read requests
+
+/*
+Read input registers and count requests and failures
+*/
+static uint8_t readRegisters(uint16_t address, uint16_t quantity)
+{
+    uint8_t result = node.readInputRegisters(address, quantity);
+    _readCount++;
+    if (result != node.ku8MBSuccess)
+    {
+        _readErrorCount++;
+    }
+    return result;
+}
+
 inverter::inverter()
 {
 }
@@ -126,7 +146,7 @@ uint8_t inverter::requestAll()
     do
     {
         // note: read buffer has 64 16bit words, recommend max read length is 50 words.
-        result = node.readInputRegisters(3004, 40);                  // read all registers, first is 3005
+        result = readRegisters(3004, 40);                  // read all registers, first is 3005
         if (result == node.ku8MBSuccess)
         {
             _power = node.getResponseBuffer(0x01);                  // 3006: active power low word in W
@@ -203,7 +223,7 @@ uint8_t inverter::requestPower()
     {  
         result_or = node.ku8MBSuccess;
         inverterOffCounter=0;
-        result = node.readInputRegisters(3004, 4);             // read 4 registers, first is 3005
+        result = readRegisters(3004, 4);             // read 4 registers, first is 3005
         result_or |= result;
         if (result == node.ku8MBSuccess)
         {
@@ -218,7 +238,7 @@ uint8_t inverter::requestPower()
             _DCpower = 0.0;
         }
 
-        result = node.readInputRegisters(3014, 2);
+        result = readRegisters(3014, 2);
         result_or |= result;
         if (result == node.ku8MBSuccess)
         {
@@ -234,7 +254,7 @@ uint8_t inverter::requestPower()
         }
         delay(MODBUS_READ_DELAY);
 
-        result = node.readInputRegisters(3021, 2);              // DC voltage1, current1  in 0.1V/A
+        result = readRegisters(3021, 2);              // DC voltage1, current1  in 0.1V/A
         result_or |= result;
         if (result == node.ku8MBSuccess)
         {
@@ -250,7 +270,7 @@ uint8_t inverter::requestPower()
         }
         delay(MODBUS_READ_DELAY);
 
-        result = node.readInputRegisters(3035, 10);
+        result = readRegisters(3035, 10);
         result_or |= result;
         if (result == node.ku8MBSuccess)                        // ac values and inverter temperature
         {
@@ -303,7 +323,7 @@ uint8_t inverter::requestDayEnergy()
     {
         inverterOffCounter = 0;
         result = node.ku8MBSuccess;
-        result = node.readInputRegisters(3014, 2);                 // energy today and last day in 0.1kWh
+        result = readRegisters(3014, 2);                 // energy today and last day in 0.1kWh
         if (result == node.ku8MBSuccess)
         {
             _energyToday = node.getResponseBuffer(0x00) / 10.0;
@@ -353,7 +373,7 @@ uint8_t inverter::requestMonthYearEnergy()
     {
         result_or = node.ku8MBSuccess;
         inverterOffCounter = 0;
-        result = node.readInputRegisters(3010, 4);              // energy this and last month in kWh
+        result = readRegisters(3010, 4);              // energy this and last month in kWh
         result_or |= result;
         if (result == node.ku8MBSuccess)
         {
@@ -370,7 +390,7 @@ uint8_t inverter::requestMonthYearEnergy()
         }
         delay(MODBUS_READ_DELAY);
 
-        result = node.readInputRegisters(3016, 4);              // energy this and last month/year in kWh
+        result = readRegisters(3016, 4);              // energy this and last month/year in kWh
         result_or |= result;
         if (result == node.ku8MBSuccess)
         {
@@ -515,6 +535,19 @@ bool inverter::isInverterReachable()
     return reachable;
 }
 
+/*
+Return number of modbus read requests and of failed ones
+*/
+uint32_t inverter::getReadCount()
+{
+    return _readCount;
+}
+
+uint32_t inverter::getReadErrorCount()
+{
+    return _readErrorCount;
+}
+
 /*
 Is inverter reachable (Last state)
 */
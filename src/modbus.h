@@ -2,6 +2,9 @@
 #define MODBUS_H
 // modbus.h for Solis Inverter Status Register Readout
 //
+// 2026-10-18 mh
+// - counters of register reads
+//
 // 2022-10-14 M. Herbert
 // - based on Solis4Gmini-logger by 10k-resistor.
 // - adapted for own use
@@ -42,5 +45,8 @@ public:
     bool setIsInverterReachableFlagLast(bool _value);
     bool getIsInverterReachableFlagLast();
 
+    uint32_t getReadCount();
+    uint32_t getReadErrorCount();
+
 };
 #endif // MODBUS_H
\ No newline at end of file
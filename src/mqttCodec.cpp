@@ -0,0 +1,208 @@
+// mqttCodec.cpp
+//
+// MQTT 3.1.1 packets of the publisher: CONNECT and PUBLISH layout, splitting the received stream into packets
+//
+// 2026-10-18 mh
+// - first version, packet layout and stream splitter taken out of mqttPublisher.cpp
+// - remaining length limited to 4 bytes, longer one is rejected as malformed
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Composes the packets sent by MqttPublisher and splits the answers of the broker into packets. There is no
+dependency on the tcp client, so the functions run in the native unit tests.
+
+** Usage **
+n = mqttConnect(buf, sizeof(buf), clientId, keepAlive, willTopic, "offline", user, password);   0: too long
+n = mqttPublish(buf, sizeof(buf), MQTT_PUBLISH | (qos << 1), topic, packetId, payload, len);       0: too long
+
+MqttReader reader;
+switch (reader.put(b))                for each received byte
+  PACKET: reader.getType(), getData(), isPubAck(id)
+  MALFORMED: close the connection, reset()
+
+** Implementation **
+The remaining length of the fixed header has 7 bits per byte, the high bit tells that another byte follows.
+The fourth byte must be the last one (MQTT 3.1.1, 2.2.3); a fifth byte is rejected, so the shift can not exceed
+the 32 bit value. The reader keeps the first MQTT_READER_DATA bytes of each packet, enough for CONNACK and PUBACK;
+the rest of a longer packet is skipped.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "mqttCodec.h"
+
+size_t mqttPutLength(uint8_t* buf, uint32_t len)
+//
+// remaining length of fixed header, return number of bytes (1..4)
+{
+  size_t n = 0;
+  do
+  {
+    uint8_t digit = len % 128;
+    len /= 128;
+    if(len > 0)
+    {
+      digit |= 0x80;
+    }
+    buf[n++] = digit;
+  } while (len > 0);
+  return n;
+}
+
+size_t mqttPutString(uint8_t* buf, const char* s)
+//
+// UTF-8 string with 16 bit length
+{
+  size_t len = strlen(s);
+  buf[0] = len >> 8;
+  buf[1] = len & 0xFF;
+  memcpy(&buf[2], s, len);
+  return len + 2;
+}
+
+size_t mqttConnect(uint8_t* buf, size_t size, const char* clientId, uint16_t keepAlive, const char* willTopic,
+    const char* willMessage, const char* user, const char* password)
+//
+// CONNECT with persistent session and retained last will; user, password: "" if not used.
+// return packet length, 0 if it does not fit into size
+{
+  bool withUser = (user[0] != '\0');
+  bool withPassword = withUser && (password[0] != '\0');
+  uint32_t remaining = 10 + 2 + strlen(clientId) + 2 + strlen(willTopic) + 2 + strlen(willMessage);
+  if(withUser)
+  {
+    remaining += 2 + strlen(user);
+  }
+  if(withPassword)
+  {
+    remaining += 2 + strlen(password);
+  }
+  if((remaining + 1 + MQTT_MAX_LENGTH_BYTES) > size)
+  {
+    return 0;
+  }
+
+  size_t n = 0;
+  buf[n++] = MQTT_CONNECT;
+  n += mqttPutLength(&buf[n], remaining);
+  n += mqttPutString(&buf[n], "MQTT");
+  buf[n++] = 4;                               // protocol level 3.1.1
+  buf[n++] = (withUser ? 0x80 : 0) | (withPassword ? 0x40 : 0) | 0x20 | 0x04;   // will retain, will flag, clean session = 0
+  buf[n++] = keepAlive >> 8;
+  buf[n++] = keepAlive & 0xFF;
+  n += mqttPutString(&buf[n], clientId);
+  n += mqttPutString(&buf[n], willTopic);
+  n += mqttPutString(&buf[n], willMessage);
+  if(withUser)
+  {
+    n += mqttPutString(&buf[n], user);
+  }
+  if(withPassword)
+  {
+    n += mqttPutString(&buf[n], password);
+  }
+  return n;
+}
+
+size_t mqttPublish(uint8_t* buf, size_t size, uint8_t flags, const char* topic, uint16_t packetId,
+    const char* payload, size_t payloadLen)
+//
+// PUBLISH, flags: MQTT_PUBLISH with QoS and retain bits; packetId is only sent with QoS > 0.
+// return packet length, 0 if it does not fit into size
+{
+  bool withId = (flags & 0x06) != 0;
+  uint32_t remaining = 2 + strlen(topic) + (withId ? 2 : 0) + payloadLen;
+  if((remaining + 1 + MQTT_MAX_LENGTH_BYTES) > size)
+  {
+    return 0;
+  }
+  size_t n = 0;
+  buf[n++] = flags;
+  n += mqttPutLength(&buf[n], remaining);
+  n += mqttPutString(&buf[n], topic);
+  if(withId)
+  {
+    buf[n++] = packetId >> 8;
+    buf[n++] = packetId & 0xFF;
+  }
+  memcpy(&buf[n], payload, payloadLen);
+  return n + payloadLen;
+}
+
+void MqttReader::reset()
+{
+  _phase = 0;
+}
+
+MqttReader::Result MqttReader::put(uint8_t b)
+//
+// next byte of the stream, PACKET: a packet is complete
+{
+  switch (_phase)
+  {
+  case 0:
+    _header = b;
+    _remaining = 0;
+    _lengthBytes = 0;
+    _count = 0;
+    _phase = 1;
+    return MORE;
+
+  case 1:
+    _remaining |= (uint32_t)(b & 0x7F) << (7 * _lengthBytes);
+    _lengthBytes++;
+    if((b & 0x80) != 0)
+    {
+      if(_lengthBytes >= MQTT_MAX_LENGTH_BYTES)
+      {
+        _phase = 0;
+        return MALFORMED;
+      }
+      return MORE;
+    }
+    if(_remaining == 0)
+    {
+      _phase = 0;
+      return PACKET;
+    }
+    _phase = 2;
+    return MORE;
+
+  default:
+    if(_count < sizeof(_data))
+    {
+      _data[_count] = b;
+    }
+    _count++;
+    if(_count >= _remaining)
+    {
+      _phase = 0;
+      return PACKET;
+    }
+    return MORE;
+  }
+}
+
+uint8_t MqttReader::getType()
+{
+  return _header & 0xF0;
+}
+
+uint32_t MqttReader::getLength()
+{
+  return _remaining;
+}
+
+const uint8_t* MqttReader::getData()
+{
+  return _data;
+}
+
+bool MqttReader::isPubAck(uint16_t packetId)
+//
+// packet is the PUBACK of packetId
+{
+  return (getType() == MQTT_PUBACK) && (_remaining >= 2) && ((((uint16_t)_data[0] << 8) | _data[1]) == packetId);
+}
@@ -0,0 +1,51 @@
+#ifndef MQTT_CODEC_H
+#define MQTT_CODEC_H
+//
+// 2026-10-18 mh
+// - first version, packet layout and stream splitter taken out of mqttPublisher.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+
+#define MQTT_CONNECT      0x10
+#define MQTT_CONNACK      0x20
+#define MQTT_PUBLISH      0x30
+#define MQTT_PUBACK       0x40
+#define MQTT_PINGREQ      0xC0
+#define MQTT_PINGRESP     0xD0
+#define MQTT_FLAG_DUP     0x08
+#define MQTT_FLAG_RETAIN  0x01
+
+#define MQTT_MAX_LENGTH_BYTES 4     // remaining length has 1..4 bytes, up to 268435455
+#define MQTT_READER_DATA      4     // first bytes of a received packet kept by MqttReader
+
+size_t mqttPutLength(uint8_t* buf, uint32_t len);
+size_t mqttPutString(uint8_t* buf, const char* s);
+size_t mqttConnect(uint8_t* buf, size_t size, const char* clientId, uint16_t keepAlive, const char* willTopic,
+    const char* willMessage, const char* user, const char* password);
+size_t mqttPublish(uint8_t* buf, size_t size, uint8_t flags, const char* topic, uint16_t packetId,
+    const char* payload, size_t payloadLen);
+
+// splits the byte stream of the broker into packets, only the first bytes of each packet are kept
+class MqttReader
+{
+public:
+    enum Result {MORE, PACKET, MALFORMED};
+    void reset();
+    Result put(uint8_t b);
+    uint8_t getType();
+    uint32_t getLength();
+    const uint8_t* getData();
+    bool isPubAck(uint16_t packetId);
+
+private:
+    uint8_t _header = 0;            // fixed header byte, remaining length, first bytes
+    uint32_t _remaining = 0;
+    uint8_t _lengthBytes = 0;
+    uint8_t _phase = 0;             // 0 header, 1 remaining length, 2 variable part
+    uint8_t _data[MQTT_READER_DATA];
+    uint32_t _count = 0;
+};
+#endif // MQTT_CODEC_H
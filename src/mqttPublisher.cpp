@@ -0,0 +1,398 @@
+// mqttPublisher.cpp
+//
+// MQTT 3.1.1 publisher of inverter snapshots based on ESPAsyncTCP
+//
+// 2026-10-18 mh
+// - packets composed and split by mqttCodec, a malformed remaining length closes the connection
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Publishes each snapshot of inverter values as one compact JSON message to an MQTT broker:
+<topic>/snapshot   {"seq":12,"ts":1666801000,"power":1234.50,"dc_u":230.10,"dc_i":5.36,"dc_p":1233.34,"e_today":4.20,"t_inv":35.00,"t_room":21.50}
+<topic>/status     online / offline (retained, last will)
+
+** Usage **
+mqtt.init(mqttConfig, clientId);      config from confWeb parameters, MQTT is off if the server is empty
+mqtt.publish(snapshot);               once per poll
+mqtt.doLoop();                        call in loop(), connects, reconnects, keep alive
+
+** Implementation **
+One tcp connection to the broker is kept open (AsyncClient); the IP of the broker is taken from a DnsCache.
+CONNECT is sent with clean session = 0 and the thing name as client id, so the broker keeps the session over a
+reconnect. The connection is supervised by PINGREQ after half of the keep alive time without transmission.
+QoS 0: the snapshot is sent once, it is dropped if the broker is not connected.
+QoS 1: the PUBLISH packet is kept in _packet until PUBACK; after a reconnect it is repeated with DUP flag.
+Only one snapshot is in flight; a snapshot arriving meanwhile is dropped and counted.
+Packets are composed in fixed buffers by mqttCodec, the payload is formatted by FmtBuf without heap allocation.
+The answers of the broker are split into packets by a MqttReader; a malformed packet closes the connection.
+Callbacks of AsyncClient only parse the answers of the broker and set flags; packets are sent from doLoop()
+and publish() in loop() context.
+getBytesSent() and getRoundTrips() allow to compare the cost per cycle with the http transfer of VzHttp.
+  *** end description *** */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "config.h"
+#include "fmtBuf.h"
+#include "mqttPublisher.h"
+
+#define MQTT_CONNECT_TIMEOUT  10000   // ms for tcp connect and CONNACK
+
+MqttPublisher::MqttPublisher()
+{
+  _client.onConnect([this](void* arg, AsyncClient* client)
+  {
+    setState(WAIT_CONNACK);
+  });
+  _client.onData([this](void* arg, AsyncClient* client, void* data, size_t len)
+  {
+    onData((const uint8_t*)data, len);
+  });
+  _client.onDisconnect([this](void* arg, AsyncClient* client)
+  {
+    if(_state == CONNECTING)
+    {
+      _dns.invalidate();
+    }
+    if(_state != DISABLED)
+    {
+      setState(DISCONNECTED);
+    }
+  });
+  _client.onTimeout([this](void* arg, AsyncClient* client, uint32_t time)
+  {
+    client->close();
+  });
+}
+
+void MqttPublisher::init(MqttConfig& config, const char* clientId)
+{
+  _config = &config;
+  _clientId = clientId;
+  _qos = (config.qos[0] == '1') ? 1 : 0;
+  snprintf(_statusTopic, sizeof(_statusTopic), "%s/status", config.topic);
+  snprintf(_dataTopic, sizeof(_dataTopic), "%s/snapshot", config.topic);
+
+  if(config.server[0] == '\0')
+  {
+    _state = DISABLED;
+    return;
+  }
+  String server = String(config.server);
+  int colon = server.indexOf(':');
+  if(colon >= 0)
+  {
+    _port = server.substring(colon + 1).toInt();
+    server = server.substring(0, colon);
+  }
+  _dns.setHost(server);
+  _state = DISCONNECTED;
+  _stateTime = millis() - MQTT_RECONNECT_INTERVAL;    // connect with first doLoop()
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"mqtt: broker %s:%u, topic %s, QoS %u",server.c_str(),_port,_dataTopic,_qos);
+}
+
+bool MqttPublisher::isConnected()
+{
+  return _state == CONNECTED;
+}
+
+bool MqttPublisher::publish(const Snapshot& snapshot)
+//
+// compose PUBLISH packet of snapshot and send it, if connected
+{
+  if(_state == DISABLED)
+  {
+    return false;
+  }
+  if(_inflight || ((_qos == 0) && (_state != CONNECTED)))
+  {
+    _dropCount++;
+    return false;
+  }
+
+  char payload[192];
+  FmtBuf json(payload, sizeof(payload));
+  json.add("{\"seq\":").addUint(snapshot.seq);
+  json.add(",\"ts\":").addUint(snapshot.timeStamp);
+  json.add(",\"power\":").addFixed(snapshot.power, 2);
+  json.add(",\"dc_u\":").addFixed(snapshot.dcU, 2);
+  json.add(",\"dc_i\":").addFixed(snapshot.dcI, 2);
+  json.add(",\"dc_p\":").addFixed(snapshot.dcPower, 2);
+  json.add(",\"e_today\":").addFixed(snapshot.energyToday, 2);
+  json.add(",\"t_inv\":").addFixed(snapshot.temperatureInverter, 2);
+  json.add(",\"t_room\":").addFixed(snapshot.temperatureRoom, 2);
+  json.add('}');
+
+  uint16_t packetId = _packetId + 1;
+  if(packetId == 0)
+  {
+    packetId = 1;
+  }
+  size_t n = mqttPublish(_packet, sizeof(_packet), MQTT_PUBLISH | (_qos << 1), _dataTopic, packetId,
+    json.c_str(), json.length());
+  if(n == 0)
+  {
+    _dropCount++;
+    return false;
+  }
+  if(_qos > 0)
+  {
+    _packetId = packetId;
+  }
+  _packetLen = n;
+  _inflight = true;
+  _published = false;
+  _acked = false;
+
+  if(_state == CONNECTED)
+  {
+    sendPublish(false);
+  }
+  return true;
+}
+
+void MqttPublisher::doLoop()
+{
+  if(_state == DISABLED)
+  {
+    return;
+  }
+  uint32_t now = millis();
+  _dns.doLoop();
+
+  switch (_state)
+  {
+  case DISCONNECTED:
+    if((WiFi.status() == WL_CONNECTED) && ((now - _stateTime) >= MQTT_RECONNECT_INTERVAL))
+    {
+      connect();
+    }
+    break;
+
+  case CONNECTING:
+  case WAIT_CONNACK:
+    if((now - _stateTime) > MQTT_CONNECT_TIMEOUT)
+    {
+      DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"mqtt: no answer from broker");
+      _client.close(true);
+      setState(DISCONNECTED);
+    }
+    else if((_state == WAIT_CONNACK) && !_connectSent)
+    {
+      sendConnect();
+    }
+    break;
+
+  case CONNECTED:
+    if(_sessionStart)
+    {
+      _sessionStart = false;
+      sendStatus();
+      if(_inflight && _published)
+      {
+        sendPublish(true);    // QoS 1 packet not acknowledged before reconnect
+      }
+    }
+    if(_inflight && _acked)
+    {
+      _inflight = false;
+    }
+    if(_inflight && !_published)
+    {
+      sendPublish(false);     // tcp buffer was full or not connected at publish()
+    }
+    if((now - _lastRx) > (MQTT_KEEPALIVE * 1500UL))
+    {
+      DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"mqtt: broker lost");
+      _client.close(true);
+    }
+    else if((now - _lastTx) > (MQTT_KEEPALIVE * 500UL))
+    {
+      uint8_t ping[2] = {MQTT_PINGREQ, 0};
+      if(sendPacket(ping, sizeof(ping)))
+      {
+        _roundTrips++;
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+const char* MqttPublisher::getName()
+{
+  return "MQTT";
+}
+
+uint32_t MqttPublisher::getBytesSent()
+{
+  return _bytesSent;
+}
+
+uint32_t MqttPublisher::getRoundTrips()
+{
+  return _roundTrips;
+}
+
+uint32_t MqttPublisher::getDropCount()
+{
+  return _dropCount;
+}
+
+uint32_t MqttPublisher::getConnectCount()
+{
+  return _connectCount;
+}
+
+void MqttPublisher::connect()
+{
+  IPAddress ip;
+  if(!_dns.getIP(ip))
+  {
+    _stateTime = millis();    // wait for lookup, try again after MQTT_RECONNECT_INTERVAL
+    return;
+  }
+  _connectCount++;
+  _connectSent = false;
+  _reader.reset();
+  setState(CONNECTING);
+  if(!_client.connect(ip, _port))
+  {
+    _dns.invalidate();
+    setState(DISCONNECTED);
+  }
+}
+
+void MqttPublisher::sendConnect()
+//
+// CONNECT with persistent session, last will "offline" on status topic
+{
+  uint8_t buf[200];
+  size_t n = mqttConnect(buf, sizeof(buf), _clientId, MQTT_KEEPALIVE, _statusTopic, "offline", _config->user,
+    _config->password);
+  if(n == 0)
+  {
+    DEBUG_TRACE(true,"mqtt: client id, topic or credentials too long");
+    _client.close(true);
+    return;
+  }
+  if(sendPacket(buf, n))
+  {
+    _connectSent = true;
+    _roundTrips++;
+  }
+}
+
+void MqttPublisher::sendPublish(bool dup)
+{
+  if(dup && (_qos > 0))
+  {
+    _packet[0] |= MQTT_FLAG_DUP;
+  }
+  if(!sendPacket(_packet, _packetLen))
+  {
+    return;
+  }
+  _published = true;
+  if(_qos == 0)
+  {
+    _inflight = false;
+  }
+  else
+  {
+    _roundTrips++;
+  }
+}
+
+void MqttPublisher::sendStatus()
+//
+// retained "online" on status topic, replaced by last will "offline" if the connection is lost
+{
+  uint8_t buf[sizeof(_statusTopic) + 16];
+  const char* online = "online";
+  size_t n = mqttPublish(buf, sizeof(buf), MQTT_PUBLISH | MQTT_FLAG_RETAIN, _statusTopic, 0, online, strlen(online));
+  sendPacket(buf, n);
+}
+
+bool MqttPublisher::sendPacket(const uint8_t* data, size_t len)
+{
+  if(_client.space() < len)
+  {
+    return false;
+  }
+  _client.add((const char*)data, len);
+  _client.send();
+  _bytesSent += len;
+  _lastTx = millis();
+  return true;
+}
+
+void MqttPublisher::setState(State state)
+{
+  _state = state;
+  _stateTime = millis();
+}
+
+void MqttPublisher::onData(const uint8_t* data, size_t len)
+//
+// split stream into packets
+{
+  size_t i;
+  for (i=0;i<len;i++)
+  {
+    MqttReader::Result result = _reader.put(data[i]);
+    if(result == MqttReader::PACKET)
+    {
+      onPacket();
+    }
+    else if(result == MqttReader::MALFORMED)
+    {
+      DEBUG_TRACE(true,"mqtt: malformed remaining length");
+      _client.close();
+      return;
+    }
+  }
+}
+
+void MqttPublisher::onPacket()
+{
+  _lastRx = millis();
+  const uint8_t* data = _reader.getData();
+  switch (_reader.getType())
+  {
+  case MQTT_CONNACK:
+    if(_reader.getLength() < 2)
+    {
+      DEBUG_TRACE(true,"mqtt: malformed CONNACK, %u bytes",_reader.getLength());
+      _client.close();
+    }
+    else if(data[1] == 0)
+    {
+      DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"mqtt: connected, session present %u",data[0] & 0x01);
+      setState(CONNECTED);
+      _sessionStart = true;
+    }
+    else
+    {
+      DEBUG_TRACE(true,"mqtt: connection refused, code %u",data[1]);
+      _client.close();
+    }
+    break;
+
+  case MQTT_PUBACK:
+    if(_reader.isPubAck(_packetId))
+    {
+      _acked = true;
+    }
+    break;
+
+  default:                    // PINGRESP, anything else is ignored
+    break;
+  }
+}
@@ -0,0 +1,88 @@
+#ifndef MQTT_PUBLISHER_H
+#define MQTT_PUBLISHER_H
+//
+// 2026-10-18 mh
+// - packets composed and split by mqttCodec
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPAsyncTCP.h>
+#include "config.h"
+#include "publisher.h"
+#include "dnsCache.h"
+#include "mqttCodec.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+struct MqttConfig
+{
+  char server[64] = MQTT_SERVER;    // host[:port], empty: not used
+  char user[32] = "";
+  char password[32] = "";
+  char topic[48] = MQTT_TOPIC;
+  char qos[2] = MQTT_QOS;
+};
+
+class MqttPublisher : public Publisher
+{
+public:
+    MqttPublisher();
+    void init(MqttConfig& config, const char* clientId);
+    bool isConnected();
+    uint32_t getDropCount();
+    uint32_t getConnectCount();
+
+    // Publisher
+    bool publish(const Snapshot& snapshot) override;
+    void doLoop() override;
+    const char* getName() override;
+    uint32_t getBytesSent() override;
+    uint32_t getRoundTrips() override;
+
+private:
+    enum State {DISABLED, DISCONNECTED, CONNECTING, WAIT_CONNACK, CONNECTED};
+
+    AsyncClient _client;
+    DnsCache _dns;
+    const MqttConfig* _config = nullptr;
+    const char* _clientId = "";
+    uint16_t _port = MQTT_PORT;
+    uint8_t _qos = 0;
+    char _statusTopic[sizeof(MqttConfig::topic) + 8];
+    char _dataTopic[sizeof(MqttConfig::topic) + 10];
+
+    volatile State _state = DISABLED;
+    uint32_t _stateTime = 0;        // ms, time of last state change
+    uint32_t _lastTx = 0;           // ms, last packet sent
+    volatile uint32_t _lastRx = 0;  // ms, last packet received
+    bool _connectSent = false;      // CONNECT sent on current connection
+    volatile bool _sessionStart = false;    // CONNACK received, status and packet in flight are sent by doLoop()
+
+    uint8_t _packet[MQTT_PACKET_SIZE];  // PUBLISH packet, kept until PUBACK for QoS 1
+    size_t _packetLen = 0;
+    bool _inflight = false;         // _packet waits for transmission or PUBACK
+    bool _published = false;        // _packet was sent at least once
+    volatile bool _acked = false;   // PUBACK received for _packetId
+    uint16_t _packetId = 0;
+
+    MqttReader _reader;             // splits the received stream into packets
+
+    uint32_t _bytesSent = 0;
+    uint32_t _roundTrips = 0;
+    uint32_t _dropCount = 0;
+    uint32_t _connectCount = 0;
+
+    void connect();
+    void sendConnect();
+    void sendPublish(bool dup);
+    void sendStatus();
+    bool sendPacket(const uint8_t* data, size_t len);
+    void setState(State state);
+    void onData(const uint8_t* data, size_t len);
+    void onPacket();
+};
+#endif // MQTT_PUBLISHER_H
@@ -0,0 +1,125 @@
+// promWriter.cpp
+//
+// Prometheus text format of metric groups, written into the chunks of a response
+//
+// 2026-10-18 mh
+// - first version, Prometheus writer and chunk filler taken out of metrics.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+PromWriter writes HELP, TYPE and samples in Prometheus text format into a FmtBuf. MetricsStream calls a MetricsWriter
+group by group and writes the groups into buffers of any size, e.g. the chunks of a chunked response (metrics.cpp).
+
+** Usage **
+MetricsStream stream(writer);
+while ((n = stream.fill(buffer, maxLen)) > 0) ...     n bytes of the metrics in buffer, 0 at the end
+
+** Implementation **
+fill() writes the groups straight into the buffer as long as a whole group fits; a group which does not fit anymore
+is written again into the next buffer. So no String is built and the memory needed does not depend on the number of
+metrics.
+A group has to be smaller than maxGroup (METRICS_MAX_GROUP), otherwise it is skipped. If a buffer smaller than that is
+requested and the next group does not fit, an empty comment line "#\n" is returned instead (returning 0 would end the
+response). The class does not depend on the web server, so it runs in the native unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include <math.h>
+#include "promWriter.h"
+
+#define METRICS_DONE 0xFF
+
+PromWriter::PromWriter(FmtBuf& buf) : _buf(buf)
+{
+}
+
+void PromWriter::header(const char* name, const char* type, const char* help)
+{
+  _buf.add("# HELP ").add(name).add(' ').add(help).add('\n');
+  _buf.add("# TYPE ").add(name).add(' ').add(type).add('\n');
+}
+
+void PromWriter::name(const char* name, const char* label)
+{
+  _buf.add(name);
+  if(label != nullptr)
+  {
+    _buf.add('{').add(label).add('}');
+  }
+  _buf.add(' ');
+}
+
+void PromWriter::sample(const char* name, uint32_t value, const char* label)
+{
+  this->name(name, label);
+  _buf.addUint(value).add('\n');
+}
+
+void PromWriter::sample(const char* name, float value, uint8_t decimals, const char* label)
+{
+  this->name(name, label);
+  if(isnan(value))
+  {
+    _buf.add("NaN\n");
+    return;
+  }
+  _buf.addFixed(value, decimals).add('\n');
+}
+
+void PromWriter::gauge(const char* name, const char* help, uint32_t value)
+{
+  header(name, "gauge", help);
+  sample(name, value);
+}
+
+void PromWriter::gauge(const char* name, const char* help, float value, uint8_t decimals)
+{
+  header(name, "gauge", help);
+  sample(name, value, decimals);
+}
+
+void PromWriter::counter(const char* name, const char* help, uint32_t value)
+{
+  header(name, "counter", help);
+  sample(name, value);
+}
+
+MetricsStream::MetricsStream(MetricsWriter writer, size_t maxGroup)
+{
+  _writer = writer;
+  _maxGroup = maxGroup;
+}
+
+size_t MetricsStream::fill(uint8_t* buffer, size_t maxLen)
+//
+// write the next groups which fit completely into buffer, return number of bytes, 0 at the end
+{
+  size_t len = 0;
+  while ((_group != METRICS_DONE) && ((maxLen - len) > 1))
+  {
+    FmtBuf buf((char*)&buffer[len], maxLen - len);
+    PromWriter out(buf);
+    bool more = _writer(_group, out);
+    if(buf.overflow())
+    {
+      if(len > 0)
+      {
+        break;              // group is written again into next chunk
+      }
+      if(maxLen < _maxGroup)
+      {
+        buffer[0] = '#';    // small chunk: send empty comment line, 0 would end the response
+        buffer[1] = '\n';
+        len = 2;
+        break;
+      }
+      buf.clear();          // group too large, skipped
+    }
+    len += buf.length();
+    _group = more ? (_group + 1) : METRICS_DONE;
+  }
+  return len;
+}
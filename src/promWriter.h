@@ -0,0 +1,48 @@
+#ifndef PROM_WRITER_H
+#define PROM_WRITER_H
+//
+// 2026-10-18 mh
+// - first version, Prometheus writer and chunk filler taken out of metrics.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <functional>
+#include "fmtBuf.h"
+
+#define METRICS_MAX_GROUP 1024      // bytes; a group which does not fit into an empty chunk of this size is skipped
+
+// writes Prometheus text format into a FmtBuf
+class PromWriter
+{
+public:
+    PromWriter(FmtBuf& buf);
+    void header(const char* name, const char* type, const char* help);
+    void sample(const char* name, uint32_t value, const char* label = nullptr);
+    void sample(const char* name, float value, uint8_t decimals, const char* label = nullptr);
+    void gauge(const char* name, const char* help, uint32_t value);
+    void gauge(const char* name, const char* help, float value, uint8_t decimals);
+    void counter(const char* name, const char* help, uint32_t value);
+
+private:
+    FmtBuf& _buf;
+    void name(const char* name, const char* label);
+};
+
+// writes metric group number group, return false if it was the last group
+typedef std::function<bool(uint8_t group, PromWriter& out)> MetricsWriter;
+
+// metric groups of a MetricsWriter, written in chunks of any size
+class MetricsStream
+{
+public:
+    MetricsStream(MetricsWriter writer, size_t maxGroup = METRICS_MAX_GROUP);
+    size_t fill(uint8_t* buffer, size_t maxLen);
+
+private:
+    MetricsWriter _writer;
+    size_t _maxGroup;
+    uint8_t _group = 0;             // next group, METRICS_DONE after the last one
+};
+#endif // PROM_WRITER_H
@@ -0,0 +1,58 @@
+// publishSlot.cpp
+//
+// slot of a device within the publish window, so loggers of a site do not post at the same time
+//
+// 2026-10-18 mh
+// - first version, slot computation taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+All loggers align their timestamps to the same interval and poll the inverter at the start of it, so without a
+slot they would post in the same second. Each device gets a fixed offset within the publish window after the
+aligned sample time and sends its batch then.
+
+** Usage **
+offset = publishSlotOffset(ESP.getChipId(), 30);              ms, 0 .. 29999
+delay = publishSlotDelay(offset, phase, period);              ms to wait; phase: ms since the aligned sample time
+
+** Implementation **
+The offset is the chip id spread by the finalizer of MurmurHash3, modulo the window, so similar ids of a batch of
+devices get different slots. The delay is measured from the aligned sample time, not from the phase of the clock:
+the batch is flushed after the modbus poll, some seconds after the start of the interval, and a slot that has
+passed already is taken at once instead of waiting for the next interval. A batch older than one period (held back
+by adaptive batching) is sent at once as well.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "publishSlot.h"
+
+uint32_t publishSlotOffset(uint32_t chipId, uint32_t windowSeconds)
+//
+// deterministic offset in ms within the window, 0 if there is no window
+{
+  if(windowSeconds == 0)
+  {
+    return 0;
+  }
+  uint32_t h = chipId;
+  h ^= h >> 16;
+  h *= 0x85EBCA6B;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35;
+  h ^= h >> 16;
+  return h % (windowSeconds * 1000);
+}
+
+uint32_t publishSlotDelay(uint32_t offset, uint32_t phase, uint32_t period)
+//
+// ms until the slot at offset after the sample time; phase is the time elapsed since the sample time
+{
+  if((phase >= period) || (phase >= offset))
+  {
+    return 0;
+  }
+  return offset - phase;
+}
@@ -0,0 +1,14 @@
+#ifndef PUBLISH_SLOT_H
+#define PUBLISH_SLOT_H
+//
+// 2026-10-18 mh
+// - first version, slot computation taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+
+uint32_t publishSlotOffset(uint32_t chipId, uint32_t windowSeconds);
+uint32_t publishSlotDelay(uint32_t offset, uint32_t phase, uint32_t period);
+#endif // PUBLISH_SLOT_H
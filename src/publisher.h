@@ -0,0 +1,36 @@
+#ifndef PUBLISHER_H
+#define PUBLISHER_H
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+
+struct Snapshot           // values of one inverter poll, handed to all publishers
+{
+  uint32_t seq = 0;               // incremented with every poll
+  uint32_t timeStamp = 0;         // UNIX epoch time in s, aligned to the poll interval
+  float power = 0;                // W
+  float dcU = 0;                  // V
+  float dcI = 0;                  // A
+  float dcPower = 0;              // W
+  float energyToday = 0;          // kWh
+  float temperatureInverter = 0;  // °C
+  float temperatureRoom = 0;      // °C, DS18B20
+};
+
+// interface of a transport to a data base or broker; each publisher sends the snapshot in its own format
+class Publisher
+{
+public:
+    virtual ~Publisher() {}
+    virtual bool publish(const Snapshot& snapshot) = 0;   // false, if the snapshot is not accepted
+    virtual void doLoop() = 0;
+    virtual const char* getName() = 0;
+    virtual uint32_t getBytesSent() = 0;    // bytes passed to tcp, including protocol overhead
+    virtual uint32_t getRoundTrips() = 0;   // exchanges where an answer of the server is awaited
+};
+#endif // PUBLISHER_H
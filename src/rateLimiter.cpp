@@ -0,0 +1,77 @@
+// rateLimiter.cpp
+//
+// token bucket per client, used by the admission control of the web server
+//
+// 2026-10-18 mh
+// - first version, token bucket taken out of admission.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Limits the request rate of each client: a client may send ADMISSION_BURST requests at once and ADMISSION_RATE
+requests per s in the long run.
+
+** Usage **
+RateLimiter limiter;
+if(!limiter.take(ip, millis())) ...   bucket of the client is empty, answer 429
+
+** Implementation **
+Each of ADMISSION_CLIENTS clients gets ADMISSION_BURST tokens, refilled at ADMISSION_RATE per s; a request takes
+one token. Tokens are kept in 1/1000 to refill by ms. An unknown client replaces the one seen last longest ago.
+The time is passed by the caller, so the class does not depend on the web server or the clock and runs in the
+native unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "rateLimiter.h"
+
+#define TOKEN 1000                  // one request in 1/1000
+
+bool RateLimiter::take(uint32_t ip, uint32_t now)
+//
+// refill the bucket of the client and take one token, false if it is empty
+{
+  Bucket* bucket = nullptr;
+  Bucket* oldest = &_buckets[0];
+  uint8_t i;
+  for (i=0;i<ADMISSION_CLIENTS;i++)
+  {
+    if(_buckets[i].ip == ip)
+    {
+      bucket = &_buckets[i];
+      break;
+    }
+    if((now - _buckets[i].lastTime) > (now - oldest->lastTime))
+    {
+      oldest = &_buckets[i];
+    }
+  }
+  if(bucket == nullptr)
+  {
+    bucket = oldest;
+    bucket->ip = ip;
+    bucket->tokens = ADMISSION_BURST * TOKEN;
+  }
+  else
+  {
+    uint32_t elapsed = now - bucket->lastTime;
+    if(elapsed > ((ADMISSION_BURST * TOKEN) / ADMISSION_RATE))
+    {
+      elapsed = (ADMISSION_BURST * TOKEN) / ADMISSION_RATE;     // bucket is full anyway, avoids overflow
+    }
+    bucket->tokens += elapsed * ADMISSION_RATE;
+    if(bucket->tokens > (ADMISSION_BURST * TOKEN))
+    {
+      bucket->tokens = ADMISSION_BURST * TOKEN;
+    }
+  }
+  bucket->lastTime = now;
+  if(bucket->tokens < TOKEN)
+  {
+    return false;
+  }
+  bucket->tokens -= TOKEN;
+  return true;
+}
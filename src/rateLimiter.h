@@ -0,0 +1,29 @@
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+//
+// 2026-10-18 mh
+// - first version, token bucket taken out of admission.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+
+// token bucket per client (IP): ADMISSION_BURST requests at once, ADMISSION_RATE per s in the long run
+class RateLimiter
+{
+public:
+    bool take(uint32_t ip, uint32_t now);
+
+private:
+    struct Bucket
+    {
+        uint32_t ip = 0;
+        uint32_t tokens = 0;            // 1/1000 requests
+        uint32_t lastTime = 0;          // ms, last refill
+    };
+
+    Bucket _buckets[ADMISSION_CLIENTS];
+};
+#endif // RATELIMITER_H
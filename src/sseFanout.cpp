@@ -0,0 +1,118 @@
+// sseFanout.cpp
+//
+// payload of the snapshot event and fan-out decisions of ssePublisher.cpp
+//
+// 2026-10-18 mh
+// - first version, payload and fan-out decisions taken out of ssePublisher.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+The parts of the server-sent events stream which do not need AsyncEventSource: the JSON data of a snapshot, the
+length of an event on the wire, the limit of subscribers and the back pressure of slow ones.
+
+** Usage **
+len = sseFormatSnapshot(buf, size, snapshot);   JSON data of the event, 0 if buf is too small
+SseFanout fanout;
+if(!fanout.accept(events.count())) ...          close the new subscriber
+if(fanout.shouldSend(events.count(), events.avgPacketsWaiting()))
+{
+  events.send(...);
+  fanout.sent(events.count(), sseEventLength(id, "snapshot", len));
+}
+
+** Implementation **
+accept() gets the number of subscribers including the new one, so at most maxClients are kept.
+shouldSend() is false without subscribers (nothing to do) and if they have on average more than maxPending
+messages waiting; only the latter counts as skipped event. sent() adds the length of the event once per subscriber,
+because AsyncEventSource queues a copy to each.
+Nothing here depends on the web server, so it runs in the native unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "fmtBuf.h"
+#include "sseFanout.h"
+
+size_t sseFormatSnapshot(char* buf, size_t size, const Snapshot& snapshot)
+//
+// JSON data of event "snapshot", same format as the MQTT message; 0 and "" if it does not fit into buf
+{
+  FmtBuf json(buf, size);
+  json.add("{\"seq\":").addUint(snapshot.seq);
+  json.add(",\"ts\":").addUint(snapshot.timeStamp);
+  json.add(",\"power\":").addFixed(snapshot.power, 2);
+  json.add(",\"dc_u\":").addFixed(snapshot.dcU, 2);
+  json.add(",\"dc_i\":").addFixed(snapshot.dcI, 2);
+  json.add(",\"dc_p\":").addFixed(snapshot.dcPower, 2);
+  json.add(",\"e_today\":").addFixed(snapshot.energyToday, 2);
+  json.add(",\"t_inv\":").addFixed(snapshot.temperatureInverter, 2);
+  json.add(",\"t_room\":").addFixed(snapshot.temperatureRoom, 2);
+  json.add('}');
+  if(json.overflow())
+  {
+    json.clear();
+    return 0;
+  }
+  return json.length();
+}
+
+size_t sseEventLength(uint32_t id, const char* event, size_t dataLength)
+//
+// bytes of "id: <id>\nevent: <event>\ndata: <data>\n\n"
+{
+  return 4 + snprintf(nullptr, 0, "%u", (unsigned int)id) + 1 + 7 + strlen(event) + 1 + 6 + dataLength + 2;
+}
+
+SseFanout::SseFanout(uint8_t maxClients, size_t maxPending) : _maxClients(maxClients), _maxPending(maxPending)
+{
+}
+
+bool SseFanout::accept(size_t clients)
+//
+// false, if the new subscriber (counted in clients) is one too many
+{
+  if(clients > _maxClients)
+  {
+    _rejectCount++;
+    return false;
+  }
+  return true;
+}
+
+bool SseFanout::shouldSend(size_t clients, size_t avgWaiting)
+//
+// false without subscribers or if they did not take the previous events yet
+{
+  if(clients == 0)
+  {
+    return false;
+  }
+  if(avgWaiting > _maxPending)
+  {
+    _skipCount++;
+    return false;
+  }
+  return true;
+}
+
+void SseFanout::sent(size_t clients, size_t eventLength)
+{
+  _bytesSent += clients * eventLength;
+}
+
+uint32_t SseFanout::getRejectCount()
+{
+  return _rejectCount;
+}
+
+uint32_t SseFanout::getSkipCount()
+{
+  return _skipCount;
+}
+
+uint32_t SseFanout::getBytesSent()
+{
+  return _bytesSent;
+}
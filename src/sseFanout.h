@@ -0,0 +1,36 @@
+#ifndef SSE_FANOUT_H
+#define SSE_FANOUT_H
+//
+// 2026-10-18 mh
+// - first version, payload and fan-out decisions taken out of ssePublisher.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+#include "publisher.h"
+
+size_t sseFormatSnapshot(char* buf, size_t size, const Snapshot& snapshot);
+size_t sseEventLength(uint32_t id, const char* event, size_t dataLength);
+
+// admission of subscribers, skip of events for slow subscribers, bytes queued to all subscribers
+class SseFanout
+{
+public:
+    SseFanout(uint8_t maxClients = SSE_MAX_CLIENTS, size_t maxPending = SSE_MAX_PENDING);
+    bool accept(size_t clients);
+    bool shouldSend(size_t clients, size_t avgWaiting);
+    void sent(size_t clients, size_t eventLength);
+    uint32_t getRejectCount();
+    uint32_t getSkipCount();
+    uint32_t getBytesSent();
+
+private:
+    uint8_t _maxClients;
+    size_t _maxPending;
+    uint32_t _rejectCount = 0;          // subscribers closed because of maxClients
+    uint32_t _skipCount = 0;            // events not sent because the subscribers did not take the previous ones
+    uint32_t _bytesSent = 0;
+};
+#endif // SSE_FANOUT_H
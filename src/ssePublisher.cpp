@@ -0,0 +1,134 @@
+// ssePublisher.cpp
+//
+// server-sent events stream of inverter snapshots
+//
+// 2026-10-18 mh
+// - payload and fan-out decisions in SseFanout
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Pushes each snapshot of inverter values as event "snapshot" to all clients subscribed to http://<localIP>/events,
+so a consumer does not have to poll /api/all.json:
+id: 12
+event: snapshot
+data: {"seq":12,"ts":1666801000,"power":1234.50,"dc_u":230.10,"dc_i":5.36,"dc_p":1233.34,"e_today":4.20,"t_inv":35.00,"t_room":21.50}
+
+In a browser: new EventSource("/events").addEventListener("snapshot", e => show(JSON.parse(e.data)));
+
+** Usage **
+sse.begin(server);          in setup(), adds the handler of SSE_URL to the web server
+sse.publish(snapshot);      once per poll, via the publisher list
+
+** Implementation **
+AsyncEventSource of ESPAsyncWebServer keeps the clients. The payload (same format as the MQTT message) is formatted
+once by sseFormatSnapshot() into _payload; AsyncEventSource::send() composes the event text once and queues it to
+every client, so the cost of an event does not grow with the number of subscribers except for the copy per client.
+At most SSE_MAX_CLIENTS subscribers are kept, a further one is closed at once. A new subscriber gets the last
+event immediately. Back pressure: if the subscribers have on average more than SSE_MAX_PENDING messages waiting
+(slow WiFi of a client), the event is skipped - the next snapshot supersedes it anyway - instead of filling the heap.
+The id is the sequence number of the snapshot, so a client can detect skipped events.
+The limit of subscribers, the skip decision and the byte count are kept by SseFanout (sseFanout.cpp), which does not
+depend on AsyncEventSource and is tested natively.
+getRenderTime() shows the time to format and queue the last event.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "ssePublisher.h"
+
+SsePublisher::SsePublisher() : _events(SSE_URL)
+{
+  _payload[0] = '\0';
+}
+
+void SsePublisher::begin(AsyncWebServer& server)
+{
+  _events.onConnect([this](AsyncEventSourceClient* client) { onConnect(client); });
+  server.addHandler(&_events);
+}
+
+void SsePublisher::onConnect(AsyncEventSourceClient* client)
+//
+// limit the number of subscribers, send the last snapshot to a new one
+{
+  if(!_fanout.accept(_events.count()))
+  {
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"sse: too many subscribers, closed");
+    client->close();
+    return;
+  }
+  if(_seq != 0)
+  {
+    client->send(_payload, "snapshot", _seq);
+  }
+}
+
+bool SsePublisher::publish(const Snapshot& snapshot)
+//
+// format snapshot once and queue it to all subscribers
+{
+  uint32_t start = micros();
+  size_t len = sseFormatSnapshot(_payload, sizeof(_payload), snapshot);
+  _seq = (len > 0) ? snapshot.seq : 0;      // a payload too long is not sent, not even to a new subscriber
+  if(len == 0)
+  {
+    return false;
+  }
+
+  size_t clients = _events.count();
+  if(clients == 0)
+  {
+    return true;
+  }
+  if(!_fanout.shouldSend(clients, _events.avgPacketsWaiting()))
+  {
+    return false;
+  }
+  _events.send(_payload, "snapshot", _seq);
+  _fanout.sent(clients, sseEventLength(_seq, "snapshot", len));
+  _renderTime = micros() - start;
+  return true;
+}
+
+void SsePublisher::doLoop()
+{
+  // nothing to do, AsyncEventSource sends from the tcp callbacks
+}
+
+const char* SsePublisher::getName()
+{
+  return "sse";
+}
+
+uint8_t SsePublisher::getClientCount()
+{
+  return _events.count();
+}
+
+uint32_t SsePublisher::getRejectCount()
+{
+  return _fanout.getRejectCount();
+}
+
+uint32_t SsePublisher::getSkipCount()
+{
+  return _fanout.getSkipCount();
+}
+
+uint32_t SsePublisher::getRenderTime()
+{
+  return _renderTime;
+}
+
+uint32_t SsePublisher::getBytesSent()
+{
+  return _fanout.getBytesSent();
+}
+
+uint32_t SsePublisher::getRoundTrips()
+{
+  return 0;     // no answer from the subscribers
+}
@@ -0,0 +1,47 @@
+#ifndef SSE_PUBLISHER_H
+#define SSE_PUBLISHER_H
+//
+// 2026-10-18 mh
+// - payload and fan-out decisions in SseFanout
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "config.h"
+#include "publisher.h"
+#include "sseFanout.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+// pushes each snapshot as server-sent event to all subscribers of SSE_URL
+class SsePublisher : public Publisher
+{
+public:
+    SsePublisher();
+    void begin(AsyncWebServer& server);
+    uint8_t getClientCount();
+    uint32_t getRejectCount();
+    uint32_t getSkipCount();
+    uint32_t getRenderTime();
+
+    // Publisher
+    bool publish(const Snapshot& snapshot) override;
+    void doLoop() override;
+    const char* getName() override;
+    uint32_t getBytesSent() override;
+    uint32_t getRoundTrips() override;
+
+private:
+    AsyncEventSource _events;
+    SseFanout _fanout;
+    char _payload[SSE_PAYLOAD_SIZE];    // data of the last event, sent again to a new subscriber
+    uint32_t _seq = 0;                  // id of the last event, 0: none yet
+    uint32_t _renderTime = 0;           // us, formatting and queueing of the last event
+
+    void onConnect(AsyncEventSourceClient* client);
+};
+#endif // SSE_PUBLISHER_H
@@ -0,0 +1,94 @@
+// tuplePool.cpp
+//
+// spans of the tuple pool shared by the requests waiting for transfer
+//
+// 2026-10-18 mh
+// - first version, allocation of the tuple pool taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+The tuples of all requests of VzHttp share one pool of VZ_TUPLE_POOL_SIZE tuples instead of a full batch per request.
+
+** Usage **
+if(pool.alloc(n, first)) ...          tuples of the new request go to _tuples[first] .. _tuples[first + n - 1]
+pool.release();                       the oldest request is completed
+
+** Implementation **
+The pool is used as a ring in the order of the requests, at most VZ_REQUEST_QUEUE_SIZE spans. The tuples of a request
+are contiguous: a span that does not fit at the end of the pool starts at its beginning, if the oldest span leaves
+room there. The pool holds one batch of max size and some small ones, which is what adaptive batching produces.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "tuplePool.h"
+
+bool TuplePool::alloc(uint16_t n, uint16_t& first)
+//
+// find n contiguous tuples after the span of the newest request, return false if full
+{
+  if(_count >= VZ_REQUEST_QUEUE_SIZE)
+  {
+    return false;
+  }
+  if(_count == 0)
+  {
+    if(n > VZ_TUPLE_POOL_SIZE)
+    {
+      return false;
+    }
+    first = 0;
+  }
+  else
+  {
+    uint8_t newest = (_oldest + _count - 1) % VZ_REQUEST_QUEUE_SIZE;
+    uint16_t head = _first[_oldest];
+    uint16_t tail = _end[newest];
+    if(_first[newest] >= head)        // used part is not wrapped: free space at the end and at the beginning
+    {
+      if((tail + n) <= VZ_TUPLE_POOL_SIZE)
+      {
+        first = tail;
+      }
+      else if(n <= head)
+      {
+        first = 0;
+      }
+      else
+      {
+        return false;
+      }
+    }
+    else if((tail + n) <= head)       // wrapped: free space between newest and oldest
+    {
+      first = tail;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  uint8_t i = (_oldest + _count) % VZ_REQUEST_QUEUE_SIZE;
+  _first[i] = first;
+  _end[i] = first + n;
+  _count++;
+  return true;
+}
+
+void TuplePool::release()
+//
+// free the span of the oldest request
+{
+  if(_count > 0)
+  {
+    _oldest = (_oldest + 1) % VZ_REQUEST_QUEUE_SIZE;
+    _count--;
+  }
+}
+
+uint8_t TuplePool::getCount()
+{
+  return _count;
+}
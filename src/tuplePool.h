@@ -0,0 +1,27 @@
+#ifndef TUPLE_POOL_H
+#define TUPLE_POOL_H
+//
+// 2026-10-18 mh
+// - first version, allocation of the tuple pool taken out of vzHttp.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+
+// contiguous spans of a pool of VZ_TUPLE_POOL_SIZE tuples for the requests of VzHttp, freed in the order of allocation
+class TuplePool
+{
+public:
+    bool alloc(uint16_t n, uint16_t& first);
+    void release();
+    uint8_t getCount();
+
+private:
+    uint16_t _first[VZ_REQUEST_QUEUE_SIZE];     // span of each request, ring in the order of the requests
+    uint16_t _end[VZ_REQUEST_QUEUE_SIZE];
+    uint8_t _oldest = 0;
+    uint8_t _count = 0;
+};
+#endif // TUPLE_POOL_H
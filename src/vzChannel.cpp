@@ -0,0 +1,217 @@
+// vzChannel.cpp
+//
+// registry of Volkszaehler channels: data source, UUID, interval and deadband of each channel
+//
+// 2026-10-18 mh
+// - VzChannelRegistry: iteration over the channels taken out of vzHttp.cpp; config parameters moved to
+//   vzChannelParameter.cpp
+// - first version, replaces the fixed enum UuidValueName and the UUID parameters in main.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Each of the VZ_MAX_CHANNELS entries of the registry binds a data source to a channel UUID of the data base.
+Source, UUID, interval and deadband of each entry are edited on the config page (one group per channel),
+so a value can be sent to another or an additional channel without recompiling.
+
+** Usage **
+addChannelParameters(confWeb, vzHttpConfig.channel);     config page, see vzChannelParameter.cpp
+
+VzChannelRegistry registry;
+registry.set(i, config.channel[i]);              for each entry of the config, see VzHttp::setChannel()
+VzTuple tuples[VZ_MAX_CHANNELS];
+n = registry.collect(snapshot, tuples);          tuples of the channels with a snapshot source, which are accepted
+n = registry.collect(source, timeStamp, value, tuples);    the same for the channels of one other source
+
+vzChannelInit(channel, config);                  runtime state from the config entry, see VzHttp::init()
+if(vzChannelAccept(channel, timeStamp, value))   interval and deadband are passed, value is to be sent
+  ...
+vzSnapshotValue(source, snapshot, value)         value of a snapshot source, false for other sources
+
+** Implementation **
+Sources vzSRC_POWER .. vzSRC_TEMP_INVERTER are taken from the snapshot of each inverter poll by VzHttp::publish(),
+all other sources are passed by VzHttp::publishValue() from the code that reads them (DS18B20, heart beat, energy of
+last day/month, test). Several channels may use the same source, e.g. with different intervals.
+A sample is accepted, if
+- interval is 0 or the sample is the first one in a new interval (timeStamp / interval changed), and
+- deadband is 0 or the value changed by at least deadband since the last accepted sample or the last accepted
+  sample is older than VZ_CHANNEL_REFRESH, so the graph in Volkszaehler does not end.
+VzChannelRegistry keeps the state of all channels. A channel is sent, if its source is not off and its UUID is set;
+these channels are a bit mask, so collect() and the body of a request skip the others by a bit test. The UUIDs are
+not copied, the registry points to the binary UUIDs of the config. The registry has no dependency on confWeb or the
+http client, so it runs in the native unit tests.
+  *** end description *** */
+
+#include <Arduino.h>
+#include <math.h>
+#include "vzChannel.h"
+
+static const char* const _sourceNames[N_VZ_SOURCE] = {
+  "off", "Power", "DC U", "DC I", "DC Power", "Energy Today", "Temp Inverter", "Temp DS18B20",
+  "Energy Last Day", "Energy Last Month", "Heart Beat", "Test"
+};
+
+static const uint8_t _uuidNoSend[VZ_UUID_SIZE] = {};   // used until set() is called with a valid configuration
+
+void vzChannelInit(VzChannel& channel, const VzChannelConfig& config)
+{
+  channel.source = atoi(config.source);
+  if(channel.source >= N_VZ_SOURCE)
+  {
+    channel.source = vzSRC_OFF;
+  }
+  channel.interval = strtoul(config.interval, nullptr, 10);
+  channel.deadband = atof(config.deadband);
+  channel.lastTimeStamp = 0;
+  channel.lastValue = 0;
+}
+
+bool vzChannelAccept(VzChannel& channel, uint32_t timeStamp, float value)
+//
+// check interval and deadband of a sample, remember it if accepted
+{
+  if(channel.lastTimeStamp != 0)
+  {
+    if((channel.interval > 0) && ((timeStamp / channel.interval) == (channel.lastTimeStamp / channel.interval)))
+    {
+      return false;
+    }
+    if((channel.deadband > 0) && (fabsf(value - channel.lastValue) < channel.deadband)
+        && ((timeStamp - channel.lastTimeStamp) < VZ_CHANNEL_REFRESH))
+    {
+      return false;
+    }
+  }
+  channel.lastTimeStamp = timeStamp;
+  channel.lastValue = value;
+  return true;
+}
+
+bool vzSnapshotValue(uint8_t source, const Snapshot& snapshot, float& value)
+//
+// value of a snapshot source, false if the source is not part of the snapshot
+{
+  switch (source)
+  {
+  case vzSRC_POWER:           value = snapshot.power;                 return true;
+  case vzSRC_DC_U:            value = snapshot.dcU;                   return true;
+  case vzSRC_DC_I:            value = snapshot.dcI;                   return true;
+  case vzSRC_DC_POWER:        value = snapshot.dcPower;               return true;
+  case vzSRC_ENERGY_TODAY:    value = snapshot.energyToday;           return true;
+  case vzSRC_TEMP_INVERTER:   value = snapshot.temperatureInverter;   return true;
+  default:                    return false;
+  }
+}
+
+const char* vzSourceName(uint8_t source)
+{
+  return (source < N_VZ_SOURCE) ? _sourceNames[source] : "?";
+}
+
+VzChannelRegistry::VzChannelRegistry()
+{
+  uint8_t i;
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
+  {
+    _uuid[i] = _uuidNoSend;
+    _channel[i].source = vzSRC_OFF;
+  }
+}
+
+void VzChannelRegistry::set(uint8_t channel, const VzChannelConfig& config)
+//
+// set entry of the registry; config must stay valid, the binary uuid is used directly
+{
+  if(channel >= VZ_MAX_CHANNELS)
+  {
+    return;
+  }
+  vzChannelInit(_channel[channel], config);
+  _uuid[channel] = config.uuid;
+  if(uuidIsSet(config.uuid) && (_channel[channel].source != vzSRC_OFF))
+  {
+    _sendMask |= (1 << channel);
+  }
+  else
+  {
+    _sendMask &= ~(1 << channel);
+  }
+}
+
+uint8_t VzChannelRegistry::collect(const Snapshot& snapshot, VzTuple* tuples)
+//
+// tuples of all channels to be sent with a snapshot source, whose value is accepted; tuples: VZ_MAX_CHANNELS entries
+{
+  uint8_t n = 0;
+  uint8_t ch;
+  float value;
+  for (ch=0;ch<VZ_MAX_CHANNELS;ch++)
+  {
+    if((_sendMask & (1 << ch)) && vzSnapshotValue(_channel[ch].source, snapshot, value)
+        && vzChannelAccept(_channel[ch], snapshot.timeStamp, value))
+    {
+      tuples[n].channel = ch;
+      tuples[n].timeStamp = snapshot.timeStamp;
+      tuples[n].value = value;
+      n++;
+    }
+  }
+  return n;
+}
+
+uint8_t VzChannelRegistry::collect(uint8_t source, uint32_t timeStamp, float value, VzTuple* tuples)
+//
+// tuples of all channels to be sent with this source, whose value is accepted; tuples: VZ_MAX_CHANNELS entries
+{
+  uint8_t n = 0;
+  uint8_t ch;
+  for (ch=0;ch<VZ_MAX_CHANNELS;ch++)
+  {
+    if((_sendMask & (1 << ch)) && (_channel[ch].source == source) && vzChannelAccept(_channel[ch], timeStamp, value))
+    {
+      tuples[n].channel = ch;
+      tuples[n].timeStamp = timeStamp;
+      tuples[n].value = value;
+      n++;
+    }
+  }
+  return n;
+}
+
+uint16_t VzChannelRegistry::getSourceMask(const VzTuple* tuples, uint16_t n)
+//
+// sources (bit 1 << VzSource) of the channels of tuples
+{
+  uint16_t mask = 0;
+  uint16_t i;
+  for (i=0;i<n;i++)
+  {
+    if(tuples[i].channel < VZ_MAX_CHANNELS)
+    {
+      mask |= (1 << _channel[tuples[i].channel].source);
+    }
+  }
+  return mask;
+}
+
+bool VzChannelRegistry::isSent(uint8_t channel)
+{
+  return (channel < VZ_MAX_CHANNELS) && (_sendMask & (1 << channel));
+}
+
+uint16_t VzChannelRegistry::getSendMask()
+{
+  return _sendMask;
+}
+
+const VzChannel& VzChannelRegistry::getChannel(uint8_t channel)
+{
+  return _channel[(channel < VZ_MAX_CHANNELS) ? channel : 0];
+}
+
+const uint8_t* VzChannelRegistry::getUuid(uint8_t channel)
+{
+  return _uuid[(channel < VZ_MAX_CHANNELS) ? channel : 0];
+}
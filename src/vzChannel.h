@@ -0,0 +1,76 @@
+#ifndef VZ_CHANNEL_H
+#define VZ_CHANNEL_H
+//
+// 2026-10-18 mh
+// - VzChannelRegistry; config parameters moved to vzChannelParameter.h
+// - first version, replaces enum UuidValueName
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+#include "publisher.h"
+#include "vzUuid.h"
+#include "vzQueue.h"
+
+// data sources of a channel; vzSRC_POWER .. vzSRC_TEMP_INVERTER are taken from the snapshot of an inverter poll
+enum VzSource : uint8_t
+{
+    vzSRC_OFF,
+    vzSRC_POWER,
+    vzSRC_DC_U,
+    vzSRC_DC_I,
+    vzSRC_DC_POWER,
+    vzSRC_ENERGY_TODAY,
+    vzSRC_TEMP_INVERTER,
+    vzSRC_TEMP_ROOM,            // DS18B20
+    vzSRC_ENERGY_LASTDAY,
+    vzSRC_ENERGY_LASTMONTH,
+    vzSRC_HEART_BEAT,
+    vzSRC_TEST,
+    N_VZ_SOURCE
+};
+
+struct VzChannelConfig    // one entry of the channel registry, edited on the config page
+{
+  char source[3];                 // VzSource as text (value of select parameter)
+  uint8_t uuid[VZ_UUID_SIZE];     // binary, all 0: VZ_UUID_NO_SEND
+  char interval[6];               // s; one tuple per interval, 0: every sample
+  char deadband[8];               // min change of value, 0: every sample
+};
+
+struct VzChannel          // runtime state of a channel
+{
+  uint8_t  source;
+  uint32_t interval;              // s
+  float    deadband;
+  uint32_t lastTimeStamp;         // s, last tuple passed to the batch, 0: none
+  float    lastValue;
+};
+
+void vzChannelInit(VzChannel& channel, const VzChannelConfig& config);
+bool vzChannelAccept(VzChannel& channel, uint32_t timeStamp, float value);
+bool vzSnapshotValue(uint8_t source, const Snapshot& snapshot, float& value);
+const char* vzSourceName(uint8_t source);
+
+// runtime state of all channels: source, UUID and whether the channel is sent
+class VzChannelRegistry
+{
+public:
+    VzChannelRegistry();
+    void set(uint8_t channel, const VzChannelConfig& config);
+    uint8_t collect(const Snapshot& snapshot, VzTuple* tuples);
+    uint8_t collect(uint8_t source, uint32_t timeStamp, float value, VzTuple* tuples);
+    uint16_t getSourceMask(const VzTuple* tuples, uint16_t n);
+    bool isSent(uint8_t channel);
+    uint16_t getSendMask();
+    const VzChannel& getChannel(uint8_t channel);
+    const uint8_t* getUuid(uint8_t channel);
+
+private:
+    VzChannel _channel[VZ_MAX_CHANNELS];
+    const uint8_t* _uuid[VZ_MAX_CHANNELS];
+    uint16_t _sendMask = 0;         // bit per channel, set if source is not off and UUID is not VZ_UUID_NO_SEND
+};
+#endif // VZ_CHANNEL_H
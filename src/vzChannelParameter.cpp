@@ -0,0 +1,102 @@
+// vzChannelParameter.cpp
+//
+// config parameters of the channel registry: source, UUID, interval and deadband of each Volkszaehler channel
+//
+// 2026-10-18 mh
+// - first version, moved from vzChannel.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Creates one parameter group per entry of the channel registry (see vzChannel.cpp) on the config page.
+
+** Usage **
+addChannelParameters(confWeb, vzHttpConfig.channel);     in setup(), before confWeb.init()
+validateChannelParameters(webRequestWrapper);            in the form validator, checks the UUIDs
+
+** Implementation **
+The defaults of the channels are the former fixed channels (VZ_UUID_xxx in config.h).
+The config parameters are created once at startup with new, as their number is given by VZ_MAX_CHANNELS.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "vzChannelParameter.h"
+#include "vzUuidParameter.h"
+
+struct VzChannelDefault
+{
+  uint8_t source;
+  const char* uuid;
+  const char* interval;
+};
+
+// former fixed channels, see config.h
+static const VzChannelDefault _defaults[] = {
+  {vzSRC_TEMP_ROOM,         VZ_UUID_TEMP_CH6,              "0"},
+  {vzSRC_POWER,             VZ_UUID_INV_POWER,             "0"},
+  {vzSRC_DC_U,              VZ_UUID_INV_DC_U,              "0"},
+  {vzSRC_DC_I,              VZ_UUID_INV_DC_I,              "0"},
+  {vzSRC_DC_POWER,          VZ_UUID_INV_DC_POWER,          "0"},
+  {vzSRC_ENERGY_LASTDAY,    VZ_UUID_INV_ENERGY_LASTDAY,    "0"},
+  {vzSRC_ENERGY_LASTMONTH,  VZ_UUID_INV_ENERGY_LASTMONTH,  "0"},
+  {vzSRC_ENERGY_TODAY,      VZ_UUID_INV_ENERGY_THISDAY,    VZ_INTERVAL_ENERGY_TODAY},
+  {vzSRC_HEART_BEAT,        VZ_UUID_INV_HEART_BEAT,        "0"},
+  {vzSRC_TEST,              VZ_UUID_TEST,                  "0"},
+};
+#define N_DEFAULTS (sizeof(_defaults) / sizeof(_defaults[0]))
+
+static char _sourceValues[N_VZ_SOURCE][sizeof(VzChannelConfig::source)];
+static char _sourceOptionNames[N_VZ_SOURCE][20];
+static char _groupNames[VZ_MAX_CHANNELS][12];      // "Channel 12"
+static char _ids[VZ_MAX_CHANNELS][4][8];           // "vzc12s"
+static UuidParameter* _uuidParams[VZ_MAX_CHANNELS];
+
+void addChannelParameters(IotWebConf& confWeb, VzChannelConfig* config)
+//
+// create a parameter group with source, UUID, interval and deadband for each channel
+{
+  uint8_t i;
+  for (i=0;i<N_VZ_SOURCE;i++)
+  {
+    snprintf(_sourceValues[i], sizeof(_sourceValues[i]), "%u", i);
+    strncpy(_sourceOptionNames[i], vzSourceName(i), sizeof(_sourceOptionNames[i]) - 1);
+  }
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
+  {
+    const VzChannelDefault* def = (i < N_DEFAULTS) ? &_defaults[i] : nullptr;
+    snprintf(_groupNames[i], sizeof(_groupNames[i]), "Channel %u", i + 1);
+    snprintf(_ids[i][0], sizeof(_ids[i][0]), "vzc%us", i + 1);
+    snprintf(_ids[i][1], sizeof(_ids[i][1]), "vzc%uu", i + 1);
+    snprintf(_ids[i][2], sizeof(_ids[i][2]), "vzc%ui", i + 1);
+    snprintf(_ids[i][3], sizeof(_ids[i][3]), "vzc%ud", i + 1);
+
+    ParameterGroup* group = new ParameterGroup(_groupNames[i], _groupNames[i]);
+    group->addItem(new SelectParameter("Source", _ids[i][0], config[i].source, sizeof(config[i].source),
+                                       (char*)_sourceValues, (char*)_sourceOptionNames, N_VZ_SOURCE, sizeof(_sourceOptionNames[0]),
+                                       _sourceValues[def ? def->source : vzSRC_OFF]));
+    _uuidParams[i] = new UuidParameter("UUID", _ids[i][1], config[i].uuid,
+                                       def ? def->uuid : VZ_UUID_NO_SEND);
+    group->addItem(_uuidParams[i]);
+    group->addItem(new NumberParameter("Interval[s]", _ids[i][2], config[i].interval, sizeof(config[i].interval),
+                                       def ? def->interval : "0", nullptr, "min='0' max='86400' step='1'"));
+    group->addItem(new NumberParameter("Deadband", _ids[i][3], config[i].deadband, sizeof(config[i].deadband),
+                                       "0", nullptr, "min='0' step='any'"));
+    confWeb.addParameterGroup(group);
+  }
+}
+
+bool validateChannelParameters(WebRequestWrapper* webRequestWrapper)
+{
+  bool valid = true;
+  uint8_t i;
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
+  {
+    if(_uuidParams[i] != nullptr)
+    {
+      valid &= _uuidParams[i]->validate(webRequestWrapper);
+    }
+  }
+  return valid;
+}
@@ -0,0 +1,17 @@
+#ifndef VZ_CHANNEL_PARAMETER_H
+#define VZ_CHANNEL_PARAMETER_H
+//
+// 2026-10-18 mh
+// - first version, moved from vzChannel.h
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <confWeb.h>
+#include <confWebParameter.h>
+#include "vzChannel.h"
+
+void addChannelParameters(IotWebConf& confWeb, VzChannelConfig* config);
+bool validateChannelParameters(WebRequestWrapper* webRequestWrapper);
+#endif // VZ_CHANNEL_PARAMETER_H
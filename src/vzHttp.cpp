@@ -2,6 +2,26 @@
 //
 // transfer data to and from a web server
 //
+// 2026-10-18 mh
+// - counters per channel in ChannelStats (channelStats.cpp)
+// - iteration over the channels in VzChannelRegistry (vzChannel.cpp)
+// - adaptive batching in BatchControl, allocation of the tuple pool in TuplePool
+// - body size derived from VZ_MAX_CHANNELS and VZ_BATCH_SIZE, a body that does not fit is not sent
+// - delay to the publish slot measured from the sample time, passed slot taken at once (publishSlot.cpp)
+// - outcome of each request counted for the channels of its tuples, getFailingMask(), printChannelStats()
+// - replay of queued tuples with Content-Encoding gzip (gzip.cpp), plain again after the server rejected it
+// - channel registry: publish() and publishValue() map sources to channels, interval and deadband per channel
+// - UUIDs in binary form, formatted into the body by FmtBuf::addUuid(); channels to be sent in _sendMask
+// - adaptive batching: batches are held back and widened, when the server is slow or fails
+// - transfers start in a per device slot of the publish window, min VZ_PACE_INTERVAL between requests
+// - publish() of Publisher interface adds the frequent values of a snapshot
+// - body composed in fixed buffer by FmtBuf, request header precomputed, no heap allocation per request
+// - connect by cached IP of the server, see dnsCache.cpp
+// - asynchronous transfer using AsyncHttp (ESPAsyncTCP), postHttp() removed
+// - tuples of failed transfers are stored in VzQueue and sent later by doLoop()
+// - keep one persistent http/1.1 keep-alive connection, closed after VZ_HTTP_IDLE_TIMEOUT
+// - batch transfer: addTuple() collects tuples, flushBatch() sends all of them with one request
+//
 // 2023-02-14 mh
 // - split up input for server url
 // - not transmission, if uuid = VZ_UUID_NO_SEND
@@ -22,21 +42,77 @@
 
 
 /* *** Description ***
-http transfer of a data tupel (timestamp,value) of a sensor channel to the Volkszaehler data base via middleware.php
+http transfer of data tupels (timestamp,value) of sensor channels to the Volkszaehler data base via middleware.php
 timestamp is Unix epoch time in seconds.
 sensor channel is defined by its data base UUID.
 
 
 ** Usage **
-vzHttp.postHttp(vzUUID, s_timeStamp, value);
+Several tuples of several channels are sent with one http request:
+vzHttp.setCompletionCallback(onPublishDone);   called with http response code after each transfer
+vzHttp.setDeliveryCallback(onPublishDelivery); called with the sources of a batch when its fate is known
+vzHttp.publish(snapshot);                       values of the snapshot sources for all channels of the registry
+vzHttp.publishValue(vzSRC_HEART_BEAT, timeStamp, count);   value of another source
+vzHttp.flushBatch();                            returns immediately, transfer is done in the background
+vzHttp.doLoop();                                call in loop()
 
 The server name where middleware.php is hosted is given by the define VZ_SERVER.
 
 ** Implementation **
-For transfer to volkszaehler, the http transfer should look like this:
-// http://volks-raspi/middleware.php/data.json?uuid=ae53c580-1234-5678-90ab-cdefghijklmn&operation=add&ts=1666801000000&value=22
+The JSON array form of the middleware is used, i.e. multiple tuples per channel and multiple channels are posted
+as one body to http://volks-raspi/middleware.php/data.json:
+[{"uuid":"ae53c580-...","tuples":[[1666801000000,22.00],[1666801060000,22.50]]},{"uuid":"...","tuples":[[...]]}]
+The channels are the entries of the channel registry (VzChannelRegistry, see vzChannel.cpp). publish() lets the
+registry collect the value of each channel with a snapshot source, publishValue() does the same for the channels of
+one other source; interval and deadband of a channel decide whether a tuple is added. A tuple stores the index of the channel.
+Tuples are collected in a fixed array of VZ_BATCH_SIZE entries; if the max batch size (config) is reached, it is
+flushed automatically.
+Adaptive batching (BatchControl, see batchControl.cpp): after each request the moving averages of latency and error
+rate are updated. If the server is slow, batch target and flush interval are doubled up to the bounds from the config
+page; flushBatch() then holds the tuples back until the batch target or the flush interval is reached, so the server
+gets fewer, larger requests. When the server is fast again, both are halved step by step until every flushBatch() is
+sent at once.
+To avoid that all loggers of a site, which align their timestamps to the same interval, post in the same second,
+the transfer of a batch is delayed until the slot of this device: an offset within the publish window (config,
+seconds) after the aligned timestamp of its newest tuple, derived from a hash of the chip id (publishSlot.cpp). A
+slot that has passed already when the batch is flushed is taken at once. The timestamps are not changed.
+All requests (batches, queued tuples) are sent one after the other with at least VZ_PACE_INTERVAL in between.
+The body is formatted into the fixed buffer _body (VZ_BODY_SIZE) with integer arithmetic (FmtBuf), the binary UUIDs
+of the config buffers (see vzUuid.cpp) are formatted directly into it, channels set to VZ_UUID_NO_SEND are skipped by
+a bit test of the send mask of the registry (updated by setChannel()) and the request header is composed once when the server is set, so posting
+does not allocate heap memory. getBuildHeapDelta() reports the heap used while building a body (expected 0).
+
+flushBatch() moves the batch into a ring of VZ_REQUEST_QUEUE_SIZE requests. The tuples of all requests share one
+pool of VZ_TUPLE_POOL_SIZE tuples, used as a ring in the order of the requests (TuplePool, see tuplePool.cpp); the
+tuples of a request are contiguous, a request that does not fit at the end of the pool starts at its beginning. The pool holds one batch of
+max size and some small ones, which is what adaptive batching produces: small batches while the server is fast,
+few large ones held back while it is slow. A batch that does not fit is stored in the queue. doLoop() builds the body of the oldest
+request and passes it to AsyncHttp, which sends it from the tcp callbacks of ESPAsyncTCP without blocking loop()
+(keep-alive connection, timeout, reconnect, see asyncHttp.cpp). The server name is resolved once and the IP is
+kept in a DNS cache with TTL; getServerIP() and getDnsXXX() show the IP and the lookup statistics. When the response is complete, doLoop() calls the
+completion callback with the http response code, so status LEDs and httpStatus can be set.
 
-Implementation is done using classes WiFiClient and HTTPClient.
+If a VzQueue is set by setQueue(), a batch that could not be sent (no WiFi, transport error, server error 5xx,
+request ring full) is stored in the queue. doLoop() sends the queued tuples in batches of max batch size every
+VZ_QUEUE_DRAIN_INTERVAL ms, as soon as the server answered a request with 200 again.
+A batch rejected by the server with 4xx is dropped.
+The delivery callback gets the sources (bit 1 << VzSource) of each batch with saved = true, when it was answered with
+2xx or stored in the queue, and with saved = false, when it was dropped (4xx, no queue or queue not writable). So a
+value that is sent only once (e.g. energy of last day) can be published again until it is saved.
+If gzip replay is configured, the body of a queued batch is compressed (gzip.cpp, into _gzBody of VZ_GZIP_SIZE) and
+sent with Content-Encoding: gzip, which reduces the transfer time over a weak WiFi after a long outage. The server
+has to decompress the request body (e.g. Apache: SetInputFilter DEFLATE for the middleware). If it answers a
+compressed request with 415 (Unsupported Media Type) or 400 (middleware got the compressed body as JSON), the tuples
+stay in the queue and are sent uncompressed; gzip is tried again after VZ_GZIP_RETRY. Other errors of a compressed
+request take the normal path (5xx: tuples stay in the queue, other 4xx: dropped). A body that does not get smaller or does not fit into _gzBody is sent plain.
+getGzipInBytes()/getGzipOutBytes() give the compression ratio, getLastReplayTime() the duration of the last replay.
+
+complete() counts the outcome of each request (2xx, 4xx, 5xx, transport error, latency, time of last success) for
+every channel that has at least one tuple in the request, so a batch of several channels counts once per channel
+(ChannelStats, see channelStats.cpp).
+getFailingMask() gives the channels to be sent whose last request was not answered with 2xx; it drives the status LED
+and the dash board card. printChannelStats() writes the table as JSON (endpoint /api/channels.json). The statistics
+of a channel are reset by setChannel().
 
   *** end description *** */
 
@@ -51,19 +127,24 @@ Implementation is done using classes WiFiClient and HTTPClient.
   (see in Tools > Boards > Boards Manager > ESP8266)
 */
 #include <string.h>
-#include <ESP8266HTTPClient.h>
-
-#include <WiFiClient.h>
+#include <ESP8266WiFi.h>
 #include "vzHttp.h"
+#include "vzQueue.h"
+#include "publishSlot.h"
+#include "fmtBuf.h"
+#include "gzip.h"
 #include "config.h"
 
+// longest text of a channel: {"uuid":"<36>","tuples":[]} and comma; of a tuple: [<10>000,-4294967040.00] and comma
+#define BODY_CHANNEL_MAX  60
+#define BODY_TUPLE_MAX    31
+static_assert(VZ_BODY_SIZE >= (VZ_MAX_CHANNELS * BODY_CHANNEL_MAX + VZ_BATCH_SIZE * BODY_TUPLE_MAX + 3),
+              "VZ_BODY_SIZE does not hold a batch of VZ_BATCH_SIZE tuples of all channels");
+
 VzHttp::VzHttp()
 {
 }
 
-WiFiClient _client;
-HTTPClient http;
-
 
 void VzHttp::init(VzHttpConfig &config)
 {
@@ -71,85 +152,606 @@ void VzHttp::init(VzHttpConfig &config)
   //
   _serverName = String(config.vzServer);
   _middlewareName = String(config.vzMiddleware);
+  buildUrl();
   DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"vzServer: %s",_serverName.c_str());
   DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"vzMiddleware: %s",_middlewareName.c_str());
 
   uint16_t i;
-  for (i=0;i<N_UUID_VALUE;i++)
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
   {
-    _uuid[i] = &config.uuidValue[i][0];
-    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"uuid[%d] = %s",i,_uuid[i]);
+    setChannel(i, config.channel[i]);
   }
-
+  setPublishWindow(atoi(config.publishWindow));
+  setBatchLimits(atoi(config.maxBatch), atol(config.maxFlushInterval));
+  setGzipReplay(config.gzipReplay[0] == '1');
 };
 
+void VzHttp::setGzipReplay(bool enable)
+{
+  _gzipReplay = enable;
+  _gzipRejected = false;
+}
+
+void VzHttp::setBatchLimits(uint16_t maxBatch, uint32_t maxFlushInterval)
+//
+// bounds of adaptive batching: max tuples per request, max time (s) a batch is held back
+{
+  _control.setLimits(maxBatch, maxFlushInterval * 1000);
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"max batch %u tuples, max flush interval %u s",_control.getMaxBatch(),maxFlushInterval);
+}
+
+void VzHttp::setPublishWindow(uint16_t windowSeconds)
+//
+// deterministic offset of this device within the window, derived from the chip id
+{
+  uint32_t window = windowSeconds;
+  if(window > INVERTER_READ_INTERVAL_FREQUENT)
+  {
+    window = INVERTER_READ_INTERVAL_FREQUENT;
+  }
+  _publishOffset = publishSlotOffset(ESP.getChipId(), window);
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"publish window %u s, offset %u ms",window,_publishOffset);
+}
+
+uint32_t VzHttp::getPublishOffset()
+{
+  return _publishOffset;
+}
+
+uint32_t VzHttp::delayToSlot(uint32_t sampleTime)
+//
+// ms until the slot of this device after the aligned sample time (UNIX epoch time in s), 0 if it has passed
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  if((_publishOffset == 0) || (tv.tv_sec < 1672531200))   // no window or no valid time yet
+  {
+    return 0;
+  }
+  uint32_t period = INVERTER_READ_INTERVAL_FREQUENT * 1000UL;
+  uint32_t aligned = sampleTime - (sampleTime % INVERTER_READ_INTERVAL_FREQUENT);
+  if((uint32_t)tv.tv_sec < aligned)
+  {
+    return publishSlotDelay(_publishOffset, 0, period);
+  }
+  uint32_t elapsed = (uint32_t)tv.tv_sec - aligned;
+  if(elapsed >= INVERTER_READ_INTERVAL_FREQUENT)
+  {
+    return 0;
+  }
+  return publishSlotDelay(_publishOffset, elapsed * 1000UL + tv.tv_usec / 1000, period);
+}
+
 void VzHttp::setServerName(String serverName)
 {
   _serverName = serverName;
+  buildUrl();
 };
 void VzHttp::setMiddlewareName(String middlewareName)
 {
   _middlewareName = middlewareName;
+  buildUrl();
+};
+void VzHttp::setChannel(uint8_t channel, const VzChannelConfig& config)
+//
+// set entry of the channel registry; config must stay valid, the binary uuid is used directly
+{
+  if(channel >= VZ_MAX_CHANNELS)
+  {
+    return;
+  }
+  _registry.set(channel, config);
+  _stats.reset(channel);
+  const VzChannel& state = _registry.getChannel(channel);
+  char text[VZ_UUID_TEXT_LEN + 1];
+  uuidFormat(config.uuid, text);
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"channel %d: %s, uuid %s, interval %u s, deadband %.2f",channel,
+              vzSourceName(state.source),text,state.interval,state.deadband);
 };
+void VzHttp::setQueue(VzQueue* queue)
+{
+  _queue = queue;
+};
+void VzHttp::setCompletionCallback(std::function<void(int httpResponseCode)> func)
+{
+  _completionCallback = func;
+};
+void VzHttp::setDeliveryCallback(std::function<void(uint16_t sourceMask, bool saved)> func)
+{
+  _deliveryCallback = func;
+};
+
+void VzHttp::buildUrl()
+{
+  _vzPath = "/" + _middlewareName + "/" + String(VZ_DATA_JSON);
+  _http.setServer(_serverName, _vzPath, "application/json");
+}
+
+bool VzHttp::addTuple(uint8_t channel, uint32_t timeStamp, float value)
+//
+// collect a tuple for the next flushBatch(), flush automatically if the batch is full.
+// return false, if the tuple is not used (channel not to be sent).
+{
+  if(!_registry.isSent(channel))
+  {
+    return false;
+  }
+  if(_nBatch >= _control.getMaxBatch())
+  {
+    handOver(false);
+  }
+  _batch[_nBatch].channel = channel;
+  _batch[_nBatch].timeStamp = timeStamp;
+  _batch[_nBatch].value = value;
+  _nBatch++;
+  return true;
+}
+
+bool VzHttp::publish(const Snapshot& snapshot)
+//
+// Publisher: collect the values of all channels with a snapshot source, sent with the next flushBatch()
+{
+  VzTuple tuples[VZ_MAX_CHANNELS];
+  uint8_t n = _registry.collect(snapshot, tuples);
+  uint8_t i;
+  for (i=0;i<n;i++)
+  {
+    addTuple(tuples[i].channel, tuples[i].timeStamp, tuples[i].value);
+  }
+  return true;
+}
 
-int VzHttp::postHttp(String vzUUID, String timeStamp, float value)
+bool VzHttp::publishValue(VzSource source, uint32_t timeStamp, float value)
+//
+// collect a value of a source which is not part of the snapshot for all channels of this source.
+// return true, if at least one channel takes the value.
 {
+  bool used = false;
+  VzTuple tuples[VZ_MAX_CHANNELS];
+  uint8_t n = _registry.collect(source, timeStamp, value, tuples);
+  uint8_t i;
+  for (i=0;i<n;i++)
+  {
+    used |= addTuple(tuples[i].channel, tuples[i].timeStamp, tuples[i].value);
+  }
+  return used;
+}
 
-    //For transfer to volkszaehler, the http transfer should look like this:
-    // http://volks-raspi/middleware.php/data.json?uuid=ae53c580-1234-5678-90ab-cdefghijklmn&operation=add&ts=1666801000000&value=22
+bool VzHttp::flushBatch(bool immediate)
+//
+// pass all collected tuples to the asynchronous transfer, the result is reported by the completion callback.
+// while the server is slow, the tuples are held back until the batch target or the flush interval is reached.
+// the transfer starts in the slot of this device, if immediate is false.
+// return true, if the tuples are held back, accepted for transfer or stored.
+{
+  if(_nBatch == 0)
+  {
+    return false;
+  }
+  if(!immediate && (_nBatch < _control.getBatchTarget()) && ((millis() - _lastFlushTime) < _control.getFlushInterval()))
+  {
+    return true;
+  }
+  return handOver(immediate);
+}
+
+bool VzHttp::handOver(bool immediate)
+//
+// move the batch into the request ring.
+// without WiFi or if too many requests are waiting, the tuples are stored in the queue.
+{
+  _lastFlushTime = millis();
+
+  bool accepted;
+  uint16_t first;
+  if((WiFi.status() == WL_CONNECTED) && (_reqCount < VZ_REQUEST_QUEUE_SIZE) && _pool.alloc(_nBatch, first))
+  {
+    VzRequest& request = _requests[(_reqFirst + _reqCount) % VZ_REQUEST_QUEUE_SIZE];
+    request.first = first;
+    memcpy(&_tuples[first], _batch, _nBatch * sizeof(VzTuple));
+    request.n = _nBatch;
+    request.fromQueue = false;
+    request.gzip = false;
+    request.due = millis() + (immediate ? 0 : delayToSlot(_batch[_nBatch - 1].timeStamp));
+    _reqCount++;
+    accepted = true;
+  }
+  else
+  {
+    accepted = store(_batch, _nBatch);
+    delivered(_batch, _nBatch, accepted);
+  }
+  _nBatch = 0;
+  return accepted;
+}
 
+bool VzHttp::isIdle()
+//
+// true, if there is nothing to be sent
+{
+  return (_nBatch == 0) && (_reqCount == 0) && !_http.isBusy();
+}
 
-  if(!strcmp(vzUUID.c_str(),VZ_UUID_NO_SEND))
+void VzHttp::doLoop()
+//
+// start transfer of waiting requests when due, evaluate completed transfers, send queued tuples rate limited.
+// all requests are serialized, at least VZ_PACE_INTERVAL apart.
+{
+  _http.doLoop();
+  if(_http.hasResult())
+  {
+    complete(_http.takeResult());
+  }
+  uint32_t flushInterval = _control.getFlushInterval();
+  if((_nBatch > 0) && ((millis() - _lastFlushTime) >= flushInterval) && (flushInterval > 0))
   {
-    return -99;
+    handOver(false);      // held back batch, no further flushBatch() within flush interval
+  }
+  if(_http.isBusy() || (WiFi.status() != WL_CONNECTED) || ((millis() - _lastSendTime) < VZ_PACE_INTERVAL))
+  {
+    return;
   }
-  String vzUrl = "http://";
-  vzUrl += _serverName + "/" + _middlewareName;
-  vzUrl += "/" + String(VZ_DATA_JSON);
 
-  if(!http.begin(_client, vzUrl))
+  if((_reqCount == 0) && (_queue != nullptr) && _serverUp && ((millis() - _lastDrainTime) >= VZ_QUEUE_DRAIN_INTERVAL))
   {
-    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"No connection to %s",_serverName.c_str());
-    return 404;
-  };
+    VzRequest& request = _requests[_reqFirst];
+    request.n = _queue->read(_tuples, _control.getMaxBatch(), request.queueSeg, request.queuePos);
+    if(request.n > 0)
+    {
+      _pool.alloc(request.n, request.first);      // pool is empty: span from 0, where the tuples were read to
+      _lastDrainTime = millis();
+      request.fromQueue = true;
+      request.gzip = false;
+      request.due = millis();
+      _reqCount = 1;
+      if(_replayStartTime == 0)
+      {
+        _replayStartTime = millis() | 1;
+      }
+    }
+  }
 
-  //http.setAuthorization("REPLACE_WITH_SERVER_USERNAME", "REPLACE_WITH_SERVER_PASSWORD");
+  if((_reqCount > 0) && ((int32_t)(millis() - _requests[_reqFirst].due) >= 0))
+  {
+    VzRequest& request = _requests[_reqFirst];
+    _lastSendTime = millis();
+    uint32_t heapBefore = ESP.getFreeHeap();
+    size_t len = buildBody(&_tuples[request.first], request.n);
+    uint32_t heapAfter = ESP.getFreeHeap();
+    if((heapBefore > heapAfter) && ((heapBefore - heapAfter) > _buildHeapDelta))
+    {
+      _buildHeapDelta = heapBefore - heapAfter;
+    }
+    if(len == 0)
+    {
+      complete(VZ_HTTP_ERROR_BODY_OVERFLOW);    // never post a truncated body
+      return;
+    }
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"Post message: %s",_body);
+    if(_gzipRejected && ((millis() - _gzipRejectTime) >= VZ_GZIP_RETRY))
+    {
+      _gzipRejected = false;      // server may be configured meanwhile
+    }
+    size_t gzLen = 0;
+    if(request.fromQueue && _gzipReplay && !_gzipRejected)
+    {
+      gzLen = gzipCompress((const uint8_t*)_body, len, _gzBody, sizeof(_gzBody));
+    }
+    request.gzip = (gzLen > 0) && (gzLen < len);
+    if(request.gzip)
+    {
+      DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"gzip %u -> %u bytes",len,gzLen);
+      _gzipInBytes += len;
+      _gzipOutBytes += gzLen;
+    }
+    bool started = request.gzip ? _http.post((const char*)_gzBody, gzLen, "gzip") : _http.post(_body, len);
+    if(!started)
+    {
+      complete(ASYNC_HTTP_ERROR_SEND_HEADER_FAILED);    // e.g. header rejected by setServer(), request must not block the ring
+    }
+  }
+}
 
-  // HTTP request with a content type: x-www-form-urlencoded
-  http.addHeader("Content-Type", "application/x-www-form-urlencoded");
+void VzHttp::complete(int httpResponseCode)
+//
+// evaluate result of the oldest request
+{
+  if(_reqCount == 0)
+  {
+    return;
+  }
+  VzRequest& request = _requests[_reqFirst];
+  bool failed = (httpResponseCode < 0) || (httpResponseCode >= 500);
+  bool fromQueue = request.fromQueue;
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"HTTP Response code: %d, %d tuples%s%s",httpResponseCode,request.n,
+              fromQueue ? " from queue" : "",request.gzip ? " gzip" : "");
 
-  //construct the message body
-  //example for data to be sent: uuid=ae53c580-1234-5678-90ab-cdefghijklmn&operation=add&ts=1666801000000&value=22
+  _serverUp = (200 == httpResponseCode);
+  adapt(failed);
+  _stats.count(&_tuples[request.first], request.n, httpResponseCode, _http.getLastLatency(), time(nullptr));
+  if(request.gzip && ((httpResponseCode == 415) || (httpResponseCode == 400)))
+  {
+    // compressed body not accepted (no input filter for gzip at the server): tuples stay in the queue, sent plain
+    DEBUG_TRACE(true,"vzHttp: gzip rejected by server (%d), replay uncompressed",httpResponseCode);
+    _gzipRejected = true;
+    _gzipRejectTime = millis();
+    _serverUp = true;
+  }
+  else if(fromQueue)
+  {
+    if(!failed)
+    {
+      _queue->commit(request.queueSeg, request.queuePos, request.n);    // sent, or rejected by server (4xx) and dropped
+      if((_queue->count() == 0) && (_replayStartTime != 0))
+      {
+        _lastReplayTime = millis() - _replayStartTime;
+        _replayStartTime = 0;
+        DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"vzHttp: queue replayed in %u ms",_lastReplayTime);
+      }
+    }
+  }
+  else
+  {
+    bool ok = (httpResponseCode >= 200) && (httpResponseCode < 300);
+    const VzTuple* tuples = &_tuples[request.first];
+    delivered(tuples, request.n, ok || (failed && store(tuples, request.n)));
+  }
+  _reqFirst = (_reqFirst + 1) % VZ_REQUEST_QUEUE_SIZE;
+  _reqCount--;
+  _pool.release();
 
-   String httpRequestData = "uuid=" + vzUUID;
-   String httpOperation = "&operation=add";
-   
-   String s_timestamp = "&ts=";
-   s_timestamp += timeStamp;
-   s_timestamp += "000";   // convert seconds to milli seconds
-  
-   String s_value = "&value="; 
-   s_value += String(value);
-   
-   httpRequestData = httpRequestData + s_timestamp + s_value;
-   DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"Post message: %s",httpRequestData.c_str());
-
-  int httpResponseCode = http.POST(httpRequestData);
-
-  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"HTTP Response code: %d",httpResponseCode);
-      
-  // Free resources
-  http.end();
-  return httpResponseCode;
-};
+  if(!fromQueue && (_completionCallback != nullptr))
+  {
+    _completionCallback(httpResponseCode);
+  }
+}
+
+void VzHttp::delivered(const VzTuple* tuples, uint16_t n, bool saved)
+//
+// report the sources of a batch to the delivery callback: saved (sent or queued) or dropped
+{
+  if(_deliveryCallback == nullptr)
+  {
+    return;
+  }
+  _deliveryCallback(_registry.getSourceMask(tuples, n), saved);
+}
+
+void VzHttp::adapt(bool failed)
+//
+// adaptive batching: batch target and flush interval follow latency and error rate (see batchControl.cpp)
+{
+  _control.update(_http.getLastLatency(), failed);
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"latency avg %u ms, error rate %u, batch target %u, flush interval %u ms",
+              _control.getLatencyAvg(),_control.getErrorRate(),_control.getBatchTarget(),_control.getFlushInterval());
+}
+
+const VzChannelStats& VzHttp::getChannelStats(uint8_t channel)
+{
+  return _stats.get(channel);
+}
+
+uint16_t VzHttp::getSendMask()
+{
+  return _registry.getSendMask();
+}
+
+uint16_t VzHttp::getFailingMask()
+//
+// channels to be sent, whose last request was not answered with 2xx
+{
+  return _stats.getFailingMask(_registry.getSendMask());
+}
+
+void VzHttp::printChannelStats(Print& out)
+//
+// statistics of all channels to be sent as JSON, channel numbers as on the config page
+{
+  char text[VZ_UUID_TEXT_LEN + 1];
+  bool first = true;
+  uint8_t i;
+  out.print("{\"channels\":[");
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
+  {
+    if(!_registry.isSent(i))
+    {
+      continue;
+    }
+    const VzChannelStats& stats = _stats.get(i);
+    uuidFormat(_registry.getUuid(i), text);
+    out.printf("%s{\"channel\":%u,\"source\":\"%s\",\"uuid\":\"%s\",\"attempts\":%u,\"ok\":%u,\"4xx\":%u,\"5xx\":%u,"
+               "\"transport\":%u,\"lastCode\":%d,\"lastLatency\":%u,\"lastSuccess\":%u}",
+               first ? "" : ",", i + 1, vzSourceName(_registry.getChannel(i).source), text, stats.attempts, stats.ok,
+               stats.clientError, stats.serverError, stats.transportError, stats.lastCode, stats.lastLatency,
+               stats.lastSuccess);
+    first = false;
+  }
+  out.print("]}");
+}
+
+bool VzHttp::isGzipRejected()
+{
+  return _gzipRejected;
+}
+
+uint32_t VzHttp::getGzipInBytes()
+{
+  return _gzipInBytes;
+}
+
+uint32_t VzHttp::getGzipOutBytes()
+{
+  return _gzipOutBytes;
+}
+
+uint32_t VzHttp::getLastReplayTime()
+{
+  return _lastReplayTime;
+}
+
+uint16_t VzHttp::getBatchTarget()
+{
+  return _control.getBatchTarget();
+}
+
+uint32_t VzHttp::getFlushInterval()
+{
+  return _control.getFlushInterval();
+}
+
+uint32_t VzHttp::getLatencyAvg()
+{
+  return _control.getLatencyAvg();
+}
+
+uint16_t VzHttp::getErrorRate()
+{
+  return _control.getErrorRate();
+}
+
+bool VzHttp::store(const VzTuple* tuples, uint16_t n)
+//
+// store tuples in queue for later transfer
+{
+  if(_queue == nullptr)
+  {
+    return false;
+  }
+  return _queue->push(tuples, n) == n;
+}
+
+size_t VzHttp::buildBody(const VzTuple* tuples, uint16_t n)
+//
+// compose JSON body of a batch in _body, tuples are grouped by channel:
+// [{"uuid":"...","tuples":[[ts,value],[ts,value]]},{"uuid":"...","tuples":[[ts,value]]}]
+// return length of body, 0 if it does not fit (not possible for n <= VZ_BATCH_SIZE, see static_assert)
+{
+  FmtBuf body(_body, sizeof(_body));
+  body.add('[');
+  bool firstChannel = true;
+  uint16_t ch, i;
+  for (ch=0;ch<VZ_MAX_CHANNELS;ch++)
+  {
+    if(!_registry.isSent(ch))
+    {
+      continue;         // queued tuples of a channel that is switched off meanwhile
+    }
+    bool firstTuple = true;
+    for (i=0;i<n;i++)
+    {
+      if(tuples[i].channel != ch)
+      {
+        continue;
+      }
+      if(firstTuple)
+      {
+        if(!firstChannel)
+        {
+          body.add(',');
+        }
+        body.add("{\"uuid\":\"").addUuid(_registry.getUuid(ch)).add("\",\"tuples\":[");
+        firstChannel = false;
+      }
+      else
+      {
+        body.add(',');
+      }
+      body.add('[').addUint(tuples[i].timeStamp).add("000,").addFixed(tuples[i].value, 2).add(']');  // ts in ms
+      firstTuple = false;
+    }
+    if(!firstTuple)
+    {
+      body.add("]}");
+    }
+  }
+  body.add(']');
+  if(body.overflow())
+  {
+    DEBUG_TRACE(true,"vzHttp: body exceeds VZ_BODY_SIZE, not sent");
+    return 0;
+  }
+  return body.length();
+}
+
+uint16_t VzHttp::getBatchCount()
+{
+  return _nBatch;
+}
+
+uint32_t VzHttp::getRequestCount()
+{
+  return _http.getRequestCount();
+}
+
+uint32_t VzHttp::getConnectCount()
+{
+  return _http.getConnectCount();
+}
+
+uint32_t VzHttp::getReconnectCount()
+{
+  return _http.getReconnectCount();
+}
+
+uint32_t VzHttp::getLastLatency()
+{
+  return _http.getLastLatency();
+}
+
+uint32_t VzHttp::getAvgLatency()
+{
+  return _http.getAvgLatency();
+}
+
+String VzHttp::getServerIP()
+{
+  return _http.getDns().getIPString();
+}
+
+uint32_t VzHttp::getDnsLookupCount()
+{
+  return _http.getDns().getLookupCount();
+}
+
+uint32_t VzHttp::getDnsFailCount()
+{
+  return _http.getDns().getFailCount();
+}
+
+uint32_t VzHttp::getDnsLookupTime()
+{
+  return _http.getDns().getLastLookupTime();
+}
+
+const char* VzHttp::getName()
+{
+  return "Volkszaehler";
+}
+
+uint32_t VzHttp::getBytesSent()
+{
+  return _http.getBytesSent();
+}
+
+uint32_t VzHttp::getRoundTrips()
+{
+  return _http.getRequestCount();
+}
+
+uint32_t VzHttp::getBuildHeapDelta()
+//
+// max heap consumed while building a request body, 0 if the publish path is free of heap allocation
+{
+  return _buildHeapDelta;
+}
 
 String VzHttp::getTimeStamp()
 {
   return _TimeStamp;
 }
-float VzHttp::getValue(UuidValueName _select)
+float VzHttp::getTestValue()
 {
-  return _value[_select];
+  return _testValue;
 }
 void VzHttp::testHttp()
 //
@@ -162,13 +764,12 @@ void VzHttp::testHttp()
   if((currentTime-lastSendTime) > MY_TEST_SEND_UPDATE)
   {
     lastSendTime = currentTime;
-    String _vzUUID = String(_uuid[vzTEST]);
       struct timeval tv;                      // defined in time.h
       gettimeofday(&tv, NULL);                // use local time; note that usec also contains ms --> divide by 1000 to get ms
-      String s_timestamp = String(tv.tv_sec);        // timestamp with resolution of 1 sec
 
-    this->postHttp(_vzUUID, s_timestamp, float(currentTime/1000.));
-    this->_TimeStamp = s_timestamp +"000";  
-    this->_value[vzTEST] = float(currentTime/1000.);
+    this->publishValue(vzSRC_TEST, tv.tv_sec, float(currentTime/1000.));
+    this->flushBatch();
+    this->_TimeStamp = String(tv.tv_sec) +"000";  
+    this->_testValue = float(currentTime/1000.);
   }
 }
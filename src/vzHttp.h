@@ -1,6 +1,26 @@
 #ifndef MY_HTTP_H
 #define MY_HTTP_H
 //
+// 2026-10-18 mh
+// - counters per channel in ChannelStats
+// - channels in VzChannelRegistry
+// - BatchControl and TuplePool
+// - VzTuple moved to vzQueue.h, so the queue builds without vzHttp
+// - tuples of waiting requests in one pool of VZ_TUPLE_POOL_SIZE instead of a full batch per request
+// - delivery callback: sources of a batch sent with 2xx or stored in the queue
+// - outcome statistics per channel (VzChannelStats), failing channels, JSON output
+// - replay of queued tuples gzip compressed, fallback to plain if rejected by the server
+// - channel registry (vzChannel) replaces enum UuidValueName; publishValue()
+// - UUIDs in binary form (16 bytes), send mask instead of string compare
+// - implements Publisher
+// - adaptive batching: batch size and flush interval follow latency and error rate of the server
+// - jittered, paced transfer: per device offset within publish window
+// - JSON body built in fixed buffer, no heap allocation per request; setUuid()
+// - server IP from DNS cache
+// - asynchronous transfer by AsyncHttp, completion callback
+// - store-and-forward queue for failed transfers
+// - persistent keep-alive connection, connection and latency counters
+// - batch transfer of several tuples and channels within one http request
 // 2023-02-14 mh
 // - adapt size of uuidValue structure
 // 2023-01-30 - 2023-02-02 mh
@@ -9,52 +29,140 @@
 // (C) Copyright M. Herbert, 2022-2023.
 // Licensed under the GNU General Public License v3.0
 
+#include <functional>
 #include "config.h"
+#include "asyncHttp.h"
+#include "publisher.h"
+#include "vzUuid.h"
+#include "vzChannel.h"
+#include "vzQueue.h"
+#include "batchControl.h"
+#include "tuplePool.h"
+#include "channelStats.h"
+#define VZ_HTTP_ERROR_BODY_OVERFLOW (-20)    // body did not fit into VZ_BODY_SIZE, request not sent
+
 #ifndef DEBUG_TRACE
     #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
 #endif
 
 
-#define N_UUID_VALUE 10          // adapt if enum is changed.
-enum UuidValueName
+struct VzRequest          // batch waiting for transfer
 {
-    vzTEMP_CH6,
-    vzINV_POWER,
-    vzINV_DC_U,
-    vzINV_DC_I,
-    vzINV_DC_POWER,
-    vzINV_ENERGY_LASTDAY,
-    vzINV_ENERGY_LASTMONTH,
-    vzINV_ENERGY_THISDAY,
-    vzINV_HEART_BEAT,
-    vzTEST
+  uint16_t first;         // tuples in _tuples[first] .. _tuples[first + n - 1]
+  uint16_t n;
+  bool     fromQueue;     // tuples read from VzQueue, committed after transfer
+  uint32_t queueSeg;      // segment and position in VzQueue the tuples were read from
+  uint16_t queuePos;
+  uint32_t due;           // ms, earliest time of transfer
+  bool     gzip;          // body sent compressed
 };
 
-#define sizeOfUUID 48   // length of UUID string
 struct VzHttpConfig
 {
   char vzServer[64] = VZ_SERVER;
   char vzMiddleware[64] = VZ_MIDDLEWARE;
-  char uuidValue[N_UUID_VALUE][sizeOfUUID] = {"0","1","2","3","4","5","6","7","8","9"};
+  VzChannelConfig channel[VZ_MAX_CHANNELS];     // channel registry
+  char publishWindow[4] = VZ_PUBLISH_WINDOW;    // s
+  char maxBatch[4] = VZ_MAX_BATCH;              // tuples
+  char maxFlushInterval[6] = VZ_MAX_FLUSH_INTERVAL;   // s
+  char gzipReplay[2] = VZ_GZIP_REPLAY;          // "1": replay of queued tuples gzip compressed
 };
 
-class VzHttp
+class VzHttp : public Publisher
 {
 public:
     VzHttp();
     void init(VzHttpConfig &config);
+    void setQueue(VzQueue* queue);
+    void doLoop() override;
     void setServerName(String serverName);
     void setMiddlewareName(String middlewareName);
+    void setChannel(uint8_t channel, const VzChannelConfig& config);
+    void setCompletionCallback(std::function<void(int httpResponseCode)> func);
+    void setDeliveryCallback(std::function<void(uint16_t sourceMask, bool saved)> func);
     void testHttp();
-    int postHttp(String vzUUID, String timeStamp, float value);
+    bool publishValue(VzSource source, uint32_t timeStamp, float value);
+    bool addTuple(uint8_t channel, uint32_t timeStamp, float value);
+    bool flushBatch(bool immediate = false);
+    void setPublishWindow(uint16_t windowSeconds);
+    uint32_t getPublishOffset();
+    void setBatchLimits(uint16_t maxBatch, uint32_t maxFlushInterval);
+    uint16_t getBatchTarget();
+    uint32_t getFlushInterval();
+    uint32_t getLatencyAvg();
+    uint16_t getErrorRate();
+    void setGzipReplay(bool enable);
+    bool isGzipRejected();
+    uint32_t getGzipInBytes();
+    uint32_t getGzipOutBytes();
+    uint32_t getLastReplayTime();
+    const VzChannelStats& getChannelStats(uint8_t channel);
+    uint16_t getSendMask();
+    uint16_t getFailingMask();
+    void printChannelStats(Print& out);
+    bool isIdle();
+    uint16_t getBatchCount();
+    uint32_t getRequestCount();
+    uint32_t getConnectCount();
+    uint32_t getReconnectCount();
+    uint32_t getLastLatency();
+    uint32_t getAvgLatency();
+    String getServerIP();
+    uint32_t getDnsLookupCount();
+    uint32_t getDnsFailCount();
+    uint32_t getDnsLookupTime();
+    uint32_t getBuildHeapDelta();
+
+    // Publisher
+    bool publish(const Snapshot& snapshot) override;
+    const char* getName() override;
+    uint32_t getBytesSent() override;
+    uint32_t getRoundTrips() override;
     String getTimeStamp();
-    float getValue(UuidValueName select);
+    float getTestValue();
 
 private:
     String _TimeStamp="0";          // ms
     String _serverName="";
     String _middlewareName="";
-    char* _uuid[N_UUID_VALUE];
-    float _value[N_UUID_VALUE];
+    String _vzPath="";
+    VzChannelRegistry _registry;    // source, UUID and send mask of the channels
+    ChannelStats _stats;            // outcome of the requests per channel
+    float _testValue = 0;
+    VzTuple _batch[VZ_BATCH_SIZE];  // tuples collected since last flushBatch()
+    uint16_t _nBatch = 0;
+    VzRequest _requests[VZ_REQUEST_QUEUE_SIZE];   // ring of batches waiting for transfer, first one is in progress
+    VzTuple _tuples[VZ_TUPLE_POOL_SIZE];          // tuples of the requests, contiguous per request, in ring order
+    TuplePool _pool;                              // spans of the requests in _tuples
+    uint8_t _reqFirst = 0;
+    uint8_t _reqCount = 0;
+    AsyncHttp _http;
+    std::function<void(int httpResponseCode)> _completionCallback = nullptr;
+    std::function<void(uint16_t sourceMask, bool saved)> _deliveryCallback = nullptr;
+    VzQueue* _queue = nullptr;      // store for tuples that could not be sent
+    bool _serverUp = false;         // last transfer was successful, queue may be drained
+    uint32_t _lastDrainTime = 0;    // ms
+    uint32_t _lastSendTime = 0;     // ms, start of last request
+    uint32_t _publishOffset = 0;    // ms, slot of this device after the aligned sample time
+    BatchControl _control;          // adaptive batching
+    uint32_t _lastFlushTime = 0;    // ms, last batch passed to transfer
+    char _body[VZ_BODY_SIZE];       // JSON body of the request in progress
+    uint8_t _gzBody[VZ_GZIP_SIZE];  // compressed body of a replay request
+    bool _gzipReplay = false;       // replay with Content-Encoding gzip
+    bool _gzipRejected = false;     // server did not accept a compressed body
+    uint32_t _gzipRejectTime = 0;   // ms
+    uint32_t _gzipInBytes = 0;      // sum of plain and compressed length of replay bodies sent compressed
+    uint32_t _gzipOutBytes = 0;
+    uint32_t _replayStartTime = 0;  // ms, first replay request after the queue was empty, 0: no replay
+    uint32_t _lastReplayTime = 0;   // ms, duration of the last complete replay of the queue
+    uint32_t _buildHeapDelta = 0;   // max heap used while building a request, expected to be 0
+    void buildUrl();
+    uint32_t delayToSlot(uint32_t sampleTime);
+    bool handOver(bool immediate);
+    void adapt(bool failed);
+    size_t buildBody(const VzTuple* tuples, uint16_t n);
+    bool store(const VzTuple* tuples, uint16_t n);
+    void complete(int httpResponseCode);
+    void delivered(const VzTuple* tuples, uint16_t n, bool saved);
 };
 #endif // MY_HTTP_H
\ No newline at end of file
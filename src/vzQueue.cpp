@@ -0,0 +1,264 @@
+// vzQueue.cpp
+//
+// durable store-and-forward queue for Volkszaehler tuples on LittleFS
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Tuples which could not be transferred to the Volkszaehler middleware (server or WiFi down) are stored in flash
+and sent later, when the server is reachable again.
+
+** Usage **
+vzQueue.begin();                      mount LittleFS and recover the queue state from the files
+vzQueue.push(tuples, n);              append n tuples
+n = vzQueue.read(tuples, nMax, seg, pos);   read up to nMax of the oldest tuples, they stay in the queue;
+                                      seg and pos tell where they were read from
+vzQueue.commit(seg, pos, n);          remove n tuples after successful transfer
+
+** Implementation **
+The queue is a sequence of append-only segment files VZ_QUEUE_DIR/<number>, each with up to VZ_QUEUE_SEGMENT_RECORDS
+fixed-size binary records (struct VzTuple, 12 bytes). New tuples are appended to the segment with the highest number,
+a full segment is never written again. A completely sent segment is deleted, so flash blocks rotate through the file
+system instead of rewriting the same file (wear leveling is done by LittleFS).
+The size is bounded by VZ_QUEUE_MAX_SEGMENTS; if the queue is full, the oldest segment is dropped.
+The read position within the oldest segment is stored in VZ_QUEUE_DIR/rd after each commit. After a power loss between
+transfer and commit, some tuples may be sent twice.
+If the oldest segment is dropped by push() while its tuples are in transfer, commit() finds that segment and position
+no longer at the head of the queue and does nothing, so no tuples of the next segment are skipped.
+  *** end description *** */
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "vzQueue.h"
+
+#define VZ_QUEUE_READ_POS_FILE VZ_QUEUE_DIR "/rd"
+
+VzQueue::VzQueue()
+{
+}
+
+bool VzQueue::begin()
+//
+// mount file system and recover queue state from existing segment files
+{
+  if(!LittleFS.begin())
+  {
+    DEBUG_TRACE(true,"vzQueue: LittleFS mount failed, queue disabled");
+    return false;
+  }
+
+  bool found = false;
+  size_t lastSize = 0;
+  Dir dir = LittleFS.openDir(VZ_QUEUE_DIR);
+  while (dir.next())
+  {
+    String name = dir.fileName();
+    if(name == "rd")
+    {
+      continue;
+    }
+    uint32_t seg = strtoul(name.c_str(), nullptr, 10);
+    if(!found || (seg < _firstSeg))
+    {
+      _firstSeg = seg;
+    }
+    if(!found || (seg >= _lastSeg))
+    {
+      _lastSeg = seg;
+      lastSize = dir.fileSize();
+    }
+    found = true;
+  }
+
+  if(found)
+  {
+    _lastCount = lastSize / sizeof(VzTuple);
+    if((lastSize % sizeof(VzTuple)) != 0)
+    {
+      // incomplete record after power loss: continue with a new segment
+      _lastSeg++;
+      _lastCount = 0;
+    }
+    File f = LittleFS.open(VZ_QUEUE_READ_POS_FILE, "r");
+    if(f)
+    {
+      uint32_t seg = 0;
+      uint16_t pos = 0;
+      if((f.read((uint8_t*)&seg, sizeof(seg)) == sizeof(seg)) && (f.read((uint8_t*)&pos, sizeof(pos)) == sizeof(pos))
+          && (seg == _firstSeg))
+      {
+        _readPos = pos;
+      }
+      f.close();
+    }
+  }
+  _ready = true;
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"vzQueue: segments %u..%u, %u records pending",_firstSeg,_lastSeg,count());
+  return true;
+}
+
+uint16_t VzQueue::push(const VzTuple* tuples, uint16_t n)
+//
+// append tuples, return number of stored tuples
+{
+  if(!_ready)
+  {
+    return 0;
+  }
+  char name[24];
+  uint16_t i = 0;
+  while (i < n)
+  {
+    if(_lastCount >= VZ_QUEUE_SEGMENT_RECORDS)
+    {
+      _lastSeg++;
+      _lastCount = 0;
+      if((_lastSeg - _firstSeg) >= VZ_QUEUE_MAX_SEGMENTS)
+      {
+        dropFirstSegment(VZ_QUEUE_SEGMENT_RECORDS - _readPos);    // queue full, the oldest data is lost
+      }
+    }
+    uint16_t chunk = n - i;
+    if(chunk > (VZ_QUEUE_SEGMENT_RECORDS - _lastCount))
+    {
+      chunk = VZ_QUEUE_SEGMENT_RECORDS - _lastCount;
+    }
+    segName(_lastSeg, name);
+    File f = LittleFS.open(name, "a");
+    if(!f)
+    {
+      break;
+    }
+    size_t written = f.write((const uint8_t*)&tuples[i], chunk * sizeof(VzTuple)) / sizeof(VzTuple);
+    f.close();
+    _lastCount += written;
+    i += written;
+    if(written < chunk)
+    {
+      break;              // file system full
+    }
+  }
+  DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"vzQueue: %u of %u records stored, %u pending",i,n,count());
+  return i;
+}
+
+uint16_t VzQueue::read(VzTuple* tuples, uint16_t nMax, uint32_t& seg, uint16_t& pos)
+//
+// read up to nMax of the oldest tuples (only from the oldest segment), they are removed by commit().
+// seg and pos return the segment and position the tuples were read from, to be passed to commit().
+{
+  if(!_ready)
+  {
+    return 0;
+  }
+  char name[24];
+  while (count() > 0)
+  {
+    uint16_t inFirst = (_firstSeg == _lastSeg) ? _lastCount : VZ_QUEUE_SEGMENT_RECORDS;
+    uint16_t n = inFirst - _readPos;
+    if(n > nMax)
+    {
+      n = nMax;
+    }
+    segName(_firstSeg, name);
+    File f = LittleFS.open(name, "r");
+    size_t nRead = 0;
+    if(f)
+    {
+      if(f.seek(_readPos * sizeof(VzTuple)))
+      {
+        nRead = f.read((uint8_t*)tuples, n * sizeof(VzTuple)) / sizeof(VzTuple);
+      }
+      f.close();
+    }
+    if((nRead > 0) || (_firstSeg == _lastSeg))
+    {
+      seg = _firstSeg;
+      pos = _readPos;
+      return nRead;
+    }
+    // missing or short segment file: the records were never stored, continue with next one
+    DEBUG_TRACE(true,"vzQueue: segment %u unreadable, %u records missing",_firstSeg,inFirst - _readPos);
+    dropFirstSegment(0);
+  }
+  return 0;
+}
+
+void VzQueue::commit(uint32_t seg, uint16_t pos, uint16_t n)
+//
+// remove n tuples returned by read() from segment seg, position pos.
+// nothing is removed if that segment was dropped by push() in the meantime.
+{
+  if(!_ready || (n == 0))
+  {
+    return;
+  }
+  if((seg != _firstSeg) || (pos != _readPos))
+  {
+    DEBUG_TRACE(VERBOSE_LEVEL_HTTP,"vzQueue: segment %u dropped during transfer, commit ignored",seg);
+    return;
+  }
+  char name[24];
+  _readPos += n;
+  uint16_t inFirst = (_firstSeg == _lastSeg) ? _lastCount : VZ_QUEUE_SEGMENT_RECORDS;
+  if(_readPos >= inFirst)
+  {
+    segName(_firstSeg, name);
+    LittleFS.remove(name);
+    if(_firstSeg == _lastSeg)
+    {
+      _lastSeg++;           // queue is empty, next push starts a new segment
+      _lastCount = 0;
+    }
+    _firstSeg++;
+    _readPos = 0;
+  }
+  saveReadPos();
+}
+
+uint32_t VzQueue::count()
+//
+// number of pending tuples
+{
+  return (_lastSeg - _firstSeg) * VZ_QUEUE_SEGMENT_RECORDS + _lastCount - _readPos;
+}
+
+uint32_t VzQueue::getDropCount()
+{
+  return _dropCount;
+}
+
+void VzQueue::segName(uint32_t seg, char* name)
+{
+  sprintf(name, "%s/%u", VZ_QUEUE_DIR, seg);
+}
+
+void VzQueue::dropFirstSegment(uint16_t lost)
+//
+// remove the oldest segment, lost: number of stored records not sent yet
+{
+  char name[24];
+  segName(_firstSeg, name);
+  LittleFS.remove(name);
+  _dropCount += lost;
+  _firstSeg++;
+  _readPos = 0;
+  saveReadPos();
+}
+
+void VzQueue::saveReadPos()
+{
+  File f = LittleFS.open(VZ_QUEUE_READ_POS_FILE, "w");
+  if(f)
+  {
+    f.write((const uint8_t*)&_firstSeg, sizeof(_firstSeg));
+    f.write((const uint8_t*)&_readPos, sizeof(_readPos));
+    f.close();
+  }
+}
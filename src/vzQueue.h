@@ -0,0 +1,46 @@
+#ifndef VZ_QUEUE_H
+#define VZ_QUEUE_H
+//
+// 2026-10-18 mh
+// - first version
+// - VzTuple defined here instead of vzHttp.h
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+#ifndef DEBUG_TRACE
+    #define DEBUG_TRACE(trace, format, ...) if(trace) {printf(format, ##__VA_ARGS__); fflush(stdout); Serial.println();}
+#endif
+
+struct VzTuple            // one sample of a channel, collected for a batch transfer; record format of VzQueue
+{
+  uint8_t  channel;       // index of channel registry
+  uint32_t timeStamp;     // UNIX epoch time in s
+  float    value;
+};
+
+class VzQueue
+{
+public:
+    VzQueue();
+    bool begin();
+    uint16_t push(const VzTuple* tuples, uint16_t n);
+    uint16_t read(VzTuple* tuples, uint16_t nMax, uint32_t& seg, uint16_t& pos);
+    void commit(uint32_t seg, uint16_t pos, uint16_t n);
+    uint32_t count();
+    uint32_t getDropCount();
+
+private:
+    bool _ready = false;
+    uint32_t _firstSeg = 0;         // number of oldest segment file
+    uint32_t _lastSeg = 0;          // number of segment file used for append
+    uint16_t _readPos = 0;          // records already sent from first segment
+    uint16_t _lastCount = 0;        // records in last segment
+    uint32_t _dropCount = 0;        // records dropped because queue was full
+    void segName(uint32_t seg, char* name);
+    void dropFirstSegment(uint16_t lost);
+    void saveReadPos();
+};
+#endif // VZ_QUEUE_H
@@ -0,0 +1,135 @@
+// vzUuid.cpp
+//
+// channel UUIDs of the Volkszaehler data base in binary form
+//
+// 2026-10-18 mh
+// - UuidParameter moved to vzUuidParameter.cpp, so the conversion builds without confWeb (native unit tests)
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+A channel UUID is kept as 16 bytes instead of a text buffer of 48 characters, in RAM as well as in the EEPROM
+configuration. The text form is only needed on the config page and in the http body.
+
+** Usage **
+uint8_t uuid[VZ_UUID_SIZE];
+if(uuidParse("ae53c580-1234-5678-90ab-cdef01234567", uuid))   false: malformed, uuid unchanged
+  ...
+if(uuidIsSet(uuid))                 false for VZ_UUID_NO_SEND
+  body.addUuid(uuid);               text form directly into the request buffer, see FmtBuf
+
+The config parameter of a UUID is UuidParameter, see vzUuidParameter.cpp.
+
+** Implementation **
+The nil UUID (all bytes 0) is the sentinel for VZ_UUID_NO_SEND; it is no valid channel of the data base.
+VZ_UUID_NO_SEND and an empty text are parsed to the sentinel, the sentinel is formatted as VZ_UUID_NO_SEND.
+Accepted text: 32 hex digits (upper or lower case) in groups 8-4-4-4-12, separated by '-'. It is formatted in lower case.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "vzUuid.h"
+
+static int8_t hexDigit(char c)
+{
+  if((c >= '0') && (c <= '9'))
+  {
+    return c - '0';
+  }
+  if((c >= 'a') && (c <= 'f'))
+  {
+    return c - 'a' + 10;
+  }
+  if((c >= 'A') && (c <= 'F'))
+  {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+static bool isDashPos(uint8_t i)
+{
+  return (i == 8) || (i == 13) || (i == 18) || (i == 23);
+}
+
+bool uuidParse(const char* text, uint8_t* uuid)
+//
+// convert text form into binary, VZ_UUID_NO_SEND or empty text into the sentinel.
+// return false for a malformed text, uuid is not changed then.
+{
+  uint8_t result[VZ_UUID_SIZE];
+  uint8_t i, n = 0;
+  if((text[0] == '\0') || !strcmp(text, VZ_UUID_NO_SEND))
+  {
+    memset(uuid, 0, VZ_UUID_SIZE);
+    return true;
+  }
+  if(strlen(text) != VZ_UUID_TEXT_LEN)
+  {
+    return false;
+  }
+  for (i=0;i<VZ_UUID_TEXT_LEN;i++)
+  {
+    if(isDashPos(i))
+    {
+      if(text[i] != '-')
+      {
+        return false;
+      }
+      continue;
+    }
+    int8_t high = hexDigit(text[i]);
+    int8_t low = hexDigit(text[i+1]);
+    if((high < 0) || (low < 0))
+    {
+      return false;
+    }
+    result[n++] = (high << 4) | low;
+    i++;
+  }
+  memcpy(uuid, result, VZ_UUID_SIZE);
+  return true;
+}
+
+size_t uuidFormat(const uint8_t* uuid, char* text)
+//
+// write text form and terminating 0 to text (min. VZ_UUID_TEXT_LEN + 1 bytes), return number of characters
+{
+  static const char hex[] = "0123456789abcdef";
+  if(!uuidIsSet(uuid))
+  {
+    strcpy(text, VZ_UUID_NO_SEND);
+    return strlen(VZ_UUID_NO_SEND);
+  }
+  uint8_t i, n = 0;
+  for (i=0;i<VZ_UUID_TEXT_LEN;i++)
+  {
+    if(isDashPos(i))
+    {
+      text[i] = '-';
+      continue;
+    }
+    text[i++] = hex[uuid[n] >> 4];
+    text[i] = hex[uuid[n] & 0x0F];
+    n++;
+  }
+  text[VZ_UUID_TEXT_LEN] = '\0';
+  return VZ_UUID_TEXT_LEN;
+}
+
+bool uuidIsSet(const uint8_t* uuid)
+//
+// false for the sentinel of VZ_UUID_NO_SEND
+{
+  uint8_t i;
+  for (i=0;i<VZ_UUID_SIZE;i++)
+  {
+    if(uuid[i] != 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
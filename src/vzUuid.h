@@ -0,0 +1,21 @@
+#ifndef VZ_UUID_H
+#define VZ_UUID_H
+//
+// 2026-10-18 mh
+// - UuidParameter moved to vzUuidParameter.h
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include "config.h"
+
+#define VZ_UUID_SIZE      16      // bytes of binary UUID
+#define VZ_UUID_TEXT_LEN  36      // characters of text form 8-4-4-4-12
+
+bool uuidParse(const char* text, uint8_t* uuid);
+size_t uuidFormat(const uint8_t* uuid, char* text);
+bool uuidIsSet(const uint8_t* uuid);
+
+#endif // VZ_UUID_H
@@ -0,0 +1,90 @@
+// vzUuidParameter.cpp
+//
+// config parameter of a channel UUID in binary form
+//
+// 2026-10-18 mh
+// - first version, moved from vzUuid.cpp
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+/* *** Description ***
+Edits a binary UUID (see vzUuid.cpp) as text on the config page.
+
+** Usage **
+UuidParameter confParam("UUID InvPower", "UUID-InvPower", config.channel[1].uuid, VZ_UUID_INV_POWER);
+confParam.validate(webRequestWrapper)   call from the form validator, sets the error message of the field
+
+** Implementation **
+UuidParameter uses the binary UUID as value buffer of TextParameter, so confWeb stores only 16 bytes in the EEPROM.
+The text is parsed by uuidParse() when the form is saved and formatted by uuidFormat() when the page is rendered.
+  *** end description *** */
+
+#include <Arduino.h>
+#include "vzUuidParameter.h"
+
+UuidParameter::UuidParameter(
+  const char* label, const char* id, uint8_t* uuid,
+  const char* defaultValue,
+  const char* placeholder,
+  const char* customHtml)
+  : TextParameter(label, id, (char*)uuid, VZ_UUID_SIZE, defaultValue, placeholder, customHtml)
+{
+}
+
+void UuidParameter::applyDefaultValue()
+{
+  if((defaultValue == nullptr) || !uuidParse(defaultValue, (uint8_t*)valueBuffer))
+  {
+    memset(valueBuffer, 0, VZ_UUID_SIZE);    // malformed default in config.h: not sent
+  }
+}
+
+bool UuidParameter::validate(WebRequestWrapper* webRequestWrapper)
+//
+// check the posted text, set error message of the field if malformed
+{
+  uint8_t uuid[VZ_UUID_SIZE];
+  if(!webRequestWrapper->hasArg(getId()))
+  {
+    return true;
+  }
+  String text = webRequestWrapper->arg(getId());
+  text.trim();
+  if(uuidParse(text.c_str(), uuid))
+  {
+    return true;
+  }
+  errorMessage = "UUID needs 32 hex digits 8-4-4-4-12 or " VZ_UUID_NO_SEND;
+  return false;
+}
+
+void UuidParameter::renderHtml(bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content)
+{
+  if(hasValueFromPost)
+  {
+    TextParameter::renderHtml("text", true, valueFromPost, content);
+    return;
+  }
+  char text[VZ_UUID_TEXT_LEN + 1];
+  uuidFormat((const uint8_t*)valueBuffer, text);
+  TextParameter::renderHtml("text", true, String(text), content);
+}
+
+void UuidParameter::update(String newValue)
+{
+  newValue.trim();
+  uuidParse(newValue.c_str(), (uint8_t*)valueBuffer);    // malformed text is rejected by validate()
+}
+
+void UuidParameter::debugTo(Stream* out)
+{
+  char text[VZ_UUID_TEXT_LEN + 1];
+  uuidFormat((const uint8_t*)valueBuffer, text);
+  out->print("'");
+  out->print(getId());
+  out->print("' with value: '");
+  out->print(text);
+  out->println("'");
+}
@@ -0,0 +1,33 @@
+#ifndef VZ_UUID_PARAMETER_H
+#define VZ_UUID_PARAMETER_H
+//
+// 2026-10-18 mh
+// - first version, moved from vzUuid.h
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <confWebParameter.h>
+#include "vzUuid.h"
+
+// config parameter with a binary UUID as value buffer, edited as text on the config page
+class UuidParameter : public TextParameter
+{
+public:
+  UuidParameter(
+    const char* label, const char* id, uint8_t* uuid,
+    const char* defaultValue = nullptr,
+    const char* placeholder = nullptr,
+    const char* customHtml = nullptr);
+  void applyDefaultValue() override;
+  bool validate(WebRequestWrapper* webRequestWrapper);
+
+protected:
+  // Overrides
+  virtual void renderHtml(
+    bool dataArrived, bool hasValueFromPost, const String& valueFromPost, String& content) override;
+  virtual void update(String newValue) override;
+  virtual void debugTo(Stream* out) override;
+};
+#endif // VZ_UUID_PARAMETER_H
@@ -0,0 +1,78 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+//
+// 2026-10-18 mh
+// - first version
+// - String with the members used by the tested modules
+//
+// host replacement of the Arduino core for the unit tests of [env:native] (pio test -e native);
+// only what the tested modules use. millis() is a counter set by the tests.
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+#define PROGMEM
+#define PGM_P const char*
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+inline uint32_t nativeMillis = 0;     // ms, advanced by the tests
+inline uint32_t millis() { return nativeMillis; }
+inline uint32_t micros() { return nativeMillis * 1000; }
+
+class String
+{
+public:
+    String(const char* text = "") : _text(text) {}
+    String(const std::string& text) : _text(text) {}
+    const char* c_str() const { return _text.c_str(); }
+    unsigned int length() const { return _text.length(); }
+    bool operator==(const char* text) const { return _text == text; }
+    bool operator!=(const char* text) const { return _text != text; }
+    String& operator+=(const char* text) { _text += text; return *this; }
+    bool reserve(unsigned int size) { _text.reserve(size); return true; }
+    bool concat(const char* text, unsigned int length) { _text.append(text, length); return true; }
+
+private:
+    std::string _text;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size)
+    {
+      size_t n = 0;
+      while (size--)
+      {
+        n += write(*buffer++);
+      }
+      return n;
+    }
+    size_t write(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+};
+
+class NativeSerial
+{
+public:
+    void println() { printf("\n"); }
+};
+inline NativeSerial Serial;
+
+#endif // NATIVE_ARDUINO_H
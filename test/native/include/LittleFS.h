@@ -0,0 +1,128 @@
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+//
+// 2026-10-18 mh
+// - first version
+// - files in RAM, directory listing, size limit to test a full file system
+//
+// host replacement of LittleFS for the unit tests of [env:native]: files are kept in a map in RAM, they survive
+// as long as the test program runs, so a restart is tested by a new object reading the same files
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::map<std::string, std::vector<uint8_t>> NativeFiles;
+
+class File
+{
+public:
+    File(std::vector<uint8_t>* data = nullptr, size_t pos = 0, size_t* free = nullptr) :
+        _data(data), _pos(pos), _free(free) {}
+    operator bool() const { return _data != nullptr; }
+    size_t read(uint8_t* buffer, size_t size)
+    {
+      size = std::min(size, _data->size() - std::min(_pos, _data->size()));
+      memcpy(buffer, _data->data() + _pos, size);
+      _pos += size;
+      return size;
+    }
+    size_t write(const uint8_t* buffer, size_t size)
+    {
+      size = std::min(size, *_free);
+      *_free -= size;
+      _data->insert(_data->end(), buffer, buffer + size);
+      _pos = _data->size();
+      return size;
+    }
+    bool seek(uint32_t pos)
+    {
+      _pos = pos;
+      return pos <= _data->size();
+    }
+    size_t size() { return _data->size(); }
+    void close() {}
+
+private:
+    std::vector<uint8_t>* _data;
+    size_t _pos;
+    size_t* _free;
+};
+
+class Dir
+{
+public:
+    Dir(NativeFiles* files = nullptr, const std::string& path = "") : _files(files), _prefix(path + "/") {}
+    bool next()
+    {
+      _it = _started ? std::next(_it) : _files->lower_bound(_prefix);
+      _started = true;
+      while ((_it != _files->end()) && (_it->first.compare(0, _prefix.size(), _prefix) == 0))
+      {
+        if(_it->first.find('/', _prefix.size()) == std::string::npos)
+        {
+          return true;
+        }
+        _it++;
+      }
+      return false;
+    }
+    String fileName() { return String(_it->first.substr(_prefix.size())); }
+    size_t fileSize() { return _it->second.size(); }
+
+private:
+    NativeFiles* _files;
+    std::string _prefix;
+    NativeFiles::iterator _it;
+    bool _started = false;
+};
+
+class NativeFS
+{
+public:
+    bool begin() { return true; }
+    File open(const char* path, const char* mode)
+    {
+      NativeFiles::iterator it = files.find(path);
+      if(mode[0] == 'r')
+      {
+        return (it != files.end()) ? File(&it->second, 0, &free) : File();
+      }
+      std::vector<uint8_t>& data = files[path];
+      if(mode[0] == 'w')
+      {
+        free += data.size();
+        data.clear();
+      }
+      return File(&data, data.size(), &free);
+    }
+    bool exists(const char* path) { return files.count(path) > 0; }
+    bool remove(const char* path)
+    {
+      NativeFiles::iterator it = files.find(path);
+      if(it == files.end())
+      {
+        return false;
+      }
+      free += it->second.size();
+      files.erase(it);
+      return true;
+    }
+    Dir openDir(const char* path) { return Dir(&files, path); }
+
+    // for the tests
+    void format(size_t size = 1000000)
+    {
+      files.clear();
+      free = size;
+    }
+    NativeFiles files;
+    size_t free = 1000000;        // bytes left, a write beyond is cut like on a full flash
+};
+inline NativeFS LittleFS;
+
+#endif // NATIVE_LITTLEFS_H
@@ -0,0 +1,143 @@
+// test_batchcontrol.cpp
+//
+// unit tests of batchControl.cpp: scripted latency and error sequences, widening, shrinking and bounds
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "batchControl.h"
+
+#define PERIOD  (INVERTER_READ_INTERVAL_FREQUENT * 1000UL)
+#define MAX_FLUSH 600000UL
+
+static void run(BatchControl& control, uint16_t n, uint32_t latency, bool failed)
+{
+  uint16_t i;
+  for (i=0;i<n;i++)
+  {
+    control.update(latency, failed);
+  }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_fast_server()
+{
+  BatchControl control;
+  control.setLimits(VZ_BATCH_SIZE, MAX_FLUSH);
+  run(control, 50, 100, false);
+  TEST_ASSERT_EQUAL(VZ_BATCH_MIN, control.getBatchTarget());
+  TEST_ASSERT_EQUAL_UINT32(0, control.getFlushInterval());
+  TEST_ASSERT_EQUAL_UINT32(100, control.getLatencyAvg());
+  TEST_ASSERT_EQUAL(0, control.getErrorRate());
+}
+
+static void test_slow_server_widens()
+{
+  BatchControl control;
+  control.setLimits(VZ_BATCH_SIZE, MAX_FLUSH);
+  control.update(3000, false);                      // first request sets the average
+  TEST_ASSERT_EQUAL(2 * VZ_BATCH_MIN, control.getBatchTarget());
+  TEST_ASSERT_EQUAL_UINT32(PERIOD, control.getFlushInterval());
+  control.update(3000, false);
+  TEST_ASSERT_EQUAL(4 * VZ_BATCH_MIN, control.getBatchTarget());
+  TEST_ASSERT_EQUAL_UINT32(2 * PERIOD, control.getFlushInterval());
+
+  run(control, 20, 3000, false);                    // bounded by the limits
+  TEST_ASSERT_EQUAL(VZ_BATCH_SIZE, control.getBatchTarget());
+  TEST_ASSERT_EQUAL_UINT32(MAX_FLUSH, control.getFlushInterval());
+}
+
+static void test_recovery_shrinks()
+{
+  BatchControl control;
+  control.setLimits(VZ_BATCH_SIZE, MAX_FLUSH);
+  run(control, 10, 5000, false);
+  uint16_t target = control.getBatchTarget();
+  uint32_t interval = control.getFlushInterval();
+  uint16_t steps = 0;
+  while ((control.getFlushInterval() > 0) || (control.getBatchTarget() > VZ_BATCH_MIN))
+  {
+    control.update(100, false);
+    TEST_ASSERT_LESS_OR_EQUAL(target, control.getBatchTarget());      // never widened while recovering
+    TEST_ASSERT_LESS_OR_EQUAL(interval, control.getFlushInterval());
+    target = control.getBatchTarget();
+    interval = control.getFlushInterval();
+    steps++;
+    TEST_ASSERT_LESS_THAN(100, steps);
+  }
+  TEST_ASSERT_GREATER_THAN(5, steps);               // moving average: not at the first fast answer
+  TEST_ASSERT_LESS_THAN(VZ_FAST_LATENCY, control.getLatencyAvg());
+}
+
+static void test_errors_widen()
+{
+  BatchControl control;
+  control.setLimits(VZ_BATCH_SIZE, MAX_FLUSH);
+  run(control, 5, 100, false);
+  control.update(100, true);                        // one error: 125 per mille, below VZ_SLOW_ERROR_RATE
+  TEST_ASSERT_EQUAL(125, control.getErrorRate());
+  TEST_ASSERT_EQUAL(VZ_BATCH_MIN, control.getBatchTarget());
+  control.update(100, true);
+  control.update(100, true);                        // 330 per mille
+  TEST_ASSERT_GREATER_THAN(VZ_SLOW_ERROR_RATE, control.getErrorRate());
+  TEST_ASSERT_GREATER_THAN(VZ_BATCH_MIN, control.getBatchTarget());
+  TEST_ASSERT_GREATER_THAN(0, control.getFlushInterval());
+}
+
+static void test_hysteresis()
+{
+  // between the fast and slow thresholds the values stay where they are
+  BatchControl control;
+  control.setLimits(VZ_BATCH_SIZE, MAX_FLUSH);
+  run(control, 2, 3000, false);
+  run(control, 12, 1000, false);
+  uint16_t target = control.getBatchTarget();
+  uint32_t interval = control.getFlushInterval();
+  run(control, 50, 1000, false);
+  TEST_ASSERT_EQUAL(target, control.getBatchTarget());
+  TEST_ASSERT_EQUAL_UINT32(interval, control.getFlushInterval());
+}
+
+static void test_limits()
+{
+  BatchControl control;
+  control.setLimits(4, 90000);                      // max batch below VZ_BATCH_MIN
+  TEST_ASSERT_EQUAL(4, control.getBatchTarget());
+  run(control, 10, 5000, true);
+  TEST_ASSERT_EQUAL(4, control.getBatchTarget());
+  TEST_ASSERT_EQUAL_UINT32(90000, control.getFlushInterval());
+  run(control, 100, 100, false);
+  TEST_ASSERT_EQUAL(4, control.getBatchTarget());
+  TEST_ASSERT_EQUAL_UINT32(0, control.getFlushInterval());
+
+  control.setLimits(0, 0);
+  TEST_ASSERT_EQUAL(1, control.getMaxBatch());
+  run(control, 10, 5000, true);
+  TEST_ASSERT_EQUAL_UINT32(0, control.getFlushInterval());        // no hold time configured
+  control.setLimits(1000, MAX_FLUSH);
+  TEST_ASSERT_EQUAL(VZ_BATCH_SIZE, control.getMaxBatch());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_fast_server);
+  RUN_TEST(test_slow_server_widens);
+  RUN_TEST(test_recovery_shrinks);
+  RUN_TEST(test_errors_widen);
+  RUN_TEST(test_hysteresis);
+  RUN_TEST(test_limits);
+  return UNITY_END();
+}
@@ -0,0 +1,98 @@
+// test_channelstats.cpp
+//
+// unit tests of channelStats.cpp: outcome classes, one count per channel of a request, latency, last success,
+// failing channels, reset
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "channelStats.h"
+
+// request with three tuples of channel 1 and one of channel 4
+static const VzTuple BATCH[4] = {{1, 1000, 1.0f}, {4, 1000, 2.0f}, {1, 1060, 3.0f}, {1, 1120, 4.0f}};
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_outcome_classes()
+{
+  ChannelStats stats;
+  const int codes[] = {200, 204, 400, 404, 500, 503, -1, -4, 302};
+  uint8_t i;
+  for (i=0;i<sizeof(codes)/sizeof(codes[0]);i++)
+  {
+    stats.count(BATCH, 1, codes[i], 100, 5000 + i);
+  }
+  const VzChannelStats& channel = stats.get(1);
+  TEST_ASSERT_EQUAL(9, channel.attempts);
+  TEST_ASSERT_EQUAL(2, channel.ok);
+  TEST_ASSERT_EQUAL(2, channel.clientError);
+  TEST_ASSERT_EQUAL(2, channel.serverError);
+  TEST_ASSERT_EQUAL(2, channel.transportError);     // 3xx is only an attempt
+  TEST_ASSERT_EQUAL(302, channel.lastCode);
+  TEST_ASSERT_EQUAL(5001, channel.lastSuccess);     // time of the 204
+}
+
+static void test_once_per_channel()
+{
+  ChannelStats stats;
+  stats.count(BATCH, 4, 200, 250, 7000);
+  TEST_ASSERT_EQUAL(1, stats.get(1).attempts);
+  TEST_ASSERT_EQUAL(1, stats.get(1).ok);
+  TEST_ASSERT_EQUAL(1, stats.get(4).attempts);
+  TEST_ASSERT_EQUAL(250, stats.get(4).lastLatency);
+  TEST_ASSERT_EQUAL(7000, stats.get(4).lastSuccess);
+  TEST_ASSERT_EQUAL(0, stats.get(0).attempts);
+  TEST_ASSERT_EQUAL(0, stats.get(2).lastCode);
+
+  // latency beyond 16 bit is limited
+  stats.count(BATCH, 2, 200, 100000, 7001);
+  TEST_ASSERT_EQUAL(UINT16_MAX, stats.get(1).lastLatency);
+  // tuple of an invalid channel is ignored
+  const VzTuple invalid = {VZ_MAX_CHANNELS, 1000, 0};
+  stats.count(&invalid, 1, 500, 10, 7002);
+  TEST_ASSERT_EQUAL(2, stats.get(1).attempts);
+  TEST_ASSERT_EQUAL(0, stats.get(0).serverError);
+}
+
+static void test_failing_mask()
+{
+  ChannelStats stats;
+  uint16_t sendMask = (1 << 1) | (1 << 4) | (1 << 5);
+  TEST_ASSERT_EQUAL_HEX16(0, stats.getFailingMask(sendMask));    // no request yet
+
+  stats.count(BATCH, 4, 400, 10, 0);                              // channels 1 and 4 rejected
+  TEST_ASSERT_EQUAL_HEX16((1 << 1) | (1 << 4), stats.getFailingMask(sendMask));
+  TEST_ASSERT_EQUAL_HEX16(1 << 4, stats.getFailingMask(1 << 4)); // channel 1 not sent anymore
+
+  stats.count(BATCH, 1, 200, 10, 0);                              // channel 1 ok again
+  TEST_ASSERT_EQUAL_HEX16(1 << 4, stats.getFailingMask(sendMask));
+  stats.count(&BATCH[1], 1, -1, 10, 0);                           // transport error
+  TEST_ASSERT_EQUAL_HEX16(1 << 4, stats.getFailingMask(sendMask));
+
+  stats.reset(4);
+  TEST_ASSERT_EQUAL_HEX16(0, stats.getFailingMask(sendMask));
+  TEST_ASSERT_EQUAL(0, stats.get(4).attempts);
+  TEST_ASSERT_EQUAL(2, stats.get(1).attempts);
+  stats.reset(VZ_MAX_CHANNELS);                                   // out of range, ignored
+  TEST_ASSERT_EQUAL(2, stats.get(1).attempts);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_outcome_classes);
+  RUN_TEST(test_once_per_channel);
+  RUN_TEST(test_failing_mask);
+  return UNITY_END();
+}
@@ -0,0 +1,140 @@
+// test_configchunk.cpp
+//
+// unit tests of confWebChunk.cpp: pieces copied into chunks of any size, empty pieces, pieces longer than a chunk,
+// rendering only after the current piece is sent, end of the page
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include <string>
+#include "confWebChunk.h"
+
+// pieces of a page as renderConfigStep() delivers them: fragments, empty steps (group start without legend,
+// hidden parameter), one piece longer than most chunks
+static const char* PIECES[] = {
+  "<!DOCTYPE html><html><head><title>Config ESP</title>\n",
+  "",
+  "<style>.de{background-color:#ffaaaa;}</style>\n",
+  "<form method='post'>",
+  "",
+  "",
+  "<div><label for='vzServer'>Server</label><input type='text' id='vzServer' name='vzServer' value='vz.local'/></div>\n",
+  "x",
+  "</form></body></html>\n"
+};
+#define PIECE_COUNT (sizeof(PIECES) / sizeof(PIECES[0]))
+
+struct Page
+{
+  size_t next = 0;          // next piece to render
+  size_t calls = 0;         // calls of the renderer
+  String piece;
+  size_t sent = 0;
+};
+
+static PieceRenderer renderer(Page& page)
+{
+  return [&page](String& piece) -> bool
+  {
+    page.calls++;
+    if (page.next >= PIECE_COUNT)
+    {
+      return false;
+    }
+    TEST_ASSERT_EQUAL(0, piece.length());
+    piece += PIECES[page.next++];
+    return true;
+  };
+}
+
+static std::string whole()
+{
+  std::string result;
+  size_t i;
+  for (i=0;i<PIECE_COUNT;i++)
+  {
+    result += PIECES[i];
+  }
+  return result;
+}
+
+// page in chunks of maxLen, as the web server asks for them
+static std::string fillAll(Page& page, size_t maxLen)
+{
+  std::string result;
+  uint8_t buffer[256];
+  size_t n;
+  while ((n = fillChunkFromPieces(buffer, maxLen, page.piece, page.sent, renderer(page))) > 0)
+  {
+    TEST_ASSERT_TRUE(n <= maxLen);
+    result.append((const char*)buffer, n);
+    if (page.next < PIECE_COUNT)
+    {
+      TEST_ASSERT_EQUAL(maxLen, n);         // only the last chunk is short
+    }
+  }
+  return result;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_any_chunk_size()
+{
+  std::string expected = whole();
+  size_t maxLen;
+  for (maxLen=1;maxLen<=256;maxLen++)
+  {
+    Page page;
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), fillAll(page, maxLen).c_str());
+    // each piece rendered once, the end once more if the last chunk was full
+    TEST_ASSERT_TRUE(page.calls <= PIECE_COUNT + 2);
+  }
+}
+
+static void test_render_after_sent()
+{
+  // a piece longer than the chunk is sent in parts before the next one is rendered
+  Page page;
+  uint8_t buffer[16];
+  TEST_ASSERT_EQUAL(16, fillChunkFromPieces(buffer, sizeof(buffer), page.piece, page.sent, renderer(page)));
+  TEST_ASSERT_EQUAL(1, page.calls);
+  TEST_ASSERT_EQUAL(16, page.sent);
+  TEST_ASSERT_EQUAL(16, fillChunkFromPieces(buffer, sizeof(buffer), page.piece, page.sent, renderer(page)));
+  TEST_ASSERT_EQUAL(1, page.calls);
+  TEST_ASSERT_EQUAL(0, memcmp(buffer, PIECES[0] + 16, 16));
+}
+
+static void test_end()
+{
+  Page page;
+  uint8_t buffer[512];
+  size_t n = fillChunkFromPieces(buffer, sizeof(buffer), page.piece, page.sent, renderer(page));
+  TEST_ASSERT_EQUAL(whole().length(), n);
+  TEST_ASSERT_EQUAL(0, fillChunkFromPieces(buffer, sizeof(buffer), page.piece, page.sent, renderer(page)));
+  TEST_ASSERT_EQUAL(0, fillChunkFromPieces(buffer, sizeof(buffer), page.piece, page.sent, renderer(page)));
+
+  // empty page
+  Page empty;
+  empty.next = PIECE_COUNT;
+  TEST_ASSERT_EQUAL(0, fillChunkFromPieces(buffer, sizeof(buffer), empty.piece, empty.sent, renderer(empty)));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_any_chunk_size);
+  RUN_TEST(test_render_after_sent);
+  RUN_TEST(test_end);
+  return UNITY_END();
+}
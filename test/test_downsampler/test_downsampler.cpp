@@ -0,0 +1,112 @@
+// test_downsampler.cpp
+//
+// unit tests of downsampler.cpp: bucket index, rolling window and aggregates
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "downsampler.h"
+
+#define DAY 1700006400UL        // midnight UTC, multiple of 1800
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_bucket_index()
+{
+  Downsampler today(48, 1800);
+  today.reset(DAY + 100);                 // rounded down to the bucket width
+  TEST_ASSERT_EQUAL_UINT32(DAY, today.getStart());
+  TEST_ASSERT_EQUAL(0, today.add(DAY, 1));
+  TEST_ASSERT_EQUAL(0, today.add(DAY + 1799, 1));
+  TEST_ASSERT_EQUAL(1, today.add(DAY + 1800, 1));
+  TEST_ASSERT_EQUAL(47, today.add(DAY + 86399, 1));
+  TEST_ASSERT_EQUAL(-1, today.add(DAY - 1, 1));     // before the window
+  TEST_ASSERT_EQUAL_UINT32(DAY + 3600, today.getBucketStart(2));
+  TEST_ASSERT_EQUAL_UINT32(DAY, today.getStart());
+}
+
+static void test_aggregates()
+{
+  Downsampler today(48, 1800);
+  today.reset(DAY);
+  today.add(DAY + 10, 100);
+  today.add(DAY + 20, -20);
+  today.add(DAY + 30, 250);
+  today.add(DAY + 1800 * 3, 7);
+  const DownsampleBucket& bucket = today.getBucket(0);
+  TEST_ASSERT_EQUAL(3, bucket.count);
+  TEST_ASSERT_EQUAL_FLOAT(-20, bucket.min);
+  TEST_ASSERT_EQUAL_FLOAT(250, bucket.max);
+  TEST_ASSERT_EQUAL_FLOAT(110, today.getAvg(0));
+
+  float avg[48];
+  float maxValues[48];
+  today.getAvgValues(avg);
+  today.getMaxValues(maxValues);
+  TEST_ASSERT_EQUAL_FLOAT(110, avg[0]);
+  TEST_ASSERT_EQUAL_FLOAT(0, avg[1]);                 // empty bucket
+  TEST_ASSERT_EQUAL_FLOAT(7, avg[3]);
+  TEST_ASSERT_EQUAL_FLOAT(250, maxValues[0]);
+  TEST_ASSERT_EQUAL_FLOAT(0, maxValues[2]);
+  TEST_ASSERT_EQUAL_FLOAT(7, maxValues[3]);
+}
+
+static void test_window_shift()
+{
+  Downsampler month(30, 86400);
+  month.reset(DAY);
+  uint16_t i;
+  for (i=0;i<30;i++)
+  {
+    month.add(DAY + i * 86400UL, i);
+  }
+  // two days beyond the window: shifted by 2, newest sample in the last bucket
+  TEST_ASSERT_EQUAL(29, month.add(DAY + 31 * 86400UL, 31));
+  TEST_ASSERT_EQUAL_UINT32(DAY + 2 * 86400UL, month.getStart());
+  TEST_ASSERT_EQUAL_FLOAT(2, month.getAvg(0));
+  TEST_ASSERT_EQUAL_FLOAT(29, month.getAvg(27));
+  TEST_ASSERT_EQUAL(0, month.getBucket(28).count);    // cleared
+  TEST_ASSERT_EQUAL_FLOAT(31, month.getAvg(29));
+  TEST_ASSERT_EQUAL(-1, month.add(DAY + 86400UL, 1));
+
+  // further than the window: all buckets cleared
+  TEST_ASSERT_EQUAL(29, month.add(DAY + 100 * 86400UL, 100));
+  TEST_ASSERT_EQUAL_UINT32(DAY + 71 * 86400UL, month.getStart());
+  for (i=0;i<29;i++)
+  {
+    TEST_ASSERT_EQUAL(0, month.getBucket(i).count);
+  }
+  TEST_ASSERT_EQUAL_FLOAT(100, month.getAvg(29));
+}
+
+static void test_limits()
+{
+  Downsampler large(1000, 0);             // bucket count limited, width 0 used as 1
+  TEST_ASSERT_EQUAL(DOWNSAMPLE_MAX_BUCKETS, large.getBuckets());
+  large.reset(DAY);
+  TEST_ASSERT_EQUAL(5, large.add(DAY + 5, 1));
+  Downsampler none(0, 60);
+  TEST_ASSERT_EQUAL(1, none.getBuckets());
+  TEST_ASSERT_EQUAL_FLOAT(0, large.getAvg(DOWNSAMPLE_MAX_BUCKETS));   // out of range: bucket 0, empty
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_bucket_index);
+  RUN_TEST(test_aggregates);
+  RUN_TEST(test_window_shift);
+  RUN_TEST(test_limits);
+  return UNITY_END();
+}
@@ -0,0 +1,72 @@
+// test_etag.cpp
+//
+// unit tests of etag.cpp: FNV-1a hash, separator of values, format, If-None-Match with lists, weak tags and *
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "etag.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_hash()
+{
+  // FNV-1a of "a" is 0xe40c292c, then the separator 0xFF
+  uint32_t expected = (uint32_t)((0xe40c292cUL ^ 0xFF) * 16777619UL);
+  TEST_ASSERT_EQUAL_HEX32(expected, etagHash(2166136261UL, "a"));
+  // values are separated
+  uint32_t seed = etagSeed();
+  TEST_ASSERT_NOT_EQUAL(etagHash(etagHash(seed, "ab"), "c"), etagHash(etagHash(seed, "a"), "bc"));
+  TEST_ASSERT_NOT_EQUAL(etagHash(seed, ""), seed);
+  TEST_ASSERT_EQUAL_HEX32(etagHash(seed, "192.168.1.2"), etagHash(seed, "192.168.1.2"));
+}
+
+static void test_format()
+{
+  char etag[ETAG_SIZE];
+  etagFormat(0x0123abcd, etag);
+  TEST_ASSERT_EQUAL_STRING("\"0123abcd\"", etag);
+  etagFormat(0xffffffff, etag);
+  TEST_ASSERT_EQUAL_STRING("\"ffffffff\"", etag);
+  etagFormat(0, etag);
+  TEST_ASSERT_EQUAL_STRING("\"00000000\"", etag);
+}
+
+static void test_match()
+{
+  const char* etag = "\"0123abcd\"";
+  TEST_ASSERT_TRUE(etagMatch("\"0123abcd\"", etag));
+  TEST_ASSERT_TRUE(etagMatch("W/\"0123abcd\"", etag));
+  TEST_ASSERT_TRUE(etagMatch("*", etag));
+  TEST_ASSERT_TRUE(etagMatch(" * ", etag));
+  TEST_ASSERT_TRUE(etagMatch("\"11111111\", \"0123abcd\"", etag));
+  TEST_ASSERT_TRUE(etagMatch("\"11111111\",W/\"0123abcd\" ,\"22222222\"", etag));
+
+  TEST_ASSERT_FALSE(etagMatch("", etag));
+  TEST_ASSERT_FALSE(etagMatch("\"11111111\"", etag));
+  TEST_ASSERT_FALSE(etagMatch("\"0123abc\"", etag));
+  TEST_ASSERT_FALSE(etagMatch("\"0123abcdef\"", etag));       // etag is part of it, but not the same
+  TEST_ASSERT_FALSE(etagMatch("x\"0123abcd\"", etag));
+  TEST_ASSERT_FALSE(etagMatch("\"*\"", etag));
+  TEST_ASSERT_FALSE(etagMatch(",,", etag));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_hash);
+  RUN_TEST(test_format);
+  RUN_TEST(test_match);
+  return UNITY_END();
+}
@@ -0,0 +1,126 @@
+// test_fmtbuf.cpp
+//
+// unit tests of fmtBuf.cpp: formatting into a fixed buffer
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "fmtBuf.h"
+#include "vzUuid.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_integers()
+{
+  char text[64];
+  FmtBuf buf(text, sizeof(text));
+  buf.addUint(0).add(',').addUint(4294967295UL).add(',').addInt(-1).add(',').addInt(INT32_MIN).add(',').addInt(42);
+  TEST_ASSERT_EQUAL_STRING("0,4294967295,-1,-2147483648,42", buf.c_str());
+  TEST_ASSERT_EQUAL(strlen(text), buf.length());
+  TEST_ASSERT_FALSE(buf.overflow());
+}
+
+static void test_fixed()
+{
+  char text[32];
+  FmtBuf buf(text, sizeof(text));
+  buf.addFixed(22.5, 2);
+  TEST_ASSERT_EQUAL_STRING("22.50", buf.c_str());
+  buf.clear();
+  buf.addFixed(1234.5678, 3);
+  TEST_ASSERT_EQUAL_STRING("1234.568", buf.c_str());
+  buf.clear();
+  buf.addFixed(0.125, 2);         // rounded half up
+  TEST_ASSERT_EQUAL_STRING("0.13", buf.c_str());
+  buf.clear();
+  buf.addFixed(-1.25, 1);
+  TEST_ASSERT_EQUAL_STRING("-1.3", buf.c_str());
+  buf.clear();
+  buf.addFixed(-0.004, 2);        // rounds to 0, no sign
+  TEST_ASSERT_EQUAL_STRING("0.00", buf.c_str());
+  buf.clear();
+  buf.addFixed(3.6, 0);
+  TEST_ASSERT_EQUAL_STRING("4", buf.c_str());
+  buf.clear();
+  buf.addFixed(0.5, 9);           // at most 6 decimals
+  TEST_ASSERT_EQUAL_STRING("0.500000", buf.c_str());
+  buf.clear();
+  buf.addFixed(4000000000.0, 0);
+  TEST_ASSERT_EQUAL_STRING("4000000000", buf.c_str());
+}
+
+static void test_special_values()
+{
+  char text[32];
+  FmtBuf buf(text, sizeof(text));
+  buf.addFixed(NAN, 2).add(',').addFixed(INFINITY, 2).add(',').addFixed(5e9, 2).add(',').addFixed(-5e9, 2);
+  TEST_ASSERT_EQUAL_STRING("nan,inf,ovf,ovf", buf.c_str());
+}
+
+static void test_tuple()
+{
+  char text[64];
+  FmtBuf buf(text, sizeof(text));
+  buf.add("[").addUint(1700000040).add("000,").addFixed(1234.0, 2).add("]");
+  TEST_ASSERT_EQUAL_STRING("[1700000040000,1234.00]", buf.c_str());
+}
+
+static void test_overflow()
+{
+  char text[8];
+  FmtBuf buf(text, sizeof(text));
+  buf.add("12345");
+  TEST_ASSERT_FALSE(buf.overflow());
+  buf.add("67890");               // truncated, always 0-terminated
+  TEST_ASSERT_TRUE(buf.overflow());
+  TEST_ASSERT_EQUAL_STRING("1234567", text);
+  TEST_ASSERT_EQUAL(7, buf.length());
+  buf.addUint(1).add('x');
+  TEST_ASSERT_EQUAL_STRING("1234567", text);
+  buf.clear();
+  TEST_ASSERT_FALSE(buf.overflow());
+  TEST_ASSERT_EQUAL_STRING("", text);
+  buf.add("1234567");             // exactly fits with terminating 0
+  TEST_ASSERT_FALSE(buf.overflow());
+  TEST_ASSERT_EQUAL_STRING("1234567", text);
+}
+
+static void test_uuid()
+{
+  uint8_t uuid[VZ_UUID_SIZE];
+  TEST_ASSERT_TRUE(uuidParse("ae53c580-1234-5678-90ab-cdef01234567", uuid));
+  char text[64];
+  FmtBuf buf(text, sizeof(text));
+  buf.add("{\"uuid\":\"").addUuid(uuid).add("\"}");
+  TEST_ASSERT_EQUAL_STRING("{\"uuid\":\"ae53c580-1234-5678-90ab-cdef01234567\"}", buf.c_str());
+  TEST_ASSERT_EQUAL(strlen(text), buf.length());
+
+  char small[16];
+  FmtBuf truncated(small, sizeof(small));
+  truncated.add("id=").addUuid(uuid);
+  TEST_ASSERT_TRUE(truncated.overflow());
+  TEST_ASSERT_EQUAL_STRING("id=ae53c580-123", small);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_integers);
+  RUN_TEST(test_fixed);
+  RUN_TEST(test_special_values);
+  RUN_TEST(test_tuple);
+  RUN_TEST(test_overflow);
+  RUN_TEST(test_uuid);
+  return UNITY_END();
+}
@@ -0,0 +1,284 @@
+// test_gzip.cpp
+//
+// unit tests of gzip.cpp: compressed bodies are decompressed again and compared
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "gzip.h"
+
+#define MAX_SIZE 4096
+
+static uint8_t packed[MAX_SIZE + 64];
+static uint8_t unpacked[MAX_SIZE];
+
+// inflate of one deflate stream with stored and fixed Huffman blocks, enough for the output of gzipCompress()
+class Inflater
+{
+public:
+  Inflater(const uint8_t* in, size_t len) : _in(in), _len(len) {}
+
+  // return length of output, -1 if the stream is invalid
+  int32_t inflate(uint8_t* out, size_t size)
+  {
+    static const uint16_t lengthBase[29] = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,
+                                            163,195,227,258};
+    static const uint8_t lengthExtra[29] = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+    static const uint16_t distBase[30] = {1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,
+                                          3073,4097,6145,8193,12289,16385,24577};
+    static const uint8_t distExtra[30] = {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+    size_t n = 0;
+    bool last = false;
+    while (!last)
+    {
+      last = bits(1);
+      uint32_t type = bits(2);
+      if(type == 0)
+      {
+        _bit = 0;       // stored: byte aligned
+        _pos++;
+        if((_pos + 4) > _len)
+        {
+          return -1;
+        }
+        uint16_t storedLen = _in[_pos] | (_in[_pos + 1] << 8);
+        _pos += 4;
+        if(((_pos + storedLen) > _len) || ((n + storedLen) > size))
+        {
+          return -1;
+        }
+        memcpy(out + n, _in + _pos, storedLen);
+        n += storedLen;
+        _pos += storedLen;
+        continue;
+      }
+      if(type != 1)
+      {
+        return -1;
+      }
+      while (true)
+      {
+        int32_t sym = literal();
+        if((sym < 0) || _error)
+        {
+          return -1;
+        }
+        if(sym < 256)
+        {
+          if(n >= size)
+          {
+            return -1;
+          }
+          out[n++] = sym;
+          continue;
+        }
+        if(sym == 256)
+        {
+          break;
+        }
+        sym -= 257;
+        if(sym >= 29)
+        {
+          return -1;
+        }
+        uint32_t length = lengthBase[sym] + bits(lengthExtra[sym]);
+        uint32_t code = huffman(5);
+        if(code >= 30)
+        {
+          return -1;
+        }
+        uint32_t dist = distBase[code] + bits(distExtra[code]);
+        if((dist > n) || ((n + length) > size))
+        {
+          return -1;
+        }
+        while (length--)
+        {
+          out[n] = out[n - dist];
+          n++;
+        }
+      }
+    }
+    if(_bit > 0)
+    {
+      _pos++;
+    }
+    return _error ? -1 : (int32_t)n;
+  }
+
+  size_t position() { return _pos; }
+
+private:
+  const uint8_t* _in;
+  size_t _len;
+  size_t _pos = 0;
+  uint8_t _bit = 0;
+  bool _error = false;
+
+  uint32_t bits(uint8_t n)        // LSB first
+  {
+    uint32_t value = 0;
+    uint8_t i;
+    for (i=0;i<n;i++)
+    {
+      if(_pos >= _len)
+      {
+        _error = true;
+        return 0;
+      }
+      value |= ((_in[_pos] >> _bit) & 1) << i;
+      if(++_bit == 8)
+      {
+        _bit = 0;
+        _pos++;
+      }
+    }
+    return value;
+  }
+
+  uint32_t huffman(uint8_t n)     // MSB first
+  {
+    uint32_t code = 0;
+    while (n--)
+    {
+      code = (code << 1) | bits(1);
+    }
+    return code;
+  }
+
+  int32_t literal()               // fixed literal/length code, RFC 1951 3.2.6
+  {
+    uint32_t code = huffman(7);
+    if(code <= 0x17)
+    {
+      return 256 + code;
+    }
+    code = (code << 1) | bits(1);
+    if((code >= 0x30) && (code <= 0xBF))
+    {
+      return code - 0x30;
+    }
+    if((code >= 0xC0) && (code <= 0xC7))
+    {
+      return 280 + code - 0xC0;
+    }
+    code = (code << 1) | bits(1);
+    if((code >= 0x190) && (code <= 0x1FF))
+    {
+      return 144 + code - 0x190;
+    }
+    return -1;
+  }
+};
+
+static uint32_t le32(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// compress, check header and trailer, decompress and compare; return compressed length
+static size_t roundTrip(const uint8_t* in, size_t len)
+{
+  size_t packedLen = gzipCompress(in, len, packed, sizeof(packed));
+  TEST_ASSERT_GREATER_THAN(18, packedLen);
+  TEST_ASSERT_EQUAL_UINT8(0x1F, packed[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x8B, packed[1]);
+  TEST_ASSERT_EQUAL_UINT8(8, packed[2]);          // deflate
+
+  Inflater inflater(packed + 10, packedLen - 18);
+  int32_t n = inflater.inflate(unpacked, sizeof(unpacked));
+  TEST_ASSERT_EQUAL(len, n);
+  TEST_ASSERT_EQUAL(packedLen - 18, inflater.position());    // deflate stream ends right before the trailer
+  TEST_ASSERT_EQUAL_MEMORY(in, unpacked, len);
+  TEST_ASSERT_EQUAL_UINT32(crc32Update(0, in, len), le32(packed + packedLen - 8));
+  TEST_ASSERT_EQUAL_UINT32(len, le32(packed + packedLen - 4));
+  return packedLen;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_crc32()
+{
+  TEST_ASSERT_EQUAL_UINT32(0xCBF43926, crc32Update(0, (const uint8_t*)"123456789", 9));
+  uint32_t crc = crc32Update(0, (const uint8_t*)"12345", 5);    // in pieces
+  TEST_ASSERT_EQUAL_UINT32(0xCBF43926, crc32Update(crc, (const uint8_t*)"6789", 4));
+}
+
+static void test_middleware_body()
+{
+  // body of a replayed batch: repetitive UUIDs and time stamps, as sent by VzHttp
+  char body[MAX_SIZE];
+  size_t len = 0;
+  uint8_t ch;
+  body[len++] = '[';
+  for (ch=0;ch<4;ch++)
+  {
+    len += snprintf(body + len, sizeof(body) - len, "%s{\"uuid\":\"ae53c580-1234-5678-90ab-cdef0123456%u\",\"tuples\":[",
+                    (ch > 0) ? "," : "", ch);
+    uint8_t i;
+    for (i=0;i<8;i++)
+    {
+      len += snprintf(body + len, sizeof(body) - len, "%s[%lu000,%u.%02u]", (i > 0) ? "," : "",
+                      1700000000UL + i * 60, 1000 + ch * 37 + i * 11, (i * 7) % 100);
+    }
+    len += snprintf(body + len, sizeof(body) - len, "]}");
+  }
+  body[len++] = ']';
+  size_t packedLen = roundTrip((const uint8_t*)body, len);
+  TEST_ASSERT_LESS_THAN(len / 2, packedLen);
+}
+
+static void test_incompressible()
+{
+  uint8_t data[1024];
+  uint32_t x = 12345;
+  size_t i;
+  for (i=0;i<sizeof(data);i++)
+  {
+    x = x * 1103515245 + 12345;
+    data[i] = x >> 16;
+  }
+  roundTrip(data, sizeof(data));
+}
+
+static void test_long_runs()
+{
+  uint8_t data[MAX_SIZE];
+  memset(data, 'a', sizeof(data));      // matches of max length 258
+  memcpy(data + 1000, "0123456789", 10);
+  roundTrip(data, sizeof(data));
+  roundTrip(data, 1);
+  roundTrip(data, 3);
+  roundTrip((const uint8_t*)"", 0);
+}
+
+static void test_output_too_small()
+{
+  const char* text = "{\"uuid\":\"ae53c580-1234-5678-90ab-cdef01234567\",\"tuples\":[[1700000000000,1.00]]}";
+  size_t packedLen = gzipCompress((const uint8_t*)text, strlen(text), packed, sizeof(packed));
+  TEST_ASSERT_GREATER_THAN(0, packedLen);
+  TEST_ASSERT_EQUAL(0, gzipCompress((const uint8_t*)text, strlen(text), packed, packedLen - 1));
+  TEST_ASSERT_EQUAL(packedLen, gzipCompress((const uint8_t*)text, strlen(text), packed, packedLen));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_crc32);
+  RUN_TEST(test_middleware_body);
+  RUN_TEST(test_incompressible);
+  RUN_TEST(test_long_runs);
+  RUN_TEST(test_output_too_small);
+  return UNITY_END();
+}
@@ -0,0 +1,186 @@
+// test_history.cpp
+//
+// unit tests of history.cpp: delta encoding of the samples and the ring of blocks
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "history.h"
+
+#define T0 (1700000000UL / 60 * 60)     // full minute
+
+static History* history;
+
+// test value of series s at minute m: power with jumps, negative temperatures, 0 for the room sensor at times
+static float testValue(uint32_t m, uint8_t s)
+{
+  switch (s)
+  {
+  case histPOWER:         return (m % 97 == 0) ? 0 : (float)((m * 137) % 6000);
+  case histDC_U:          return 280.0f + (float)(m % 50) / 10;
+  case histDC_I:          return (float)((m * 7) % 1200) / 100;
+  case histTEMP_INVERTER: return -12.5f + (float)(m % 600) / 10;
+  default:                return (m % 5 == 0) ? 0 : 21.3f;
+  }
+}
+
+static Snapshot snapshotAt(uint32_t m)
+{
+  Snapshot snapshot;
+  snapshot.timeStamp = T0 + m * 60;
+  snapshot.power = testValue(m, histPOWER);
+  snapshot.dcU = testValue(m, histDC_U);
+  snapshot.dcI = testValue(m, histDC_I);
+  snapshot.temperatureInverter = testValue(m, histTEMP_INVERTER);
+  snapshot.temperatureRoom = testValue(m, histTEMP_ROOM);
+  return snapshot;
+}
+
+static void assertSample(const HistorySample& sample, uint32_t m)
+{
+  static const float tolerance[N_HISTORY_SERIES] = {0.5f, 0.05f, 0.005f, 0.05f, 0.05f};    // half of scaling
+  TEST_ASSERT_EQUAL_UINT32(T0 + m * 60, sample.timeStamp);
+  uint8_t s;
+  for (s=0;s<N_HISTORY_SERIES;s++)
+  {
+    TEST_ASSERT_FLOAT_WITHIN(tolerance[s], testValue(m, s), sample.value[s]);
+  }
+}
+
+void setUp()
+{
+  history = new History();
+}
+
+void tearDown()
+{
+  delete history;
+}
+
+static void test_empty()
+{
+  HistoryCursor cursor;
+  HistorySample sample;
+  history->seek(cursor, 0);
+  TEST_ASSERT_FALSE(history->next(cursor, sample));
+  TEST_ASSERT_EQUAL_UINT32(0, history->getSampleCount());
+  TEST_ASSERT_EQUAL_UINT32(0, history->getOldestTime());
+}
+
+static void test_encode_decode()
+{
+  uint32_t m;
+  for (m=0;m<300;m++)
+  {
+    TEST_ASSERT_TRUE(history->add(snapshotAt(m)));
+  }
+  TEST_ASSERT_FALSE(history->add(snapshotAt(299)));     // same minute
+  TEST_ASSERT_EQUAL_UINT32(300, history->getSampleCount());
+  TEST_ASSERT_LESS_THAN(300 * 12, history->getBytesUsed());   // smaller than half of the floats
+
+  HistoryCursor cursor;
+  HistorySample sample;
+  history->seek(cursor, 0);
+  for (m=0;m<300;m++)
+  {
+    TEST_ASSERT_TRUE(history->next(cursor, sample));
+    assertSample(sample, m);
+  }
+  TEST_ASSERT_FALSE(history->next(cursor, sample));
+
+  history->add(snapshotAt(300));      // cursor continues after add()
+  TEST_ASSERT_TRUE(history->next(cursor, sample));
+  assertSample(sample, 300);
+}
+
+static void test_gaps_and_query()
+{
+  static const uint32_t minutes[] = {0, 1, 2, 600, 601, 1439, 5000};    // night, outage
+  size_t i;
+  for (i=0;i<sizeof(minutes)/sizeof(minutes[0]);i++)
+  {
+    history->add(snapshotAt(minutes[i]));
+  }
+  uint32_t expected[8];
+  uint8_t n = 0;
+  uint16_t count = history->query(T0 + 2 * 60, T0 + 1439 * 60, [&](const HistorySample& sample)
+  {
+    expected[n++ & 7] = sample.timeStamp;
+  });
+  TEST_ASSERT_EQUAL(4, count);        // from and to inclusive
+  TEST_ASSERT_EQUAL_UINT32(T0 + 2 * 60, expected[0]);
+  TEST_ASSERT_EQUAL_UINT32(T0 + 600 * 60, expected[1]);
+  TEST_ASSERT_EQUAL_UINT32(T0 + 601 * 60, expected[2]);
+  TEST_ASSERT_EQUAL_UINT32(T0 + 1439 * 60, expected[3]);
+  TEST_ASSERT_EQUAL_UINT32(T0 + 5000 * 60, history->getNewestTime());
+}
+
+static void test_ring_wrap()
+{
+  // more samples than the ring holds: the oldest blocks are overwritten, the rest stays consistent
+  uint32_t added = 0;
+  while (history->getSampleCount() == added)
+  {
+    history->add(snapshotAt(added));
+    added++;
+  }
+  uint32_t m;
+  for (m=0;m<added;m++)
+  {
+    history->add(snapshotAt(added + m));
+  }
+  uint32_t last = 2 * added - 1;
+  uint32_t count = history->getSampleCount();
+  TEST_ASSERT_LESS_THAN(2 * added, count);
+  TEST_ASSERT_EQUAL_UINT32(T0 + last * 60, history->getNewestTime());
+  uint32_t first = last + 1 - count;
+  TEST_ASSERT_EQUAL_UINT32(T0 + first * 60, history->getOldestTime());
+
+  HistoryCursor cursor;
+  HistorySample sample;
+  history->seek(cursor, 0);
+  for (m=first;m<=last;m++)
+  {
+    TEST_ASSERT_TRUE(history->next(cursor, sample));
+    assertSample(sample, m);
+  }
+  TEST_ASSERT_FALSE(history->next(cursor, sample));
+}
+
+static void test_cursor_overwritten()
+{
+  // a cursor whose block is overwritten while it is used continues with the oldest block
+  uint32_t m = 0;
+  while (history->getSampleCount() == m)
+  {
+    history->add(snapshotAt(m++));
+  }
+  HistoryCursor cursor;
+  HistorySample sample;
+  history->seek(cursor, 0);
+  TEST_ASSERT_TRUE(history->next(cursor, sample));
+  uint32_t end = 2 * m;
+  for (;m<end;m++)
+  {
+    history->add(snapshotAt(m));
+  }
+  TEST_ASSERT_TRUE(history->next(cursor, sample));
+  TEST_ASSERT_EQUAL_UINT32(history->getOldestTime(), sample.timeStamp);
+  assertSample(sample, (sample.timeStamp - T0) / 60);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_empty);
+  RUN_TEST(test_encode_decode);
+  RUN_TEST(test_gaps_and_query);
+  RUN_TEST(test_ring_wrap);
+  RUN_TEST(test_cursor_overwritten);
+  return UNITY_END();
+}
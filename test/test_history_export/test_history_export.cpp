@@ -0,0 +1,138 @@
+// test_history_export.cpp
+//
+// unit tests of historyStream.cpp: CSV/JSON text of the history export, identical for any chunk size
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include <string>
+#include "historyStream.h"
+
+#define T0 1700000040UL             // full minute
+#define SAMPLES 500
+
+static History* history;
+
+static std::string exportText(uint32_t from, uint32_t to, uint32_t step, bool json, size_t chunk)
+// all chunks of an export with chunk bytes each, as AsyncWebServer asks for them
+{
+  HistoryStream stream(*history, from, to, step, json);
+  std::string text;
+  uint8_t buffer[4096];
+  size_t n;
+  while ((n = stream.fill(buffer, chunk)) > 0)
+  {
+    TEST_ASSERT_LESS_OR_EQUAL(chunk, n);
+    text.append((const char*)buffer, n);
+    if(n < chunk)
+    {
+      TEST_ASSERT_EQUAL(0, stream.fill(buffer, chunk));             // short chunk only at the end
+      break;
+    }
+  }
+  return text;
+}
+
+static uint32_t countOf(const std::string& text, char c)
+{
+  uint32_t n = 0;
+  size_t i;
+  for (i=0;i<text.size();i++)
+  {
+    n += (text[i] == c);
+  }
+  return n;
+}
+
+void setUp()
+{
+  history = new History();
+  uint32_t m;
+  for (m=0;m<SAMPLES;m++)
+  {
+    Snapshot snapshot;
+    snapshot.timeStamp = T0 + m * 60;
+    snapshot.power = (m * 37) % 5000;
+    snapshot.dcU = 300 + (m % 20) / 10.0f;
+    snapshot.dcI = (m % 900) / 100.0f;
+    snapshot.temperatureInverter = -5 + (m % 400) / 10.0f;
+    snapshot.temperatureRoom = 21.5f;
+    history->add(snapshot);
+  }
+}
+
+void tearDown()
+{
+  delete history;
+}
+
+static void test_csv()
+{
+  std::string text = exportText(0, UINT32_MAX, 60, false, 4096);
+  TEST_ASSERT_EQUAL(SAMPLES + 1, countOf(text, '\n'));
+  TEST_ASSERT_EQUAL_STRING("time,power,dc_u,dc_i,t_inv,t_room\n1700000040,0,300.0,0.00,-5.0,21.5\n",
+                           text.substr(0, 68).c_str());
+  TEST_ASSERT_EQUAL_STRING("1700029980,3463,301.9,4.99,4.9,21.5\n", text.substr(text.size() - 36).c_str());
+}
+
+static void test_json()
+{
+  std::string text = exportText(T0 + 60, T0 + 180, 60, true, 4096);
+  TEST_ASSERT_EQUAL_STRING("{\"columns\":[\"time\",\"power\",\"dc_u\",\"dc_i\",\"t_inv\",\"t_room\"],\"samples\":["
+                           "[1700000100,37,300.1,0.01,-4.9,21.5],[1700000160,74,300.2,0.02,-4.8,21.5],"
+                           "[1700000220,111,300.3,0.03,-4.7,21.5]]}", text.c_str());
+}
+
+static void test_range_and_step()
+{
+  std::string text = exportText(T0 + 100 * 60, T0 + 199 * 60, 300, false, 4096);   // every 5th sample
+  TEST_ASSERT_EQUAL(1 + 20, countOf(text, '\n'));
+  HistoryStream stream(*history, T0 + 100 * 60, T0 + 199 * 60, 300, false);
+  uint8_t buffer[64];
+  while (stream.fill(buffer, sizeof(buffer)) > 0)
+  {
+  }
+  TEST_ASSERT_EQUAL_UINT32(20, stream.getRows());
+
+  text = exportText(T0 + SAMPLES * 60, UINT32_MAX, 60, true, 4096);               // after the newest sample
+  TEST_ASSERT_EQUAL_STRING("{\"columns\":[\"time\",\"power\",\"dc_u\",\"dc_i\",\"t_inv\",\"t_room\"],\"samples\":[]}",
+                           text.c_str());
+}
+
+static void test_chunk_sizes()
+{
+  // rows continued across chunks: the same text for every chunk size, no filler bytes
+  static const size_t chunks[] = {1, 7, 33, 80, 81, 4096};
+  bool json;
+  for (json=false;;json=true)
+  {
+    std::string reference = exportText(0, UINT32_MAX, 60, json, 4096);
+    size_t i;
+    for (i=0;i<sizeof(chunks)/sizeof(chunks[0]);i++)
+    {
+      std::string text = exportText(0, UINT32_MAX, 60, json, chunks[i]);
+      TEST_ASSERT_EQUAL(reference.size(), text.size());
+      TEST_ASSERT_TRUE_MESSAGE(text == reference, json ? "json" : "csv");
+    }
+    TEST_ASSERT_EQUAL(reference.size(), strlen(reference.c_str()));
+    if(json)
+    {
+      break;
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_csv);
+  RUN_TEST(test_json);
+  RUN_TEST(test_range_and_step);
+  RUN_TEST(test_chunk_sizes);
+  return UNITY_END();
+}
@@ -0,0 +1,130 @@
+// test_jsonwriter.cpp
+//
+// unit tests of jsonWriter.cpp: commas of nested objects, value types, null for numbers out of range, escaped texts
+//
+// 2026-10-18 mh
+// - escaped texts
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include <math.h>
+#include "jsonWriter.h"
+
+// collects the output like an AsyncResponseStream
+class StringPrint : public Print
+{
+public:
+    size_t write(uint8_t c) override
+    {
+      return write(&c, 1);
+    }
+    size_t write(const uint8_t* buffer, size_t size) override
+    {
+      if((_length + size) >= sizeof(_text))
+      {
+        size = sizeof(_text) - 1 - _length;
+      }
+      memcpy(&_text[_length], buffer, size);
+      _length += size;
+      _text[_length] = 0;
+      return size;
+    }
+    const char* c_str() { return _text; }
+    size_t length() { return _length; }
+
+private:
+    char _text[512] = {0};
+    size_t _length = 0;
+};
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_empty_object()
+{
+  StringPrint out;
+  JsonWriter json(out);
+  json.beginObject().endObject();
+  TEST_ASSERT_EQUAL_STRING("{}", out.c_str());
+}
+
+static void test_nested_objects()
+{
+  StringPrint out;
+  JsonWriter json(out);
+  json.beginObject().add("seq", (uint32_t)42);
+  json.beginObject("dc").add("u", 301.25f, 1).add("i", 1.5f, 2).endObject();
+  json.beginObject("empty").endObject();
+  json.beginObject("outer").beginObject("inner").add("n", (uint32_t)0).endObject().add("m", (uint32_t)1).endObject();
+  json.add("last", (uint32_t)4294967295UL);
+  json.endObject();
+  TEST_ASSERT_EQUAL_STRING("{\"seq\":42,\"dc\":{\"u\":301.3,\"i\":1.50},\"empty\":{},"
+    "\"outer\":{\"inner\":{\"n\":0},\"m\":1},\"last\":4294967295}", out.c_str());
+}
+
+static void test_bool_and_text()
+{
+  StringPrint out;
+  JsonWriter json(out);
+  json.beginObject().add("on", true).add("off", false).add("name", "SUN2000").add("blank", "").endObject();
+  TEST_ASSERT_EQUAL_STRING("{\"on\":true,\"off\":false,\"name\":\"SUN2000\",\"blank\":\"\"}", out.c_str());
+}
+
+static void test_escaped_text()
+{
+  StringPrint out;
+  JsonWriter json(out);
+  json.beginObject().add("ssid", "my \"home\" \\ net").add("ctrl", "a\nb\rc\td\x01" "e\x1f").add("utf8", "W\xc3\xa4rme").endObject();
+  TEST_ASSERT_EQUAL_STRING("{\"ssid\":\"my \\\"home\\\" \\\\ net\",\"ctrl\":\"a\\nb\\rc\\td\\u0001e\\u001f\","
+    "\"utf8\":\"W\xc3\xa4rme\"}", out.c_str());
+  TEST_ASSERT_EQUAL(out.length(), json.length());
+}
+
+static void test_numbers()
+{
+  StringPrint out;
+  JsonWriter json(out);
+  json.beginObject().add("neg", -12.34f, 1).add("zero", 0.0f, 0).add("big", 4.2e9f, 0).endObject();
+  TEST_ASSERT_EQUAL_STRING("{\"neg\":-12.3,\"zero\":0,\"big\":4200000000}", out.c_str());
+}
+
+static void test_null_numbers()
+{
+  // no representation in JSON or beyond FmtBuf::addFixed(): null instead of nan, inf or ovf
+  StringPrint out;
+  JsonWriter json(out);
+  json.beginObject().add("nan", NAN, 1).add("inf", INFINITY, 1).add("ninf", -INFINITY, 1);
+  json.add("ovf", 4.3e9f, 1).add("novf", -1e10f, 0).endObject();
+  TEST_ASSERT_EQUAL_STRING("{\"nan\":null,\"inf\":null,\"ninf\":null,\"ovf\":null,\"novf\":null}", out.c_str());
+}
+
+static void test_length()
+{
+  StringPrint out;
+  JsonWriter json(out);
+  json.beginObject().add("a", (uint32_t)1).beginObject("b").add("c", true).endObject().endObject();
+  TEST_ASSERT_EQUAL(strlen(out.c_str()), json.length());
+  TEST_ASSERT_EQUAL(out.length(), json.length());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_object);
+  RUN_TEST(test_nested_objects);
+  RUN_TEST(test_bool_and_text);
+  RUN_TEST(test_escaped_text);
+  RUN_TEST(test_numbers);
+  RUN_TEST(test_null_numbers);
+  RUN_TEST(test_length);
+  return UNITY_END();
+}
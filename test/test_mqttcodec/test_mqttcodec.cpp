@@ -0,0 +1,222 @@
+// test_mqttcodec.cpp
+//
+// unit tests of mqttCodec.cpp: remaining length of 1..4 bytes, CONNECT and PUBLISH layout, packets split across
+// several reads, PUBACK of the packet id, malformed remaining length
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "mqttCodec.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// remaining length decoded by the reader after a header byte
+static uint32_t decodeLength(const uint8_t* buf, size_t n)
+{
+  MqttReader reader;
+  reader.put(MQTT_PINGRESP);
+  size_t i;
+  for (i=0;i<n;i++)
+  {
+    MqttReader::Result result = reader.put(buf[i]);
+    TEST_ASSERT_TRUE(result != MqttReader::MALFORMED);
+  }
+  return reader.getLength();
+}
+
+static void test_length()
+{
+  // limits of 1..4 bytes (MQTT 3.1.1, table 2.4)
+  const uint32_t lengths[] = {0, 127, 128, 16383, 16384, 2097151, 2097152, 268435455};
+  const size_t bytes[] = {1, 1, 2, 2, 3, 3, 4, 4};
+  uint8_t buf[MQTT_MAX_LENGTH_BYTES];
+  size_t i;
+  for (i=0;i<sizeof(lengths)/sizeof(lengths[0]);i++)
+  {
+    size_t n = mqttPutLength(buf, lengths[i]);
+    TEST_ASSERT_EQUAL(bytes[i], n);
+    TEST_ASSERT_EQUAL(lengths[i], decodeLength(buf, n));
+  }
+  mqttPutLength(buf, 321);
+  TEST_ASSERT_EQUAL_HEX8(0xC1, buf[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x02, buf[1]);
+}
+
+static void test_malformed_length()
+{
+  MqttReader reader;
+  const uint8_t packet[] = {MQTT_PUBACK, 0xFF, 0xFF, 0xFF, 0xFF};
+  size_t i;
+  for (i=0;i<4;i++)
+  {
+    TEST_ASSERT_EQUAL(MqttReader::MORE, reader.put(packet[i]));
+  }
+  TEST_ASSERT_EQUAL(MqttReader::MALFORMED, reader.put(packet[4]));
+
+  // next packet after reset()
+  reader.reset();
+  TEST_ASSERT_EQUAL(MqttReader::MORE, reader.put(MQTT_PINGRESP));
+  TEST_ASSERT_EQUAL(MqttReader::PACKET, reader.put(0));
+  TEST_ASSERT_EQUAL(MQTT_PINGRESP, reader.getType());
+}
+
+static void test_connect()
+{
+  uint8_t buf[200];
+  size_t n = mqttConnect(buf, sizeof(buf), "solis", 60, "s/status", "offline", "", "");
+  const uint8_t expected[] = {
+    MQTT_CONNECT, 36,
+    0, 4, 'M', 'Q', 'T', 'T', 4, 0x24, 0, 60,
+    0, 5, 's', 'o', 'l', 'i', 's',
+    0, 8, 's', '/', 's', 't', 'a', 't', 'u', 's',
+    0, 7, 'o', 'f', 'f', 'l', 'i', 'n', 'e'};
+  TEST_ASSERT_EQUAL(sizeof(expected), n);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, n);
+
+  // user and password
+  n = mqttConnect(buf, sizeof(buf), "solis", 60, "s/status", "offline", "u", "pw");
+  TEST_ASSERT_EQUAL(sizeof(expected) + 3 + 4, n);
+  TEST_ASSERT_EQUAL(36 + 3 + 4, buf[1]);
+  TEST_ASSERT_EQUAL_HEX8(0xE4, buf[9]);
+  const uint8_t credentials[] = {0, 1, 'u', 0, 2, 'p', 'w'};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(credentials, &buf[sizeof(expected)], sizeof(credentials));
+  // password without user is not sent
+  n = mqttConnect(buf, sizeof(buf), "solis", 60, "s/status", "offline", "", "pw");
+  TEST_ASSERT_EQUAL(sizeof(expected), n);
+
+  // too long for the buffer
+  TEST_ASSERT_EQUAL(0, mqttConnect(buf, 40, "solis", 60, "s/status", "offline", "", ""));
+}
+
+static void test_publish()
+{
+  uint8_t buf[400];
+  // QoS 1 with packet id
+  size_t n = mqttPublish(buf, sizeof(buf), MQTT_PUBLISH | 0x02, "t/x", 0x1234, "{}", 2);
+  const uint8_t expected[] = {MQTT_PUBLISH | 0x02, 9, 0, 3, 't', '/', 'x', 0x12, 0x34, '{', '}'};
+  TEST_ASSERT_EQUAL(sizeof(expected), n);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, n);
+
+  // QoS 0 retained, no packet id
+  n = mqttPublish(buf, sizeof(buf), MQTT_PUBLISH | MQTT_FLAG_RETAIN, "t/x", 0x1234, "on", 2);
+  const uint8_t retained[] = {MQTT_PUBLISH | MQTT_FLAG_RETAIN, 7, 0, 3, 't', '/', 'x', 'o', 'n'};
+  TEST_ASSERT_EQUAL(sizeof(retained), n);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(retained, buf, n);
+
+  // remaining length of two bytes
+  char payload[200];
+  memset(payload, 'a', sizeof(payload));
+  n = mqttPublish(buf, sizeof(buf), MQTT_PUBLISH, "t/x", 0, payload, sizeof(payload));
+  TEST_ASSERT_EQUAL(1 + 2 + 5 + sizeof(payload), n);
+  TEST_ASSERT_EQUAL(5 + sizeof(payload), decodeLength(&buf[1], 2));
+
+  TEST_ASSERT_EQUAL(0, mqttPublish(buf, 100, MQTT_PUBLISH, "t/x", 0, payload, sizeof(payload)));
+}
+
+static void test_split_packets()
+{
+  // CONNACK, a long PUBLISH from the broker, PUBACK 7 and PUBACK 8 in one stream
+  uint8_t stream[400];
+  char payload[300];
+  memset(payload, 'p', sizeof(payload));
+  size_t n = 0;
+  const uint8_t connack[] = {MQTT_CONNACK, 2, 0, 0};
+  memcpy(&stream[n], connack, sizeof(connack));
+  n += sizeof(connack);
+  n += mqttPublish(&stream[n], sizeof(stream) - n, MQTT_PUBLISH, "cmd", 0, payload, sizeof(payload));
+  const uint8_t pubacks[] = {MQTT_PUBACK, 2, 0, 7, MQTT_PUBACK, 2, 0, 8};
+  memcpy(&stream[n], pubacks, sizeof(pubacks));
+  n += sizeof(pubacks);
+
+  // each split of the stream into reads of any size gives the same packets
+  size_t readSize;
+  for (readSize=1;readSize<=n;readSize++)
+  {
+    MqttReader reader;
+    uint8_t types[8];
+    uint32_t lengths[8];
+    bool acked7 = false;
+    bool acked8 = false;
+    size_t packets = 0;
+    size_t start;
+    for (start=0;start<n;start+=readSize)
+    {
+      size_t i;
+      for (i=start;(i<(start + readSize)) && (i<n);i++)
+      {
+        MqttReader::Result result = reader.put(stream[i]);
+        TEST_ASSERT_TRUE(result != MqttReader::MALFORMED);
+        if(result == MqttReader::PACKET)
+        {
+          TEST_ASSERT_TRUE(packets < 8);
+          types[packets] = reader.getType();
+          lengths[packets] = reader.getLength();
+          acked7 |= reader.isPubAck(7);
+          acked8 |= reader.isPubAck(8) && (packets == 3);
+          packets++;
+        }
+      }
+    }
+    TEST_ASSERT_EQUAL(4, packets);
+    TEST_ASSERT_EQUAL(MQTT_CONNACK, types[0]);
+    TEST_ASSERT_EQUAL(MQTT_PUBLISH, types[1]);
+    TEST_ASSERT_EQUAL(2 + 3 + sizeof(payload), lengths[1]);
+    TEST_ASSERT_EQUAL(MQTT_PUBACK, types[2]);
+    TEST_ASSERT_EQUAL(MQTT_PUBACK, types[3]);
+    TEST_ASSERT_TRUE(acked7);
+    TEST_ASSERT_TRUE(acked8);
+  }
+}
+
+static void test_puback_id()
+{
+  MqttReader reader;
+  const uint8_t puback[] = {MQTT_PUBACK, 2, 0x12, 0x34};
+  size_t i;
+  for (i=0;i<sizeof(puback);i++)
+  {
+    reader.put(puback[i]);
+  }
+  TEST_ASSERT_TRUE(reader.isPubAck(0x1234));
+  TEST_ASSERT_FALSE(reader.isPubAck(0x1235));
+  TEST_ASSERT_FALSE(reader.isPubAck(0x3412));
+
+  // same bytes in another packet type are no PUBACK
+  const uint8_t other[] = {MQTT_CONNACK, 2, 0x12, 0x34};
+  for (i=0;i<sizeof(other);i++)
+  {
+    reader.put(other[i]);
+  }
+  TEST_ASSERT_FALSE(reader.isPubAck(0x1234));
+
+  // PUBACK without packet id
+  const uint8_t empty[] = {MQTT_PUBACK, 0};
+  for (i=0;i<sizeof(empty);i++)
+  {
+    reader.put(empty[i]);
+  }
+  TEST_ASSERT_FALSE(reader.isPubAck(0x1234));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_length);
+  RUN_TEST(test_malformed_length);
+  RUN_TEST(test_connect);
+  RUN_TEST(test_publish);
+  RUN_TEST(test_split_packets);
+  RUN_TEST(test_puback_id);
+  return UNITY_END();
+}
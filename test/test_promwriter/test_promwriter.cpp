@@ -0,0 +1,172 @@
+// test_promwriter.cpp
+//
+// unit tests of promWriter.cpp: Prometheus text format, groups written again into the next chunk, "#\n" filler
+// for small chunks, oversized group skipped
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include <math.h>
+#include <string>
+#include "promWriter.h"
+
+#define MAX_GROUP 64                // small limit of a group, so the tests use small chunks
+
+// three groups of 30, 32 and 13 bytes
+static bool writeGroups(uint8_t group, PromWriter& out)
+{
+  switch (group)
+  {
+  case 0:
+    out.sample("a_total", (uint32_t)1);
+    out.sample("a_total", (uint32_t)22, "src=\"x\"");
+    return true;
+  case 1:
+    out.header("b", "gauge", "B value");
+    return true;
+  default:
+    out.sample("c", 1.5f, 2);
+    out.sample("d", NAN, 1);
+    return false;
+  }
+}
+
+static const char* GROUPS =
+  "a_total 1\na_total{src=\"x\"} 22\n"
+  "# HELP b B value\n# TYPE b gauge\n"
+  "c 1.50\nd NaN\n";
+
+// all chunks of a response with chunk size maxLen, separated by |
+static std::string chunks(MetricsWriter writer, size_t maxLen, size_t maxGroup = MAX_GROUP)
+{
+  MetricsStream stream(writer, maxGroup);
+  std::string result;
+  uint8_t buffer[256];
+  size_t n;
+  size_t count = 0;
+  while ((n = stream.fill(buffer, maxLen)) > 0)
+  {
+    TEST_ASSERT_TRUE(n <= maxLen);
+    TEST_ASSERT_TRUE(++count < 1000);
+    if(!result.empty())
+    {
+      result += '|';
+    }
+    result.append((const char*)buffer, n);
+  }
+  return result;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_format()
+{
+  char text[256];
+  FmtBuf buf(text, sizeof(text));
+  PromWriter out(buf);
+  out.gauge("g", "help text", (uint32_t)7);
+  out.gauge("f", "float", -2.25f, 1);
+  out.counter("c_total", "count", (uint32_t)4294967295UL);
+  TEST_ASSERT_EQUAL_STRING(
+    "# HELP g help text\n# TYPE g gauge\ng 7\n"
+    "# HELP f float\n# TYPE f gauge\nf -2.3\n"
+    "# HELP c_total count\n# TYPE c_total counter\nc_total 4294967295\n", buf.c_str());
+}
+
+static void test_one_chunk()
+{
+  TEST_ASSERT_EQUAL_STRING(GROUPS, chunks(writeGroups, 256).c_str());
+}
+
+static void test_group_written_again()
+{
+  // a group that does not fit behind the previous one starts the next chunk; FmtBuf keeps one byte for the 0
+  TEST_ASSERT_EQUAL_STRING(
+    "a_total 1\na_total{src=\"x\"} 22\n"
+    "|# HELP b B value\n# TYPE b gauge\n"
+    "|c 1.50\nd NaN\n", chunks(writeGroups, 33).c_str());
+  TEST_ASSERT_EQUAL_STRING(
+    "a_total 1\na_total{src=\"x\"} 22\n# HELP b B value\n# TYPE b gauge\n"
+    "|c 1.50\nd NaN\n", chunks(writeGroups, 63).c_str());
+
+  // each chunk size gives the same text without the fillers
+  size_t maxLen;
+  for (maxLen=33;maxLen<=256;maxLen++)
+  {
+    std::string text = chunks(writeGroups, maxLen);
+    text.erase(std::remove(text.begin(), text.end(), '|'), text.end());
+    TEST_ASSERT_EQUAL_STRING(GROUPS, text.c_str());
+  }
+}
+
+static void test_filler()
+{
+  // group 1 (32 bytes) does not fit into an empty chunk of 31 < MAX_GROUP: "#\n" until a larger chunk is requested
+  MetricsStream stream(writeGroups, MAX_GROUP);
+  uint8_t buffer[256];
+  size_t n = stream.fill(buffer, 31);
+  TEST_ASSERT_EQUAL(30, n);
+  n = stream.fill(buffer, 31);
+  TEST_ASSERT_EQUAL(2, n);
+  TEST_ASSERT_EQUAL_UINT8('#', buffer[0]);
+  TEST_ASSERT_EQUAL_UINT8('\n', buffer[1]);
+  n = stream.fill(buffer, 31);
+  TEST_ASSERT_EQUAL(2, n);
+  n = stream.fill(buffer, 100);
+  TEST_ASSERT_EQUAL_STRING("# HELP b B value\n# TYPE b gauge\nc 1.50\nd NaN\n", std::string((const char*)buffer, n).c_str());
+  TEST_ASSERT_EQUAL(0, stream.fill(buffer, 100));
+}
+
+static bool writeOversized(uint8_t group, PromWriter& out)
+{
+  uint8_t i;
+  switch (group)
+  {
+  case 0:
+    out.sample("first", (uint32_t)1);
+    return true;
+  case 1:
+    for (i=0;i<20;i++)
+    {
+      out.sample("too_large", (uint32_t)i);
+    }
+    return true;
+  default:
+    out.sample("last", (uint32_t)2);
+    return false;
+  }
+}
+
+static void test_oversized_group_skipped()
+{
+  // group 1 needs more than MAX_GROUP bytes: skipped in a chunk of at least MAX_GROUP, the response goes on
+  TEST_ASSERT_EQUAL_STRING("first 1\n|last 2\n", chunks(writeOversized, MAX_GROUP).c_str());
+  TEST_ASSERT_EQUAL_STRING("first 1\n|last 2\n", chunks(writeOversized, 100).c_str());
+  // with the default limit a chunk of 100 bytes only gets fillers, stopped by a larger chunk as in test_filler
+  MetricsStream stream(writeOversized);
+  uint8_t buffer[256];
+  TEST_ASSERT_EQUAL(8, stream.fill(buffer, 100));
+  TEST_ASSERT_EQUAL(2, stream.fill(buffer, 100));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_format);
+  RUN_TEST(test_one_chunk);
+  RUN_TEST(test_group_written_again);
+  RUN_TEST(test_filler);
+  RUN_TEST(test_oversized_group_skipped);
+  return UNITY_END();
+}
@@ -0,0 +1,82 @@
+// test_publishslot.cpp
+//
+// unit tests of publishSlot.cpp: delay to the slot and a simulation of many devices of one site
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "publishSlot.h"
+
+#define PERIOD 60000            // ms, INVERTER_READ_INTERVAL_FREQUENT
+#define WINDOW 30               // s, VZ_PUBLISH_WINDOW
+#define DEVICES 1000
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_offset()
+{
+  TEST_ASSERT_EQUAL_UINT32(0, publishSlotOffset(0x00A1B2C3, 0));
+  TEST_ASSERT_LESS_THAN(WINDOW * 1000, publishSlotOffset(0x00A1B2C3, WINDOW));
+  TEST_ASSERT_EQUAL_UINT32(publishSlotOffset(0x00A1B2C3, WINDOW), publishSlotOffset(0x00A1B2C3, WINDOW));
+  TEST_ASSERT_TRUE(publishSlotOffset(0x00A1B2C3, WINDOW) != publishSlotOffset(0x00A1B2C4, WINDOW));
+}
+
+static void test_delay()
+{
+  TEST_ASSERT_EQUAL_UINT32(17000, publishSlotDelay(20000, 3000, PERIOD));   // slot ahead
+  TEST_ASSERT_EQUAL_UINT32(0, publishSlotDelay(1000, 3000, PERIOD));        // slot passed: at once, not 58 s
+  TEST_ASSERT_EQUAL_UINT32(0, publishSlotDelay(3000, 3000, PERIOD));
+  TEST_ASSERT_EQUAL_UINT32(0, publishSlotDelay(20000, PERIOD + 1000, PERIOD));  // held back batch
+  TEST_ASSERT_EQUAL_UINT32(20000, publishSlotDelay(20000, 0, PERIOD));
+}
+
+static void test_site_simulation()
+{
+  // DEVICES loggers with consecutive chip ids flush 2..5 s after the sample time (modbus poll), then wait for
+  // their slot. Nobody may wait longer than the window, and the posts are spread over the window.
+  uint16_t perSecond[WINDOW] = {0};
+  uint32_t maxDelay = 0;
+  uint32_t lastPost = 0;
+  uint32_t random = 12345;
+  uint16_t i;
+  for (i=0;i<DEVICES;i++)
+  {
+    random = random * 1103515245 + 12345;
+    uint32_t flush = 2000 + (random >> 8) % 3000;
+    uint32_t offset = publishSlotOffset(0x00E4B000 + i, WINDOW);
+    uint32_t delay = publishSlotDelay(offset, flush, PERIOD);
+    uint32_t post = flush + delay;
+    maxDelay = max(maxDelay, delay);
+    lastPost = max(lastPost, post);
+    TEST_ASSERT_TRUE(post == max(offset, flush));
+    perSecond[post / 1000]++;
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(WINDOW * 1000, maxDelay);
+  TEST_ASSERT_LESS_THAN(WINDOW * 1000, lastPost);
+  uint16_t s;
+  for (s=5;s<WINDOW;s++)
+  {
+    TEST_ASSERT_LESS_OR_EQUAL(2 * DEVICES / WINDOW, perSecond[s]);    // no second gets twice its share
+    TEST_ASSERT_GREATER_THAN(0, perSecond[s]);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_offset);
+  RUN_TEST(test_delay);
+  RUN_TEST(test_site_simulation);
+  return UNITY_END();
+}
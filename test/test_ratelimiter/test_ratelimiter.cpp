@@ -0,0 +1,125 @@
+// test_ratelimiter.cpp
+//
+// unit tests of rateLimiter.cpp: burst, refill and replacement of the oldest client
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "rateLimiter.h"
+
+#define CLIENT 0xC0A8B20A       // 192.168.178.10
+#define T0 100000
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_burst()
+{
+  RateLimiter limiter;
+  uint8_t i;
+  for (i=0;i<ADMISSION_BURST;i++)
+  {
+    TEST_ASSERT_TRUE(limiter.take(CLIENT, T0));
+  }
+  TEST_ASSERT_FALSE(limiter.take(CLIENT, T0));
+  TEST_ASSERT_TRUE(limiter.take(CLIENT + 1, T0));     // other client has its own bucket
+}
+
+static void test_refill()
+{
+  RateLimiter limiter;
+  uint8_t i;
+  for (i=0;i<ADMISSION_BURST;i++)
+  {
+    limiter.take(CLIENT, T0);
+  }
+  TEST_ASSERT_FALSE(limiter.take(CLIENT, T0 + 1000 / ADMISSION_RATE - 1));
+  TEST_ASSERT_TRUE(limiter.take(CLIENT, T0 + 1000 / ADMISSION_RATE));      // one token after 1/rate s
+  TEST_ASSERT_FALSE(limiter.take(CLIENT, T0 + 1000 / ADMISSION_RATE));
+
+  // long pause: full again, but not more than the burst
+  uint32_t now = T0 + 3600000;
+  for (i=0;i<ADMISSION_BURST;i++)
+  {
+    TEST_ASSERT_TRUE(limiter.take(CLIENT, now));
+  }
+  TEST_ASSERT_FALSE(limiter.take(CLIENT, now));
+}
+
+static void test_sustained_rate()
+{
+  // 100 requests at 10 per s: the burst plus the refill of 9.9 s
+  RateLimiter limiter;
+  uint16_t admitted = 0;
+  uint16_t i;
+  for (i=0;i<100;i++)
+  {
+    if(limiter.take(CLIENT, T0 + i * 100))
+    {
+      admitted++;
+    }
+  }
+  TEST_ASSERT_EQUAL(ADMISSION_BURST + (99 * 100 * ADMISSION_RATE) / 1000, admitted);
+}
+
+static void test_millis_overflow()
+{
+  RateLimiter limiter;
+  uint8_t i;
+  for (i=0;i<ADMISSION_BURST;i++)
+  {
+    limiter.take(CLIENT, 0xFFFFFF00);
+  }
+  TEST_ASSERT_FALSE(limiter.take(CLIENT, 0xFFFFFF00));
+  TEST_ASSERT_TRUE(limiter.take(CLIENT, 0xFFFFFF00 + 1000));       // wraps to 0x2E8
+}
+
+static void exhaust(RateLimiter& limiter, uint32_t ip, uint32_t now)
+{
+  while (limiter.take(ip, now))
+  {
+  }
+}
+
+static void test_oldest_client_replaced()
+{
+  // ADMISSION_CLIENTS - 1 further clients: the empty bucket of CLIENT is kept
+  RateLimiter limiter;
+  exhaust(limiter, CLIENT, T0);
+  uint8_t i;
+  for (i=1;i<ADMISSION_CLIENTS;i++)
+  {
+    TEST_ASSERT_TRUE(limiter.take(CLIENT + i, T0 + i));
+  }
+  TEST_ASSERT_FALSE(limiter.take(CLIENT, T0 + ADMISSION_CLIENTS));
+
+  // one client more: CLIENT was seen last longest ago and gets a new, full bucket
+  RateLimiter lru;
+  exhaust(lru, CLIENT, T0);
+  for (i=1;i<=ADMISSION_CLIENTS;i++)
+  {
+    TEST_ASSERT_TRUE(lru.take(CLIENT + i, T0 + i));
+  }
+  TEST_ASSERT_TRUE(lru.take(CLIENT, T0 + ADMISSION_CLIENTS + 1));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_burst);
+  RUN_TEST(test_refill);
+  RUN_TEST(test_sustained_rate);
+  RUN_TEST(test_millis_overflow);
+  RUN_TEST(test_oldest_client_replaced);
+  return UNITY_END();
+}
@@ -0,0 +1,106 @@
+// test_ssefanout.cpp
+//
+// unit tests of sseFanout.cpp: payload of a snapshot, length of an event, limit of subscribers, skip of events
+// for slow subscribers, bytes per subscriber
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include <string.h>
+#include "sseFanout.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static Snapshot example()
+{
+  Snapshot snapshot;
+  snapshot.seq = 12;
+  snapshot.timeStamp = 1666801000;
+  snapshot.power = 1234.5f;
+  snapshot.dcU = 230.1f;
+  snapshot.dcI = 5.36f;
+  snapshot.dcPower = 1233.34f;
+  snapshot.energyToday = 4.2f;
+  snapshot.temperatureInverter = 35.0f;
+  snapshot.temperatureRoom = 21.5f;
+  return snapshot;
+}
+
+static void test_payload()
+{
+  const char* expected = "{\"seq\":12,\"ts\":1666801000,\"power\":1234.50,\"dc_u\":230.10,\"dc_i\":5.36,"
+                         "\"dc_p\":1233.34,\"e_today\":4.20,\"t_inv\":35.00,\"t_room\":21.50}";
+  char payload[SSE_PAYLOAD_SIZE];
+  TEST_ASSERT_EQUAL(strlen(expected), sseFormatSnapshot(payload, sizeof(payload), example()));
+  TEST_ASSERT_EQUAL_STRING(expected, payload);
+
+  // too small: nothing rather than a truncated JSON
+  char small[40];
+  TEST_ASSERT_EQUAL(0, sseFormatSnapshot(small, sizeof(small), example()));
+  TEST_ASSERT_EQUAL_STRING("", small);
+}
+
+static void test_event_length()
+{
+  char event[SSE_PAYLOAD_SIZE + 64];
+  const char* data = "{\"seq\":12}";
+  uint32_t ids[] = {1, 12, 4294967295u};
+  uint8_t i;
+  for (i=0;i<sizeof(ids)/sizeof(ids[0]);i++)
+  {
+    int len = snprintf(event, sizeof(event), "id: %u\nevent: snapshot\ndata: %s\n\n", (unsigned int)ids[i], data);
+    TEST_ASSERT_EQUAL(len, sseEventLength(ids[i], "snapshot", strlen(data)));
+  }
+}
+
+static void test_accept()
+{
+  SseFanout fanout(2, 4);
+  TEST_ASSERT_TRUE(fanout.accept(1));
+  TEST_ASSERT_TRUE(fanout.accept(2));
+  TEST_ASSERT_FALSE(fanout.accept(3));
+  TEST_ASSERT_FALSE(fanout.accept(3));
+  TEST_ASSERT_EQUAL(2, fanout.getRejectCount());
+  TEST_ASSERT_TRUE(fanout.accept(2));                 // one of them left
+
+  SseFanout defaults;
+  TEST_ASSERT_TRUE(defaults.accept(SSE_MAX_CLIENTS));
+  TEST_ASSERT_FALSE(defaults.accept(SSE_MAX_CLIENTS + 1));
+}
+
+static void test_skip_and_bytes()
+{
+  SseFanout fanout(4, 2);
+  TEST_ASSERT_FALSE(fanout.shouldSend(0, 0));         // no subscriber: not a skip
+  TEST_ASSERT_EQUAL(0, fanout.getSkipCount());
+  TEST_ASSERT_TRUE(fanout.shouldSend(3, 2));
+  fanout.sent(3, 100);
+  TEST_ASSERT_FALSE(fanout.shouldSend(3, 3));         // slow subscribers
+  TEST_ASSERT_FALSE(fanout.shouldSend(1, 10));
+  TEST_ASSERT_EQUAL(2, fanout.getSkipCount());
+  TEST_ASSERT_TRUE(fanout.shouldSend(2, 0));
+  fanout.sent(2, 50);
+  TEST_ASSERT_EQUAL(3 * 100 + 2 * 50, fanout.getBytesSent());
+  TEST_ASSERT_EQUAL(0, fanout.getRejectCount());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_payload);
+  RUN_TEST(test_event_length);
+  RUN_TEST(test_accept);
+  RUN_TEST(test_skip_and_bytes);
+  return UNITY_END();
+}
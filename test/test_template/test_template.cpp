@@ -0,0 +1,223 @@
+// test_template.cpp
+//
+// unit tests of confWebTemplate.cpp: split into segments, render() compared with a String::replace() reference,
+// HTML escaping, unknown placeholders, stop at a nullptr value, fill() at any byte index
+//
+// 2026-10-18 mh
+// - fill() and getLength() with a value nullptr
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include <string>
+#include "confWebTemplate.h"
+
+static const char FORM_PARAM[] PROGMEM =
+  "<div class='{s}'><label for='{i}'>{b}</label><input type='{t}' id='{i}' "
+  "name='{i}' {l} placeholder='{p}' value='{v}' {c}/>"
+  "<div class='em'>{e}</div></div>\n";
+
+// output of the former implementation: one replace() per placeholder on a copy of the template
+static std::string escaped(const char* text)
+{
+  std::string result;
+  for (; *text != '\0'; text++)
+  {
+    switch (*text)
+    {
+    case '&':   result += "&amp;"; break;
+    case '<':   result += "&lt;"; break;
+    case '>':   result += "&gt;"; break;
+    case '\'':  result += "&#39;"; break;
+    case '"':   result += "&quot;"; break;
+    default:    result += *text; break;
+    }
+  }
+  return result;
+}
+
+static std::string reference(const char* text, const HtmlTemplateArg* args, size_t argCount)
+{
+  std::string result = text;
+  size_t i;
+  for (i=0;i<argCount;i++)
+  {
+    const char placeholder[4] = {'{', args[i].slot, '}', '\0'};
+    std::string value = args[i].escape ? escaped(args[i].value) : std::string(args[i].value);
+    size_t pos = 0;
+    while ((pos = result.find(placeholder, pos)) != std::string::npos)
+    {
+      result.replace(pos, 3, value);
+      pos += value.length();
+    }
+  }
+  return result;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_split()
+{
+  HtmlTemplate form(FORM_PARAM);
+  TEST_ASSERT_EQUAL(12, form.getSegmentCount());     // 11 placeholders
+
+  HtmlTemplate none("no placeholder");
+  TEST_ASSERT_EQUAL(1, none.getSegmentCount());
+  HtmlTemplate empty("");
+  TEST_ASSERT_EQUAL(1, empty.getSegmentCount());
+  HtmlTemplate only("{a}");
+  TEST_ASSERT_EQUAL(2, only.getSegmentCount());
+  HtmlTemplate adjacent("{a}{b}x{c}");
+  TEST_ASSERT_EQUAL(4, adjacent.getSegmentCount());
+  // no placeholders: upper case, digit, unterminated, at the end without }
+  HtmlTemplate other("{A} {1} {ab} {} {x");
+  TEST_ASSERT_EQUAL(1, other.getSegmentCount());
+}
+
+static void test_render_as_replace()
+{
+  static HtmlTemplate form(FORM_PARAM);
+  HtmlTemplateArg args[] = {
+    {'b', "Server <b>name</b>", false},
+    {'t', "text", false},
+    {'i', "vzServer", false},
+    {'p', "e.g. \"vz.local\"", true},
+    {'l', "maxlength=32", false},
+    {'v', "it's <me> & you", true},
+    {'c', "", false},
+    {'s', "de", false},
+    {'e', "Bad value", false}
+  };
+  size_t argCount = sizeof(args) / sizeof(args[0]);
+  String out("prefix:");
+  TEST_ASSERT_EQUAL(form.getSegmentCount(), form.render(out, args, argCount));
+  TEST_ASSERT_EQUAL_STRING(("prefix:" + reference(FORM_PARAM, args, argCount)).c_str(), out.c_str());
+  TEST_ASSERT_EQUAL(reference(FORM_PARAM, args, argCount).length(), form.getLength(args, argCount));
+}
+
+static void test_escape()
+{
+  HtmlTemplate text("[{v}]");
+  HtmlTemplateArg args[] = {{'v', "a&b<c>d'e\"f", true}};
+  String out;
+  text.render(out, args, 1);
+  TEST_ASSERT_EQUAL_STRING("[a&amp;b&lt;c&gt;d&#39;e&quot;f]", out.c_str());
+  TEST_ASSERT_EQUAL(strlen("a&amp;b&lt;c&gt;d&#39;e&quot;f"), HtmlTemplate::getEscapedLength("a&b<c>d'e\"f"));
+
+  // the same value as HTML
+  HtmlTemplateArg html[] = {{'v', "<i>x</i>", false}};
+  String raw;
+  text.render(raw, html, 1);
+  TEST_ASSERT_EQUAL_STRING("[<i>x</i>]", raw.c_str());
+}
+
+static void test_unknown_placeholder()
+{
+  HtmlTemplate text("{a}-{z}-{a}");
+  HtmlTemplateArg args[] = {{'a', "1", false}};
+  String out;
+  text.render(out, args, 1);
+  TEST_ASSERT_EQUAL_STRING("1-{z}-1", out.c_str());
+  TEST_ASSERT_EQUAL(7, text.getLength(args, 1));
+}
+
+static void test_stop_at_nullptr()
+{
+  HtmlTemplate select("<select id='{i}'>\n{o}</select>{e}");
+  HtmlTemplateArg args[] = {{'i', "mode", false}, {'o', nullptr, false}, {'e', "!", false}};
+  String out;
+  size_t next = select.render(out, args, 3);
+  TEST_ASSERT_EQUAL(2, next);
+  TEST_ASSERT_EQUAL_STRING("<select id='mode'>\n", out.c_str());
+  out += "<option/>\n";
+  TEST_ASSERT_EQUAL(select.getSegmentCount(), select.render(out, args, 3, next));
+  TEST_ASSERT_EQUAL_STRING("<select id='mode'>\n<option/>\n</select>!", out.c_str());
+}
+
+// output of fill() in chunks of maxLen, as a web server response asks for it
+static std::string fillAll(HtmlTemplate& page, const HtmlTemplateArg* args, size_t argCount, size_t maxLen)
+{
+  std::string result;
+  uint8_t buffer[64];
+  size_t n;
+  while ((n = page.fill(buffer, maxLen, args, argCount, result.length())) > 0)
+  {
+    TEST_ASSERT_TRUE(n <= maxLen);
+    result.append((const char*)buffer, n);
+  }
+  return result;
+}
+
+static void test_fill_any_index()
+{
+  static HtmlTemplate form(FORM_PARAM);
+  HtmlTemplateArg args[] = {
+    {'b', "Label", false},
+    {'t', "text", false},
+    {'i', "id", false},
+    {'p', "<&>", true},
+    {'l', "", false},
+    {'v', "'\"x\"'", true},
+    {'c', "", false},
+    {'s', "", false},
+    {'e', "", false}
+  };
+  size_t argCount = sizeof(args) / sizeof(args[0]);
+  std::string expected = reference(FORM_PARAM, args, argCount);
+  TEST_ASSERT_EQUAL(expected.length(), form.getLength(args, argCount));
+
+  // each start index, any maxLen: the bytes from there on
+  size_t index;
+  size_t maxLen;
+  uint8_t buffer[64];
+  for (index=0;index<=expected.length();index++)
+  {
+    for (maxLen=1;maxLen<=sizeof(buffer);maxLen+=7)
+    {
+      size_t n = form.fill(buffer, maxLen, args, argCount, index);
+      size_t rest = expected.length() - index;
+      TEST_ASSERT_EQUAL(std::min(maxLen, rest), n);
+      TEST_ASSERT_EQUAL_STRING(expected.substr(index, n).c_str(), std::string((const char*)buffer, n).c_str());
+    }
+  }
+  // whole output in chunks
+  for (maxLen=1;maxLen<=sizeof(buffer);maxLen++)
+  {
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), fillAll(form, args, argCount, maxLen).c_str());
+  }
+}
+
+static void test_fill_nullptr_as_empty()
+{
+  HtmlTemplate select("<select id='{i}'>\n{o}</select>{e}");
+  HtmlTemplateArg args[] = {{'i', "mode", false}, {'o', nullptr, false}, {'e', "&", true}};
+  const char* expected = "<select id='mode'>\n</select>&amp;";
+  TEST_ASSERT_EQUAL(strlen(expected), select.getLength(args, 3));
+  size_t maxLen;
+  for (maxLen=1;maxLen<=8;maxLen++)
+  {
+    TEST_ASSERT_EQUAL_STRING(expected, fillAll(select, args, 3, maxLen).c_str());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_split);
+  RUN_TEST(test_render_as_replace);
+  RUN_TEST(test_escape);
+  RUN_TEST(test_unknown_placeholder);
+  RUN_TEST(test_stop_at_nullptr);
+  RUN_TEST(test_fill_any_index);
+  RUN_TEST(test_fill_nullptr_as_empty);
+  return UNITY_END();
+}
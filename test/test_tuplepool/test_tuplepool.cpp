@@ -0,0 +1,125 @@
+// test_tuplepool.cpp
+//
+// unit tests of tuplePool.cpp: typical batches and a randomized simulation of requests against a model of the pool
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "tuplePool.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_batches()
+{
+  TuplePool pool;
+  uint16_t first;
+  TEST_ASSERT_FALSE(pool.alloc(VZ_TUPLE_POOL_SIZE + 1, first));
+  TEST_ASSERT_TRUE(pool.alloc(VZ_BATCH_SIZE, first));             // one batch of max size ...
+  TEST_ASSERT_EQUAL(0, first);
+  TEST_ASSERT_TRUE(pool.alloc(8, first));                         // ... and small ones
+  TEST_ASSERT_EQUAL(VZ_BATCH_SIZE, first);
+  TEST_ASSERT_TRUE(pool.alloc(8, first));
+  TEST_ASSERT_EQUAL(VZ_BATCH_SIZE + 8, first);
+  TEST_ASSERT_FALSE(pool.alloc(1, first));                        // full: the batch goes to the queue
+  pool.release();
+  TEST_ASSERT_TRUE(pool.alloc(20, first));                        // wraps to the beginning
+  TEST_ASSERT_EQUAL(0, first);
+  TEST_ASSERT_FALSE(pool.alloc(13, first));                       // only 12 left before the oldest
+  TEST_ASSERT_TRUE(pool.alloc(12, first));
+  TEST_ASSERT_EQUAL(20, first);
+  TEST_ASSERT_EQUAL(4, pool.getCount());
+  TEST_ASSERT_FALSE(pool.alloc(1, first));                        // VZ_REQUEST_QUEUE_SIZE requests
+}
+
+static void test_random_requests()
+{
+  // requests of 1..VZ_BATCH_SIZE tuples, completed in order: spans never overlap and stay within the pool,
+  // an allocation fails only if there is no contiguous free space in ring order
+  uint16_t first[VZ_REQUEST_QUEUE_SIZE];
+  uint16_t size[VZ_REQUEST_QUEUE_SIZE];
+  uint8_t oldest = 0;
+  uint8_t count = 0;
+  uint32_t allocated = 0;
+  uint32_t refused = 0;
+  uint32_t random = 4711;
+  TuplePool pool;
+  uint32_t step;
+  for (step=0;step<100000;step++)
+  {
+    random = random * 1103515245 + 12345;
+    if(((random >> 16) % 3 == 0) && (count > 0))
+    {
+      pool.release();
+      oldest = (oldest + 1) % VZ_REQUEST_QUEUE_SIZE;
+      count--;
+      continue;
+    }
+    uint16_t n = 1 + (random >> 8) % VZ_BATCH_SIZE;
+    uint16_t f;
+    // model: start after the newest span, at 0 if it does not fit at the end
+    bool fits = false;
+    uint16_t expected = 0;
+    if(count == 0)
+    {
+      fits = true;
+    }
+    else if(count < VZ_REQUEST_QUEUE_SIZE)
+    {
+      uint8_t newest = (oldest + count - 1) % VZ_REQUEST_QUEUE_SIZE;
+      uint16_t tail = first[newest] + size[newest];
+      uint16_t head = first[oldest];
+      if(first[newest] >= head)
+      {
+        expected = ((tail + n) <= VZ_TUPLE_POOL_SIZE) ? tail : 0;
+        fits = (expected == tail) || (n <= head);
+      }
+      else
+      {
+        expected = tail;
+        fits = (tail + n) <= head;
+      }
+    }
+    bool ok = pool.alloc(n, f);
+    TEST_ASSERT_EQUAL(fits, ok);
+    if(!ok)
+    {
+      refused++;
+      continue;
+    }
+    TEST_ASSERT_EQUAL(expected, f);
+    TEST_ASSERT_LESS_OR_EQUAL(VZ_TUPLE_POOL_SIZE, f + n);
+    uint8_t i;
+    for (i=0;i<count;i++)
+    {
+      uint8_t r = (oldest + i) % VZ_REQUEST_QUEUE_SIZE;
+      TEST_ASSERT_TRUE(((f + n) <= first[r]) || (f >= (first[r] + size[r])));
+    }
+    uint8_t slot = (oldest + count) % VZ_REQUEST_QUEUE_SIZE;
+    first[slot] = f;
+    size[slot] = n;
+    count++;
+    allocated++;
+    TEST_ASSERT_EQUAL(count, pool.getCount());
+  }
+  TEST_ASSERT_GREATER_THAN(10000, allocated);
+  TEST_ASSERT_GREATER_THAN(1000, refused);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_batches);
+  RUN_TEST(test_random_requests);
+  return UNITY_END();
+}
@@ -0,0 +1,102 @@
+// test_uuid.cpp
+//
+// unit tests of vzUuid.cpp: channel UUIDs in binary form
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "vzUuid.h"
+
+static const uint8_t UUID_BIN[VZ_UUID_SIZE] = {0xae, 0x53, 0xc5, 0x80, 0x12, 0x34, 0x56, 0x78,
+                                               0x90, 0xab, 0xcd, 0xef, 0x01, 0x23, 0x45, 0x67};
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_parse()
+{
+  uint8_t uuid[VZ_UUID_SIZE];
+  TEST_ASSERT_TRUE(uuidParse("ae53c580-1234-5678-90ab-cdef01234567", uuid));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(UUID_BIN, uuid, VZ_UUID_SIZE);
+  TEST_ASSERT_TRUE(uuidParse("AE53C580-1234-5678-90AB-CDEF01234567", uuid));     // upper case
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(UUID_BIN, uuid, VZ_UUID_SIZE);
+  TEST_ASSERT_TRUE(uuidIsSet(uuid));
+}
+
+static void test_round_trip()
+{
+  uint8_t uuid[VZ_UUID_SIZE];
+  uint8_t back[VZ_UUID_SIZE];
+  char text[VZ_UUID_TEXT_LEN + 1];
+  uint16_t i;
+  for (i=0;i<256;i++)
+  {
+    uint8_t j;
+    for (j=0;j<VZ_UUID_SIZE;j++)
+    {
+      uuid[j] = (uint8_t)(i * 31 + j * 17 + 1);
+    }
+    TEST_ASSERT_EQUAL(VZ_UUID_TEXT_LEN, uuidFormat(uuid, text));
+    TEST_ASSERT_EQUAL(VZ_UUID_TEXT_LEN, strlen(text));
+    TEST_ASSERT_TRUE(uuidParse(text, back));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(uuid, back, VZ_UUID_SIZE);
+  }
+  uuidFormat(UUID_BIN, text);
+  TEST_ASSERT_EQUAL_STRING("ae53c580-1234-5678-90ab-cdef01234567", text);
+}
+
+static void test_no_send()
+{
+  uint8_t uuid[VZ_UUID_SIZE];
+  char text[VZ_UUID_TEXT_LEN + 1];
+  memcpy(uuid, UUID_BIN, VZ_UUID_SIZE);
+  TEST_ASSERT_TRUE(uuidParse(VZ_UUID_NO_SEND, uuid));
+  TEST_ASSERT_FALSE(uuidIsSet(uuid));
+  uuidFormat(uuid, text);
+  TEST_ASSERT_EQUAL_STRING(VZ_UUID_NO_SEND, text);
+
+  memcpy(uuid, UUID_BIN, VZ_UUID_SIZE);
+  TEST_ASSERT_TRUE(uuidParse("", uuid));      // empty text: not sent
+  TEST_ASSERT_FALSE(uuidIsSet(uuid));
+}
+
+static void test_malformed()
+{
+  static const char* const malformed[] = {
+    "ae53c580-1234-5678-90ab-cdef0123456",      // too short
+    "ae53c580-1234-5678-90ab-cdef012345678",    // too long
+    "ae53c580x1234-5678-90ab-cdef01234567",     // wrong separator
+    "ae53c5801-234-5678-90ab-cdef01234567",     // dash at wrong position
+    "ae53c580-1234-5678-90ab-cdef0123456g",     // no hex digit
+    "ae53c580-1234-5678-90ab- cdef0123456",     // blank
+    "ae53c580123456789"                         // no dashes
+  };
+  uint8_t uuid[VZ_UUID_SIZE];
+  size_t i;
+  for (i=0;i<sizeof(malformed)/sizeof(malformed[0]);i++)
+  {
+    memcpy(uuid, UUID_BIN, VZ_UUID_SIZE);
+    TEST_ASSERT_FALSE_MESSAGE(uuidParse(malformed[i], uuid), malformed[i]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(UUID_BIN, uuid, VZ_UUID_SIZE);      // unchanged
+  }
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_parse);
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_no_send);
+  RUN_TEST(test_malformed);
+  return UNITY_END();
+}
@@ -0,0 +1,183 @@
+// test_vzchannel.cpp
+//
+// unit tests of vzChannel.cpp: send mask of the registry, values collected from a snapshot or another source,
+// interval and deadband, several channels of one source, sources of a batch
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include "vzChannel.h"
+
+static const uint8_t UUID_A[VZ_UUID_SIZE] = {0xae, 0x53, 0xc5, 0x80, 0x12, 0x34, 0x56, 0x78,
+                                             0x90, 0xab, 0xcd, 0xef, 0x01, 0x23, 0x45, 0x67};
+
+// config entry of a channel; uuid all 0: not sent
+static VzChannelConfig channelConfig(uint8_t source, bool uuid, const char* interval = "0", const char* deadband = "0")
+{
+  VzChannelConfig config;
+  snprintf(config.source, sizeof(config.source), "%u", (unsigned int)(source % 100));    // two digits as on the config page
+  if(uuid)
+  {
+    memcpy(config.uuid, UUID_A, VZ_UUID_SIZE);
+  }
+  else
+  {
+    memset(config.uuid, 0, VZ_UUID_SIZE);
+  }
+  snprintf(config.interval, sizeof(config.interval), "%s", interval);
+  snprintf(config.deadband, sizeof(config.deadband), "%s", deadband);
+  return config;
+}
+
+static Snapshot snapshotAt(uint32_t timeStamp, float power)
+{
+  Snapshot snapshot;
+  snapshot.timeStamp = timeStamp;
+  snapshot.power = power;
+  snapshot.dcU = 230.5f;
+  snapshot.energyToday = 4.2f;
+  return snapshot;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+static void test_send_mask()
+{
+  static VzChannelConfig configs[VZ_MAX_CHANNELS];
+  VzChannelRegistry registry;
+  TEST_ASSERT_EQUAL(0, registry.getSendMask());
+  TEST_ASSERT_FALSE(uuidIsSet(registry.getUuid(0)));
+
+  configs[0] = channelConfig(vzSRC_POWER, true);
+  configs[1] = channelConfig(vzSRC_POWER, false);     // no UUID
+  configs[2] = channelConfig(vzSRC_OFF, true);        // off
+  configs[3] = channelConfig(99, true);               // unknown source is off
+  configs[VZ_MAX_CHANNELS - 1] = channelConfig(vzSRC_DC_U, true);
+  uint8_t i;
+  for (i=0;i<VZ_MAX_CHANNELS;i++)
+  {
+    registry.set(i, configs[i]);
+  }
+  TEST_ASSERT_EQUAL_HEX16((1 << 0) | (1 << (VZ_MAX_CHANNELS - 1)), registry.getSendMask());
+  TEST_ASSERT_TRUE(registry.isSent(0));
+  TEST_ASSERT_FALSE(registry.isSent(1));
+  TEST_ASSERT_FALSE(registry.isSent(VZ_MAX_CHANNELS));
+  TEST_ASSERT_EQUAL(vzSRC_OFF, registry.getChannel(3).source);
+  TEST_ASSERT_TRUE(registry.getUuid(0) == configs[0].uuid);      // not copied
+
+  // switched off again
+  configs[0] = channelConfig(vzSRC_OFF, true);
+  registry.set(0, configs[0]);
+  TEST_ASSERT_EQUAL_HEX16(1 << (VZ_MAX_CHANNELS - 1), registry.getSendMask());
+  registry.set(VZ_MAX_CHANNELS, configs[0]);                     // out of range, ignored
+  TEST_ASSERT_EQUAL_HEX16(1 << (VZ_MAX_CHANNELS - 1), registry.getSendMask());
+}
+
+static void test_collect_snapshot()
+{
+  static VzChannelConfig configs[5];
+  configs[0] = channelConfig(vzSRC_TEMP_ROOM, true);      // not in the snapshot
+  configs[1] = channelConfig(vzSRC_POWER, true);
+  configs[2] = channelConfig(vzSRC_DC_U, false);          // not sent
+  configs[3] = channelConfig(vzSRC_ENERGY_TODAY, true);
+  configs[4] = channelConfig(vzSRC_POWER, true, "300");   // second channel of the same source
+  VzChannelRegistry registry;
+  uint8_t i;
+  for (i=0;i<5;i++)
+  {
+    registry.set(i, configs[i]);
+  }
+
+  VzTuple tuples[VZ_MAX_CHANNELS];
+  uint8_t n = registry.collect(snapshotAt(1000, 1500.0f), tuples);
+  TEST_ASSERT_EQUAL(3, n);
+  TEST_ASSERT_EQUAL(1, tuples[0].channel);
+  TEST_ASSERT_EQUAL(1000, tuples[0].timeStamp);
+  TEST_ASSERT_EQUAL_FLOAT(1500.0f, tuples[0].value);
+  TEST_ASSERT_EQUAL(3, tuples[1].channel);
+  TEST_ASSERT_EQUAL_FLOAT(4.2f, tuples[1].value);
+  TEST_ASSERT_EQUAL(4, tuples[2].channel);
+  TEST_ASSERT_EQUAL_FLOAT(1500.0f, tuples[2].value);
+
+  // next poll within the interval of channel 4
+  n = registry.collect(snapshotAt(1060, 1600.0f), tuples);
+  TEST_ASSERT_EQUAL(2, n);
+  TEST_ASSERT_EQUAL(1, tuples[0].channel);
+  TEST_ASSERT_EQUAL(3, tuples[1].channel);
+  // new interval
+  n = registry.collect(snapshotAt(1200, 1700.0f), tuples);
+  TEST_ASSERT_EQUAL(3, n);
+  TEST_ASSERT_EQUAL(4, tuples[2].channel);
+  TEST_ASSERT_EQUAL_FLOAT(1700.0f, tuples[2].value);
+}
+
+static void test_collect_source()
+{
+  static VzChannelConfig configs[4];
+  configs[0] = channelConfig(vzSRC_TEMP_ROOM, true);
+  configs[1] = channelConfig(vzSRC_POWER, true);
+  configs[2] = channelConfig(vzSRC_TEMP_ROOM, true, "0", "0.5");
+  configs[3] = channelConfig(vzSRC_HEART_BEAT, true);
+  VzChannelRegistry registry;
+  uint8_t i;
+  for (i=0;i<4;i++)
+  {
+    registry.set(i, configs[i]);
+  }
+
+  VzTuple tuples[VZ_MAX_CHANNELS];
+  TEST_ASSERT_EQUAL(2, registry.collect(vzSRC_TEMP_ROOM, 1000, 21.0f, tuples));
+  TEST_ASSERT_EQUAL(0, tuples[0].channel);
+  TEST_ASSERT_EQUAL(2, tuples[1].channel);
+  // within deadband of channel 2
+  TEST_ASSERT_EQUAL(1, registry.collect(vzSRC_TEMP_ROOM, 1060, 21.3f, tuples));
+  TEST_ASSERT_EQUAL(0, tuples[0].channel);
+  // deadband exceeded
+  TEST_ASSERT_EQUAL(2, registry.collect(vzSRC_TEMP_ROOM, 1120, 20.4f, tuples));
+  // unchanged, but refreshed after VZ_CHANNEL_REFRESH
+  TEST_ASSERT_EQUAL(1, registry.collect(vzSRC_TEMP_ROOM, 1120 + VZ_CHANNEL_REFRESH - 1, 20.4f, tuples));
+  TEST_ASSERT_EQUAL(2, registry.collect(vzSRC_TEMP_ROOM, 1120 + VZ_CHANNEL_REFRESH, 20.4f, tuples));
+  // source without channel
+  TEST_ASSERT_EQUAL(0, registry.collect(vzSRC_TEST, 1000, 1.0f, tuples));
+  // a snapshot does not feed other sources
+  TEST_ASSERT_EQUAL(1, registry.collect(snapshotAt(3000, 100.0f), tuples));
+  TEST_ASSERT_EQUAL(1, tuples[0].channel);
+}
+
+static void test_source_mask()
+{
+  static VzChannelConfig configs[3];
+  configs[0] = channelConfig(vzSRC_TEMP_ROOM, true);
+  configs[1] = channelConfig(vzSRC_POWER, true);
+  configs[2] = channelConfig(vzSRC_ENERGY_LASTDAY, true);
+  VzChannelRegistry registry;
+  uint8_t i;
+  for (i=0;i<3;i++)
+  {
+    registry.set(i, configs[i]);
+  }
+  VzTuple tuples[4] = {{1, 1000, 1.0f}, {2, 1000, 2.0f}, {1, 1060, 3.0f}, {VZ_MAX_CHANNELS, 0, 0}};
+  TEST_ASSERT_EQUAL_HEX16((1 << vzSRC_POWER) | (1 << vzSRC_ENERGY_LASTDAY), registry.getSourceMask(tuples, 4));
+  TEST_ASSERT_EQUAL_HEX16(0, registry.getSourceMask(tuples, 0));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_send_mask);
+  RUN_TEST(test_collect_snapshot);
+  RUN_TEST(test_collect_source);
+  RUN_TEST(test_source_mask);
+  return UNITY_END();
+}
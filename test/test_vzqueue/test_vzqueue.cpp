@@ -0,0 +1,226 @@
+// test_vzqueue.cpp
+//
+// unit tests of vzQueue.cpp on the RAM file system of test/native/include/LittleFS.h:
+// push/read/commit, segments, full queue, recovery after restart, commit after a drop
+//
+// 2026-10-18 mh
+// - first version
+//
+// (C) Copyright M. Herbert, 2022-2026.
+// Licensed under the GNU General Public License v3.0
+//
+
+#include <unity.h>
+#include <LittleFS.h>
+#include "vzQueue.h"
+
+#define SEG   VZ_QUEUE_SEGMENT_RECORDS
+#define FULL  (VZ_QUEUE_SEGMENT_RECORDS * VZ_QUEUE_MAX_SEGMENTS)
+
+static VzTuple tuples[SEG];
+
+static VzTuple record(uint32_t i)
+{
+  VzTuple tuple;
+  memset(&tuple, 0, sizeof(tuple));
+  tuple.channel = i % VZ_MAX_CHANNELS;
+  tuple.timeStamp = 1700000000 + i;
+  tuple.value = i * 0.5f;
+  return tuple;
+}
+
+static void pushRecords(VzQueue& queue, uint32_t from, uint32_t n)
+// push records from .. from + n - 1 in calls of up to 100
+{
+  while (n > 0)
+  {
+    uint16_t chunk = min(n, (uint32_t)100);
+    uint16_t i;
+    for (i=0;i<chunk;i++)
+    {
+      tuples[i] = record(from + i);
+    }
+    TEST_ASSERT_EQUAL(chunk, queue.push(tuples, chunk));
+    from += chunk;
+    n -= chunk;
+  }
+}
+
+static void assertRecords(uint32_t from, uint16_t n)
+{
+  uint16_t i;
+  for (i=0;i<n;i++)
+  {
+    VzTuple expected = record(from + i);
+    TEST_ASSERT_EQUAL_UINT32(expected.timeStamp, tuples[i].timeStamp);
+    TEST_ASSERT_EQUAL(expected.channel, tuples[i].channel);
+    TEST_ASSERT_EQUAL_FLOAT(expected.value, tuples[i].value);
+  }
+}
+
+void setUp()
+{
+  LittleFS.format();
+}
+
+void tearDown()
+{
+}
+
+static void test_push_read_commit()
+{
+  VzQueue queue;
+  uint32_t seg;
+  uint16_t pos;
+  TEST_ASSERT_TRUE(queue.begin());
+  TEST_ASSERT_EQUAL(0, queue.read(tuples, 10, seg, pos));
+  pushRecords(queue, 0, 10);
+  TEST_ASSERT_EQUAL_UINT32(10, queue.count());
+
+  TEST_ASSERT_EQUAL(4, queue.read(tuples, 4, seg, pos));
+  assertRecords(0, 4);
+  TEST_ASSERT_EQUAL_UINT32(10, queue.count());      // stays until commit
+  TEST_ASSERT_EQUAL(4, queue.read(tuples, 4, seg, pos));
+  assertRecords(0, 4);
+  queue.commit(seg, pos, 4);
+  TEST_ASSERT_EQUAL_UINT32(6, queue.count());
+
+  TEST_ASSERT_EQUAL(6, queue.read(tuples, 32, seg, pos));
+  assertRecords(4, 6);
+  queue.commit(seg, pos, 6);
+  TEST_ASSERT_EQUAL_UINT32(0, queue.count());
+  TEST_ASSERT_EQUAL(0, queue.read(tuples, 32, seg, pos));
+
+  pushRecords(queue, 10, 3);                        // empty queue starts a new segment
+  TEST_ASSERT_EQUAL(3, queue.read(tuples, 32, seg, pos));
+  assertRecords(10, 3);
+}
+
+static void test_segments()
+{
+  VzQueue queue;
+  uint32_t seg;
+  uint16_t pos;
+  queue.begin();
+  pushRecords(queue, 0, SEG + 50);
+  TEST_ASSERT_EQUAL(2, LittleFS.files.size());
+  TEST_ASSERT_EQUAL(SEG, queue.read(tuples, SEG, seg, pos));     // only from the oldest segment
+  queue.commit(seg, pos, SEG - 6);
+  TEST_ASSERT_EQUAL(6, queue.read(tuples, SEG, seg, pos));
+  assertRecords(SEG - 6, 6);
+  queue.commit(seg, pos, 6);
+  TEST_ASSERT_FALSE(LittleFS.exists(VZ_QUEUE_DIR "/0"));        // sent segment is deleted
+  TEST_ASSERT_EQUAL(50, queue.read(tuples, SEG, seg, pos));
+  assertRecords(SEG, 50);
+}
+
+static void test_full_queue()
+{
+  VzQueue queue;
+  uint32_t seg;
+  uint16_t pos;
+  queue.begin();
+  pushRecords(queue, 0, FULL);
+  TEST_ASSERT_EQUAL_UINT32(FULL, queue.count());
+  TEST_ASSERT_EQUAL_UINT32(0, queue.getDropCount());
+
+  queue.read(tuples, 50, seg, pos);
+  queue.commit(seg, pos, 50);
+  pushRecords(queue, FULL, 1);                      // oldest segment dropped, 50 of it were sent already
+  TEST_ASSERT_EQUAL_UINT32(SEG - 50, queue.getDropCount());
+  TEST_ASSERT_EQUAL_UINT32(FULL - SEG + 1, queue.count());
+  TEST_ASSERT_EQUAL(10, queue.read(tuples, 10, seg, pos));
+  assertRecords(SEG, 10);
+}
+
+static void test_commit_after_drop()
+{
+  // the oldest segment is dropped while its tuples are in transfer: the commit must not skip the next segment
+  VzQueue queue;
+  uint32_t seg;
+  uint16_t pos;
+  queue.begin();
+  pushRecords(queue, 0, FULL);
+  TEST_ASSERT_EQUAL(32, queue.read(tuples, 32, seg, pos));
+  pushRecords(queue, FULL, 1);
+  TEST_ASSERT_EQUAL_UINT32(SEG, queue.getDropCount());
+  uint32_t pending = queue.count();
+  queue.commit(seg, pos, 32);
+  TEST_ASSERT_EQUAL_UINT32(pending, queue.count());
+  TEST_ASSERT_EQUAL(32, queue.read(tuples, 32, seg, pos));
+  assertRecords(SEG, 32);
+}
+
+static void test_recovery()
+{
+  uint32_t seg;
+  uint16_t pos;
+  {
+    VzQueue queue;
+    queue.begin();
+    pushRecords(queue, 0, SEG + 40);
+    queue.read(tuples, 100, seg, pos);
+    queue.commit(seg, pos, 100);
+  }
+  {
+    VzQueue queue;                                  // restart: state from the files
+    queue.begin();
+    TEST_ASSERT_EQUAL_UINT32(SEG + 40 - 100, queue.count());
+    TEST_ASSERT_EQUAL(10, queue.read(tuples, 10, seg, pos));
+    assertRecords(100, 10);
+    pushRecords(queue, SEG + 40, 5);                // appended to the last segment
+    TEST_ASSERT_EQUAL_UINT32(SEG + 45 - 100, queue.count());
+  }
+
+  // power loss within a write: incomplete record at the end of the last segment
+  LittleFS.files[VZ_QUEUE_DIR "/1"].resize(45 * sizeof(VzTuple) + 5);
+  {
+    VzQueue queue;
+    queue.begin();
+    pushRecords(queue, 1000, 2);                    // continues with a new segment
+    TEST_ASSERT_TRUE(LittleFS.exists(VZ_QUEUE_DIR "/2"));
+    TEST_ASSERT_EQUAL_UINT32(SEG - 100 + SEG + 2, queue.count());
+    queue.read(tuples, SEG, seg, pos);
+    assertRecords(100, SEG - 100);
+  }
+}
+
+static void test_missing_segment()
+{
+  VzQueue queue;
+  uint32_t seg;
+  uint16_t pos;
+  queue.begin();
+  pushRecords(queue, 0, SEG + 20);
+  LittleFS.remove(VZ_QUEUE_DIR "/0");
+  TEST_ASSERT_EQUAL(20, queue.read(tuples, 32, seg, pos));       // continues with the next segment
+  assertRecords(SEG, 20);
+  TEST_ASSERT_EQUAL_UINT32(0, queue.getDropCount());             // never stored, not counted as dropped
+}
+
+static void test_file_system_full()
+{
+  VzQueue queue;
+  queue.begin();
+  LittleFS.format(10 * sizeof(VzTuple));            // space for 10 records
+  uint16_t i;
+  for (i=0;i<20;i++)
+  {
+    tuples[i] = record(i);
+  }
+  TEST_ASSERT_EQUAL(10, queue.push(tuples, 20));
+  TEST_ASSERT_EQUAL_UINT32(10, queue.count());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_push_read_commit);
+  RUN_TEST(test_segments);
+  RUN_TEST(test_full_queue);
+  RUN_TEST(test_commit_after_drop);
+  RUN_TEST(test_recovery);
+  RUN_TEST(test_missing_segment);
+  RUN_TEST(test_file_system_full);
+  return UNITY_END();
+}